@@ -0,0 +1,110 @@
+#include "./common.h"
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+
+// Object churn benchmark. This file is built twice, as `mlc_bench_alloc` with the default heap
+// path and as `mlc_bench_alloc_pool` with `MLC_USE_POOL_ALLOCATOR=1`, so that the two can be compared.
+
+namespace {
+using namespace mlc;
+using mlc::bench::DoNotOptimize;
+using mlc::bench::Run;
+
+constexpr int64_t kNumItems = 1 << 20;
+
+void BenchStr() {
+  Run("Str: create and drop", kNumItems, []() {
+    for (int64_t i = 0; i < kNumItems; ++i) {
+      Str s("var_name_" + std::to_string(i & 1023));
+      DoNotOptimize(s.get());
+    }
+  });
+  Run("Str: build a batch of 1024, then drop", kNumItems, []() {
+    std::vector<Str> batch;
+    batch.reserve(1024);
+    for (int64_t i = 0; i < kNumItems; ++i) {
+      batch.emplace_back("x");
+      if (batch.size() == 1024) {
+        batch.clear();
+      }
+    }
+  });
+}
+
+void BenchList() {
+  Run("UList: create with 4 boxed ints, then drop", kNumItems / 4, []() {
+    for (int64_t i = 0; i < kNumItems / 4; ++i) {
+      UList list{i, i + 1, i + 2, i + 3};
+      DoNotOptimize(list.get());
+    }
+  });
+  Run("UList: build a nested chain, then drop", kNumItems, []() {
+    UList list;
+    for (int64_t i = 0; i < kNumItems; ++i) {
+      list = UList{list};
+    }
+    DoNotOptimize(list.get());
+  });
+  Run("Ref<Any>: box int64_t", kNumItems, []() {
+    for (int64_t i = 0; i < kNumItems; ++i) {
+      Ref<int64_t> boxed(i);
+      DoNotOptimize(boxed.get());
+    }
+  });
+}
+
+void BenchDict() {
+  Run("UDict: create with 2 entries, then drop", kNumItems / 4, []() {
+    for (int64_t i = 0; i < kNumItems / 4; ++i) {
+      UDict dict{{"a", i}, {"b", i + 1}};
+      DoNotOptimize(dict.get());
+    }
+  });
+}
+
+void BenchSymExpr() {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64));
+  Run("sym::Expr: build and drop (x + i) * (x - i)", kNumItems / 4, [&x]() {
+    for (int64_t i = 0; i < kNumItems / 4; ++i) {
+      IntImm c(i, DType::Int(64));
+      Expr e = Mul(Add(x, c), Sub(x, c));
+      DoNotOptimize(e.get());
+    }
+  });
+  Run("sym::Expr: build a chain of 1024, then drop", kNumItems, [&x]() {
+    for (int64_t i = 0; i < kNumItems / 1024; ++i) {
+      Expr e = x;
+      for (int64_t j = 0; j < 1024; ++j) {
+        e = Add(e, x);
+      }
+      DoNotOptimize(e.get());
+    }
+  });
+  Run("sym::Expr: same, in an ArenaScope", kNumItems, [&x]() {
+    for (int64_t i = 0; i < kNumItems / 1024; ++i) {
+      ArenaScope arena;
+      Expr e = x;
+      for (int64_t j = 0; j < 1024; ++j) {
+        e = Add(e, x);
+      }
+      DoNotOptimize(e.get());
+    }
+  });
+}
+
+} // namespace
+
+int main() {
+  std::printf("MLC_USE_POOL_ALLOCATOR = %d\n", MLC_USE_POOL_ALLOCATOR);
+  BenchStr();
+  BenchList();
+  BenchDict();
+  BenchSymExpr();
+  UDict stats = (*Func::GetGlobal("mlc.core.PoolAllocatorStats"))().operator UDict();
+  std::printf("Pool: num_allocs = %lld, num_live = %lld, reserved_bytes = %lld\n",
+              static_cast<long long>(stats->at("num_allocs").operator int64_t()),
+              static_cast<long long>(stats->at("num_live").operator int64_t()),
+              static_cast<long long>(stats->at("reserved_bytes").operator int64_t()));
+  return 0;
+}
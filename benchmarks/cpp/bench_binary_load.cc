@@ -0,0 +1,56 @@
+#include "./common.h"
+#include <cstdio>
+#include <mlc/core/all.h>
+
+// Loading a binary file with a few large tensors. `BinaryDeserialize` copies every payload out of an in-memory buffer,
+// while `BinaryLoad` maps the file and backs tensors by its pages, either read in up front or on first access. Times
+// are per tensor, and the lazy load is expected to stay flat as tensors grow.
+
+namespace {
+using namespace mlc;
+using mlc::bench::DoNotOptimize;
+using mlc::bench::Run;
+
+constexpr int64_t kNumTensors = 8;
+
+UList MakeCheckpoint(int64_t numel) {
+  UList ret;
+  for (int64_t i = 0; i < kNumTensors; ++i) {
+    TypedList<double> data;
+    for (int64_t j = 0; j < numel; ++j) {
+      data.push_back(static_cast<double>(i + j));
+    }
+    ret.push_back(UList{Str("param_" + std::to_string(i)), Tensor(data->DLPack())});
+  }
+  return ret;
+}
+
+} // namespace
+
+int main() {
+  FuncObj *serialize = Func::GetGlobal("mlc.core.BinarySerialize");
+  FuncObj *serialize_to = Func::GetGlobal("mlc.core.BinarySerializeTo");
+  FuncObj *deserialize = Func::GetGlobal("mlc.core.BinaryDeserialize");
+  FuncObj *load = Func::GetGlobal("mlc.core.BinaryLoad");
+  std::string path = "mlc_bench_binary_load.bin";
+  for (int64_t numel : {1 << 10, 1 << 16, 1 << 22}) {
+    UList checkpoint = MakeCheckpoint(numel);
+    Str binary = (*serialize)(checkpoint, nullptr);
+    (*serialize_to)(checkpoint, path, nullptr);
+    std::string suffix = ", " + std::to_string(numel * 8 / 1024) + " KiB per tensor";
+    Run("BinaryDeserialize (copy)" + suffix, kNumTensors, [&]() {
+      Any ret = (*deserialize)(binary, -1, nullptr);
+      DoNotOptimize(ret.v.v_obj);
+    });
+    Run("BinaryLoad (mmap, eager)" + suffix, kNumTensors, [&]() {
+      Any ret = (*load)(path, false, nullptr);
+      DoNotOptimize(ret.v.v_obj);
+    });
+    Run("BinaryLoad (mmap, lazy)" + suffix, kNumTensors, [&]() {
+      Any ret = (*load)(path, true, nullptr);
+      DoNotOptimize(ret.v.v_obj);
+    });
+  }
+  std::remove(path.c_str());
+  return 0;
+}
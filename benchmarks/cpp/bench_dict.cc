@@ -0,0 +1,152 @@
+#include "./common.h"
+#include <mlc/core/all.h>
+#include <unordered_map>
+
+// `UDict` insert / lookup / iterate throughput from 1K to 10M entries, with `std::unordered_map` as a reference.
+
+namespace {
+using namespace mlc;
+using mlc::bench::DoNotOptimize;
+using mlc::bench::Run;
+
+// Random-looking distinct integer keys: the splitmix64 finalizer is a bijection
+int64_t KeyAt(int64_t i) {
+  uint64_t x = static_cast<uint64_t>(i);
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<int64_t>(x ^ (x >> 31));
+}
+
+void BenchSize(int64_t n) {
+  int32_t num_repeats = n >= 1000000 ? 1 : 5;
+  std::string suffix = " (" + std::to_string(n) + ")";
+  int64_t num_lookups = std::max<int64_t>(n, 1 << 20);
+  Run("UDict: insert int keys" + suffix, n, [&]() {
+    UDict dict;
+    for (int64_t i = 0; i < n; ++i) {
+      dict[KeyAt(i)] = i;
+    }
+    DoNotOptimize(dict.get());
+  }, num_repeats);
+  UDict dict;
+  std::unordered_map<int64_t, int64_t> std_map;
+  for (int64_t i = 0; i < n; ++i) {
+    dict[KeyAt(i)] = i;
+    std_map[KeyAt(i)] = i;
+  }
+  Run("UDict: lookup hit" + suffix, num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->at(KeyAt(i % n)).v.v_int64;
+    }
+    DoNotOptimize(sum);
+  }, num_repeats);
+  Run("UDict: lookup miss" + suffix, num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->count(KeyAt(n + i));
+    }
+    DoNotOptimize(sum);
+  }, num_repeats);
+  Run("UDict: iterate" + suffix, n, [&]() {
+    int64_t sum = 0;
+    for (const auto &kv : *dict.get()) {
+      sum += kv.second.operator int64_t();
+    }
+    DoNotOptimize(sum);
+  }, num_repeats);
+  Run("std::unordered_map: lookup hit" + suffix, num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += std_map.at(KeyAt(i % n));
+    }
+    DoNotOptimize(sum);
+  }, num_repeats);
+  Run("UDict: freeze" + suffix, n, [&]() {
+    UDict copy(dict->begin(), dict->end());
+    copy->freeze();
+    DoNotOptimize(copy.get());
+  }, 1);
+  dict->freeze();
+  Run("UDict (frozen): lookup hit" + suffix, num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->at(KeyAt(i % n)).v.v_int64;
+    }
+    DoNotOptimize(sum);
+  }, num_repeats);
+  Run("UDict (frozen): lookup miss" + suffix, num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->count(KeyAt(n + i));
+    }
+    DoNotOptimize(sum);
+  }, num_repeats);
+}
+
+void BenchStrKeys(int64_t n) {
+  std::vector<Str> keys;
+  UDict dict;
+  for (int64_t i = 0; i < n; ++i) {
+    keys.push_back(Str("attr_" + std::to_string(KeyAt(i))));
+    dict[keys.back()] = i;
+  }
+  int64_t num_lookups = 1 << 20;
+  Run("UDict: lookup hit, Str keys (" + std::to_string(n) + ")", num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->at(keys[i % n]).v.v_int64;
+    }
+    DoNotOptimize(sum);
+  });
+  dict->freeze();
+  Run("UDict (frozen): lookup hit, Str keys (" + std::to_string(n) + ")", num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->at(keys[i % n]).v.v_int64;
+    }
+    DoNotOptimize(sum);
+  });
+}
+
+void BenchSmall(int64_t n) {
+  std::vector<Str> keys;
+  for (int64_t i = 0; i < n; ++i) {
+    keys.push_back(Str("attr_" + std::to_string(i)));
+  }
+  int64_t num_dicts = 1 << 18;
+  Run("UDict: create with " + std::to_string(n) + " Str keys, then drop", num_dicts, [&]() {
+    for (int64_t i = 0; i < num_dicts; ++i) {
+      UDict dict;
+      for (int64_t j = 0; j < n; ++j) {
+        dict[keys[j]] = i;
+      }
+      DoNotOptimize(dict.get());
+    }
+  });
+  UDict dict;
+  for (int64_t j = 0; j < n; ++j) {
+    dict[keys[j]] = j;
+  }
+  int64_t num_lookups = 1 << 22;
+  Run("UDict: lookup hit, " + std::to_string(n) + " Str keys", num_lookups, [&]() {
+    int64_t sum = 0;
+    for (int64_t i = 0; i < num_lookups; ++i) {
+      sum += dict->at(keys[i % n]).v.v_int64;
+    }
+    DoNotOptimize(sum);
+  });
+}
+
+} // namespace
+
+int main() {
+  for (int64_t n : {2, 4, 8}) {
+    BenchSmall(n);
+  }
+  for (int64_t n : {1000, 10000, 100000, 1000000, 10000000}) {
+    BenchSize(n);
+  }
+  BenchStrKeys(100000);
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include "./common.h"
+#include <mlc/core/all.h>
+
+// String hashing throughput across lengths, comparing `StrHash` against the byte-shift hash it replaced,
+// and the effect on `Str`-keyed `UDict` lookups.
+
+namespace {
+using namespace mlc;
+using mlc::bench::DoNotOptimize;
+using mlc::bench::Run;
+
+uint64_t ByteShiftHash(const char *str, int64_t length) {
+  const char *it = str;
+  const char *end = str + length;
+  uint64_t result = 0;
+  for (; it + 8 <= end; it += 8) {
+    uint64_t b = (static_cast<uint64_t>(it[0]) << 56) | (static_cast<uint64_t>(it[1]) << 48) |
+                 (static_cast<uint64_t>(it[2]) << 40) | (static_cast<uint64_t>(it[3]) << 32) |
+                 (static_cast<uint64_t>(it[4]) << 24) | (static_cast<uint64_t>(it[5]) << 16) |
+                 (static_cast<uint64_t>(it[6]) << 8) | static_cast<uint64_t>(it[7]);
+    result = ::mlc::base::HashCombine(result, b);
+  }
+  if (it < end) {
+    uint64_t b = 0;
+    for (; it < end; ++it) {
+      b = (b << 8) | static_cast<uint64_t>(*it);
+    }
+    result = ::mlc::base::HashCombine(result, b);
+  }
+  return result;
+}
+
+void BenchLength(int64_t length) {
+  constexpr int64_t kNumBytes = 1 << 26;
+  constexpr int64_t kNumStrs = 64;
+  int64_t num_items = std::max<int64_t>(kNumBytes / std::max<int64_t>(length, 1), 1 << 16);
+  // Distinct inputs, so that the loop cannot be hoisted, without writing to them in the timed loop
+  std::vector<std::string> strs(kNumStrs, std::string(length, 'x'));
+  for (int64_t j = 0; j < kNumStrs; ++j) {
+    for (int64_t i = 0; i < length; ++i) {
+      strs[j][i] = static_cast<char>('a' + (i * 7 + j) % 26);
+    }
+  }
+  auto bench = [&](const std::string &name, auto hash) {
+    return Run(name + " (" + std::to_string(length) + " bytes)", num_items, [&]() {
+      uint64_t acc = 0;
+      for (int64_t i = 0; i < num_items; ++i) {
+        acc += hash(strs[i % kNumStrs].data(), length);
+      }
+      DoNotOptimize(acc);
+    });
+  };
+  double old_ns = bench("byte-shift hash", ByteShiftHash);
+  double new_ns = bench("StrHash", [](const char *str, int64_t n) { return ::mlc::base::StrHash(str, n); });
+  bench("Hash128", [](const char *str, int64_t n) {
+    ::mlc::base::Hash128Value h = ::mlc::base::Hash128(str, n);
+    return h.low ^ h.high;
+  });
+  std::printf("  StrHash: %.2f GB/s, %.1fx the byte-shift hash\n", static_cast<double>(length) / new_ns,
+              old_ns / new_ns);
+}
+
+void BenchDictLookup() {
+  constexpr int64_t kNumKeys = 1 << 14;
+  constexpr int64_t kNumLookups = 1 << 20;
+  UDict dict;
+  std::vector<Str> keys;
+  for (int64_t i = 0; i < kNumKeys; ++i) {
+    keys.push_back(Str("mlc.testing.field_name_" + std::to_string(i)));
+    dict[keys.back()] = i;
+  }
+  Run("UDict: lookup with Str keys", kNumLookups, [&]() {
+    for (int64_t i = 0; i < kNumLookups; ++i) {
+      DoNotOptimize(dict->at(keys[i % kNumKeys]).v.v_int64);
+    }
+  });
+}
+
+} // namespace
+
+int main() {
+  for (int64_t length : {0, 3, 8, 16, 32, 64, 256, 4096, 65536}) {
+    BenchLength(length);
+  }
+  BenchDictLookup();
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include "./common.h"
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+
+// `JSONParse` and `JSONDeserialize` on the JSON dump of a module of symbolic expressions, and on a document of long
+// strings, in nanoseconds per byte of input.
+
+namespace {
+using namespace mlc;
+using mlc::bench::DoNotOptimize;
+using mlc::bench::Run;
+
+UList MakeModule(int64_t num_funcs) {
+  using namespace mlc::sym;
+  using mlc::base::DType;
+  UList funcs;
+  for (int64_t i = 0; i < num_funcs; ++i) {
+    Var x("x_" + std::to_string(i), DType::Int(64));
+    Var y("y_" + std::to_string(i), DType::Int(64));
+    UList attrs{Str("f" + std::to_string(i)), UList{1, 2.5, "attr"}, UDict{{"index", i}, {"name", "func"}}};
+    UList body{(x + static_cast<int>(i)) * y, (x - y) * (x + 1), x * x + y * y};
+    funcs.push_back(UList{attrs, body});
+  }
+  return funcs;
+}
+
+UList MakeStrings(int64_t num_strs) {
+  UList ret;
+  for (int64_t i = 0; i < num_strs; ++i) {
+    std::string s = "a moderately long string literal number " + std::to_string(i) + ", with \"quotes\" in half";
+    ret.push_back(i % 2 == 0 ? Str(s) : Str(s.substr(0, 40)));
+  }
+  return ret;
+}
+
+} // namespace
+
+int main() {
+  FuncObj *serialize = Func::GetGlobal("mlc.core.JSONSerialize");
+  FuncObj *deserialize = Func::GetGlobal("mlc.core.JSONDeserialize");
+  FuncObj *parse = Func::GetGlobal("mlc.core.JSONParse");
+  Str module = (*serialize)(MakeModule(5000), nullptr);
+  Str strings = (*serialize)(MakeStrings(20000), nullptr);
+  Run("JSONParse: module", module->size(), [&]() { DoNotOptimize((*parse)(module).v.v_obj); });
+  Run("JSONParse: strings", strings->size(), [&]() { DoNotOptimize((*parse)(strings).v.v_obj); });
+  Run("JSONDeserialize: module", module->size(), [&]() { DoNotOptimize((*deserialize)(module, nullptr).v.v_obj); });
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include "./common.h"
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+
+// `StructuralEqual` on large graphs, reporting the number of `ObjectPath` allocated per comparison next to the time.
+// Paths are materialized only on error, so an equal comparison should allocate none.
+// Diamond-shaped graphs, where each level refers to the previous one twice, have 2^depth paths, and take time linear in
+// depth only because pairs of shared objects are compared once.
+
+namespace {
+using namespace mlc;
+using mlc::bench::DoNotOptimize;
+using mlc::bench::Run;
+
+constexpr int64_t kNumFuncs = 2000;
+
+int64_t NumPathAllocs() {
+  UDict stats = (*Func::GetGlobal("mlc.core.AllocStats"))().operator UDict();
+  if (stats->count("mlc.core.ObjectPath") == 0) {
+    return 0;
+  }
+  return stats->at("mlc.core.ObjectPath").operator UDict()->at("num_allocs").operator int64_t();
+}
+
+UList MakeModule(int64_t num_funcs, int64_t changed_func = -1) {
+  using namespace mlc::sym;
+  using mlc::base::DType;
+  Var x("x", DType::Int(64));
+  Var y("y", DType::Int(64));
+  UList funcs;
+  for (int64_t i = 0; i < num_funcs; ++i) {
+    int value = i == changed_func ? -1 : static_cast<int>(i);
+    UList attrs{Str("f" + std::to_string(i)), UList{1, 2.5, "attr"}};
+    UList body{(x + value) * y, (x - y) * (x + 1), x * x + y * y};
+    funcs.push_back(UList{attrs, body});
+  }
+  return funcs;
+}
+
+// Each level refers to the previous one twice
+UList MakeDiamond(int64_t depth, AnyView leaf) {
+  UList level{leaf};
+  for (int64_t i = 0; i < depth; ++i) {
+    level = UList{level, i, level};
+  }
+  return level;
+}
+
+void BenchDiamond(FuncObj *equal) {
+  using namespace mlc::sym;
+  using mlc::base::DType;
+  Var x("x", DType::Int(64));
+  Var y("y", DType::Int(64));
+  for (int64_t depth : {8, 16, 32, 64, 1024}) {
+    UList lhs = MakeDiamond(depth, x * x + 1);
+    UList rhs = MakeDiamond(depth, y * y + 1);
+    UList closed = MakeDiamond(depth, UList{1, 2.5, "leaf"});
+    Run("Diamond, depth " + std::to_string(depth) + ": equal", depth, [&]() {
+      DoNotOptimize((*equal)(lhs, rhs, true, false).v.v_int64);
+    });
+    Run("Diamond, depth " + std::to_string(depth) + ": identical, closed", depth, [&]() {
+      DoNotOptimize((*equal)(closed, closed, true, false).v.v_int64);
+    });
+  }
+}
+
+template <typename Fn> void BenchWithPaths(const std::string &name, Fn &&fn) {
+  int64_t before = NumPathAllocs();
+  fn();
+  int64_t num_paths = NumPathAllocs() - before;
+  Run(name, kNumFuncs, fn);
+  std::printf("  ObjectPath allocated per comparison: %lld\n", static_cast<long long>(num_paths));
+}
+
+} // namespace
+
+int main() {
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  FuncObj *equal = Func::GetGlobal("mlc.core.StructuralEqual");
+  FuncObj *fail_reason = Func::GetGlobal("mlc.core.StructuralEqualFailReason");
+  UList lhs = MakeModule(kNumFuncs);
+  UList rhs = MakeModule(kNumFuncs);
+  UList changed = MakeModule(kNumFuncs, kNumFuncs - 1);
+  BenchWithPaths("StructuralEqual: equal, assert mode", [&]() {
+    DoNotOptimize((*equal)(lhs, rhs, true, true).v.v_int64);
+  });
+  BenchWithPaths("StructuralEqual: equal, no assert", [&]() {
+    DoNotOptimize((*equal)(lhs, rhs, true, false).v.v_int64);
+  });
+  BenchWithPaths("StructuralEqual: mismatch in the last item", [&]() {
+    DoNotOptimize((*equal)(lhs, changed, true, false).v.v_int64);
+  });
+  BenchWithPaths("FailReason: mismatch in the last item", [&]() {
+    Any reason = (*fail_reason)(lhs, changed, true);
+    DoNotOptimize(reason.v.v_obj);
+  });
+  BenchDiamond(equal);
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+  return 0;
+}
@@ -0,0 +1,42 @@
+#ifndef MLC_BENCHMARKS_COMMON_H_
+#define MLC_BENCHMARKS_COMMON_H_
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace mlc {
+namespace bench {
+
+// Runs `fn` `num_repeats` times after one warm-up run, and reports the best run in nanoseconds per item.
+template <typename Fn> double Run(const std::string &name, int64_t num_items, Fn &&fn, int32_t num_repeats = 5) {
+  using Clock = std::chrono::steady_clock;
+  fn();
+  double best = 1e300;
+  for (int32_t i = 0; i < num_repeats; ++i) {
+    Clock::time_point begin = Clock::now();
+    fn();
+    Clock::time_point end = Clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count());
+  }
+  double ns_per_item = best / static_cast<double>(std::max<int64_t>(num_items, 1));
+  std::printf("%-48s %12.2f ns/item\n", name.c_str(), ns_per_item);
+  return ns_per_item;
+}
+
+// Prevents the compiler from optimizing away a computed value.
+template <typename T> inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+} // namespace bench
+} // namespace mlc
+
+#endif // MLC_BENCHMARKS_COMMON_H_
@@ -0,0 +1,810 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <mlc/core/all.h>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace mlc {
+namespace {
+
+/****************** Size-class pool ******************/
+
+/**
+ * Memory is carved out of `kSlabBytes`-aligned slabs, each serving a single size class, so that the
+ * size class of any pooled block can be recovered from its address alone. Slabs are never returned to
+ * the system; freed blocks go to the freeing thread's free list, and overflow into a global depot
+ * shared by all threads.
+ */
+constexpr int64_t kSlabBytes = 64 * 1024;
+constexpr int64_t kSlabHeaderBytes = 64;
+constexpr int64_t kSizeClassBytes = static_cast<int64_t>(::mlc::base::kPoolAlignment);
+constexpr int32_t kNumSizeClasses = static_cast<int32_t>(::mlc::base::kPoolMaxBytes / ::mlc::base::kPoolAlignment);
+constexpr int64_t kMaxLocalFreeBlocks = 4096;
+constexpr int64_t kRefillBatch = 256;
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct SlabHeader {
+  int32_t size_class;
+};
+
+struct FreeList {
+  FreeBlock *head = nullptr;
+  int64_t size = 0;
+
+  MLC_INLINE void Push(FreeBlock *block) {
+    block->next = head;
+    head = block;
+    ++size;
+  }
+
+  MLC_INLINE FreeBlock *Pop() {
+    FreeBlock *ret = head;
+    head = ret->next;
+    --size;
+    return ret;
+  }
+
+  // Moves at most `n` blocks from `this` to `dst`
+  void MoveTo(FreeList *dst, int64_t n) {
+    for (; n > 0 && head != nullptr; --n) {
+      dst->Push(this->Pop());
+    }
+  }
+};
+
+// Counters are only written by the owning thread, and read by `PoolAllocatorStats` from any thread
+struct Counter {
+  std::atomic<int64_t> value{0};
+  MLC_INLINE void Inc() { value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+  MLC_INLINE int64_t Get() const { return value.load(std::memory_order_relaxed); }
+};
+
+struct ThreadCache {
+  FreeList lists[kNumSizeClasses];
+  Counter num_allocs[kNumSizeClasses];
+  Counter num_frees[kNumSizeClasses];
+};
+
+struct PoolGlobal {
+  std::mutex mutex;
+  FreeList depot[kNumSizeClasses];
+  std::vector<ThreadCache *> caches;
+  int64_t num_slabs[kNumSizeClasses] = {};
+  // Counters accumulated from exited threads, or from frees after a thread's cache is torn down
+  int64_t retired_allocs[kNumSizeClasses] = {};
+  int64_t retired_frees[kNumSizeClasses] = {};
+
+  // Leaked on purpose: objects may be freed during static destruction
+  static PoolGlobal *Get() {
+    static PoolGlobal *inst = new PoolGlobal();
+    return inst;
+  }
+};
+
+MLC_INLINE int64_t BlockBytes(int32_t size_class) { return (size_class + 1) * kSizeClassBytes; }
+
+MLC_INLINE int32_t SizeClassOf(void *ptr) {
+  uintptr_t slab = reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(kSlabBytes - 1);
+  return reinterpret_cast<SlabHeader *>(slab)->size_class;
+}
+
+void *AlignedAlloc(int64_t num_bytes, int64_t alignment) {
+  void *ret = nullptr;
+#ifdef _MSC_VER
+  ret = _aligned_malloc(num_bytes, alignment);
+#else
+  if (posix_memalign(&ret, alignment, num_bytes) != 0) {
+    ret = nullptr;
+  }
+#endif
+  return ret;
+}
+
+void AlignedFree(void *ptr) {
+#ifdef _MSC_VER
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+// Allocates a new slab and threads all of its blocks into `dst`, lowest address first.
+bool AllocSlab(int32_t size_class, FreeList *dst) {
+  void *slab = AlignedAlloc(kSlabBytes, kSlabBytes);
+  if (slab == nullptr) {
+    return false;
+  }
+  reinterpret_cast<SlabHeader *>(slab)->size_class = size_class;
+  int64_t block_bytes = BlockBytes(size_class);
+  int64_t num_blocks = (kSlabBytes - kSlabHeaderBytes) / block_bytes;
+  char *begin = static_cast<char *>(slab) + kSlabHeaderBytes;
+  for (int64_t i = num_blocks - 1; i >= 0; --i) {
+    dst->Push(reinterpret_cast<FreeBlock *>(begin + i * block_bytes));
+  }
+  PoolGlobal *global = PoolGlobal::Get();
+  std::lock_guard<std::mutex> lock(global->mutex);
+  global->num_slabs[size_class] += 1;
+  return true;
+}
+
+struct ThreadCacheOwner {
+  ThreadCacheOwner() {
+    PoolGlobal *global = PoolGlobal::Get();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->caches.push_back(&cache);
+  }
+
+  ~ThreadCacheOwner();
+
+  ThreadCache cache;
+};
+
+thread_local ThreadCache *tls_cache = nullptr;
+thread_local bool tls_cache_destroyed = false;
+
+ThreadCacheOwner::~ThreadCacheOwner() {
+  tls_cache = nullptr;
+  tls_cache_destroyed = true;
+  PoolGlobal *global = PoolGlobal::Get();
+  std::lock_guard<std::mutex> lock(global->mutex);
+  for (int32_t c = 0; c < kNumSizeClasses; ++c) {
+    cache.lists[c].MoveTo(&global->depot[c], cache.lists[c].size);
+    global->retired_allocs[c] += cache.num_allocs[c].Get();
+    global->retired_frees[c] += cache.num_frees[c].Get();
+  }
+  global->caches.erase(std::find(global->caches.begin(), global->caches.end(), &cache));
+}
+
+// Returns nullptr if the calling thread is exiting and its cache has been torn down
+MLC_INLINE ThreadCache *LocalCache() {
+  if (tls_cache != nullptr) {
+    return tls_cache;
+  }
+  if (tls_cache_destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadCacheOwner owner;
+  return tls_cache = &owner.cache;
+}
+
+void *PoolAllocSlow(int32_t size_class) {
+  PoolGlobal *global = PoolGlobal::Get();
+  FreeList list;
+  {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->depot[size_class].MoveTo(&list, 1);
+    global->retired_allocs[size_class] += 1;
+  }
+  if (list.head == nullptr && !AllocSlab(size_class, &list)) {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->retired_allocs[size_class] -= 1;
+    return nullptr;
+  }
+  void *ret = list.Pop();
+  if (list.head != nullptr) {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    list.MoveTo(&global->depot[size_class], list.size);
+  }
+  return ret;
+}
+
+void *PoolAlloc(int64_t num_bytes) {
+  int32_t size_class = static_cast<int32_t>((std::max<int64_t>(num_bytes, 1) - 1) / kSizeClassBytes);
+  ThreadCache *cache = LocalCache();
+  if (cache == nullptr) {
+    return PoolAllocSlow(size_class);
+  }
+  FreeList &list = cache->lists[size_class];
+  if (list.head == nullptr) {
+    PoolGlobal *global = PoolGlobal::Get();
+    {
+      std::lock_guard<std::mutex> lock(global->mutex);
+      global->depot[size_class].MoveTo(&list, kRefillBatch);
+    }
+    if (list.head == nullptr && !AllocSlab(size_class, &list)) {
+      return nullptr;
+    }
+  }
+  cache->num_allocs[size_class].Inc();
+  return list.Pop();
+}
+
+void PoolFree(void *ptr) {
+  int32_t size_class = SizeClassOf(ptr);
+  FreeBlock *block = static_cast<FreeBlock *>(ptr);
+  ThreadCache *cache = LocalCache();
+  if (cache == nullptr) {
+    PoolGlobal *global = PoolGlobal::Get();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->depot[size_class].Push(block);
+    global->retired_frees[size_class] += 1;
+    return;
+  }
+  FreeList &list = cache->lists[size_class];
+  list.Push(block);
+  cache->num_frees[size_class].Inc();
+  if (list.size > kMaxLocalFreeBlocks) {
+    PoolGlobal *global = PoolGlobal::Get();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    list.MoveTo(&global->depot[size_class], kMaxLocalFreeBlocks / 2);
+  }
+}
+
+/****************** Arena ******************/
+
+/**
+ * An arena hands out memory by bumping a cursor through `kArenaChunkBytes`-aligned chunks, and
+ * releases all chunks at once. Each chunk starts with a pointer to its arena, so that an object can
+ * find its arena from its address alone.
+ *
+ * `num_live` counts the objects that are not yet freed, plus one held by the `ArenaScope` itself.
+ * Objects still alive when the scope ends have escaped it; the arena is then promoted, i.e. its
+ * chunks are kept until the last escaped object is freed, potentially by another thread.
+ */
+constexpr int64_t kArenaChunkBytes = 64 * 1024;
+constexpr int64_t kArenaChunkHeaderBytes = 64;
+constexpr int64_t kArenaMaxBytes = 4096;
+constexpr int64_t kMaxCachedArenaChunks = 64;
+
+struct Arena;
+
+struct ArenaChunk {
+  Arena *arena;
+  ArenaChunk *next;
+};
+
+struct Arena {
+  std::atomic<int64_t> num_live{1};
+  Arena *prev = nullptr;
+  ArenaChunk *chunks = nullptr;
+  char *cursor = nullptr;
+  char *end = nullptr;
+};
+
+struct ArenaGlobal {
+  std::mutex mutex;
+  // Chunks of released arenas, reused by subsequent arenas
+  ArenaChunk *cached_chunks = nullptr;
+  int64_t num_cached_chunks = 0;
+  int64_t num_chunks = 0;
+  int64_t num_scopes = 0;
+  int64_t num_promoted = 0;
+  int64_t num_escaped = 0;
+
+  // Leaked on purpose: escaped objects may be freed during static destruction
+  static ArenaGlobal *Get() {
+    static ArenaGlobal *inst = new ArenaGlobal();
+    return inst;
+  }
+};
+
+thread_local Arena *tls_arena = nullptr;
+
+ArenaChunk *ArenaChunkAlloc() {
+  ArenaGlobal *global = ArenaGlobal::Get();
+  {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    if (ArenaChunk *chunk = global->cached_chunks) {
+      global->cached_chunks = chunk->next;
+      global->num_cached_chunks -= 1;
+      return chunk;
+    }
+  }
+  ArenaChunk *chunk = static_cast<ArenaChunk *>(AlignedAlloc(kArenaChunkBytes, kArenaChunkBytes));
+  if (chunk != nullptr) {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->num_chunks += 1;
+  }
+  return chunk;
+}
+
+void ArenaRelease(Arena *arena) {
+  ArenaGlobal *global = ArenaGlobal::Get();
+  ArenaChunk *to_free = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    for (ArenaChunk *chunk = arena->chunks, *next = nullptr; chunk != nullptr; chunk = next) {
+      next = chunk->next;
+      if (global->num_cached_chunks < kMaxCachedArenaChunks) {
+        chunk->next = global->cached_chunks;
+        global->cached_chunks = chunk;
+        global->num_cached_chunks += 1;
+      } else {
+        chunk->next = to_free;
+        to_free = chunk;
+        global->num_chunks -= 1;
+      }
+    }
+  }
+  for (ArenaChunk *chunk = to_free, *next = nullptr; chunk != nullptr; chunk = next) {
+    next = chunk->next;
+    AlignedFree(chunk);
+  }
+  delete arena;
+}
+
+void *ArenaAlloc(Arena *arena, int64_t num_bytes) {
+  num_bytes = (std::max<int64_t>(num_bytes, 1) + kSizeClassBytes - 1) / kSizeClassBytes * kSizeClassBytes;
+  if (arena->end - arena->cursor < num_bytes) {
+    ArenaChunk *chunk = ArenaChunkAlloc();
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+    chunk->arena = arena;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->cursor = reinterpret_cast<char *>(chunk) + kArenaChunkHeaderBytes;
+    arena->end = reinterpret_cast<char *>(chunk) + kArenaChunkBytes;
+  }
+  void *ret = arena->cursor;
+  arena->cursor += num_bytes;
+  arena->num_live.fetch_add(1, std::memory_order_relaxed);
+  return ret;
+}
+
+void ArenaFree(void *ptr) {
+  uintptr_t chunk = reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(kArenaChunkBytes - 1);
+  Arena *arena = reinterpret_cast<ArenaChunk *>(chunk)->arena;
+  if (arena->num_live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    ArenaRelease(arena);
+  }
+}
+
+/****************** Deferred destruction ******************/
+
+/**
+ * Destroying an object decrements the reference counts of its children, which may destroy them in
+ * turn. To keep the stack bounded on deep structures, objects that reach zero while a deleter is
+ * already running on the same thread are queued, and the outermost call drains the queue in a loop.
+ *
+ * Optionally, the outermost deletions are handed over to a background reclaimer thread. Deleters then
+ * run on that thread, so it must not be enabled when objects own thread-affine resources, e.g. Python
+ * objects that require the GIL.
+ */
+struct DeleteQueue {
+  std::vector<MLCAny *> pending;
+  bool draining = false;
+};
+
+struct DeleteQueueOwner {
+  ~DeleteQueueOwner();
+  DeleteQueue queue;
+};
+
+thread_local DeleteQueue *tls_delete_queue = nullptr;
+thread_local bool tls_delete_queue_destroyed = false;
+thread_local bool tls_is_reclaimer = false;
+
+DeleteQueueOwner::~DeleteQueueOwner() {
+  // Objects queued from here on are deleted right away
+  tls_delete_queue = nullptr;
+  tls_delete_queue_destroyed = true;
+}
+
+// Returns nullptr if the calling thread is exiting and its queue has been torn down
+MLC_INLINE DeleteQueue *LocalDeleteQueue() {
+  if (tls_delete_queue != nullptr) {
+    return tls_delete_queue;
+  }
+  if (tls_delete_queue_destroyed) {
+    return nullptr;
+  }
+  thread_local DeleteQueueOwner owner;
+  return tls_delete_queue = &owner.queue;
+}
+
+void DeleteIteratively(DeleteQueue *queue, MLCAny *obj) {
+  struct DrainGuard {
+    explicit DrainGuard(DeleteQueue *queue) : queue(queue) { queue->draining = true; }
+    ~DrainGuard() { queue->draining = false; }
+    DeleteQueue *queue;
+  } guard(queue);
+  obj->v.deleter(obj);
+  while (!queue->pending.empty()) {
+    obj = queue->pending.back();
+    queue->pending.pop_back();
+    obj->v.deleter(obj);
+  }
+}
+
+struct Reclaimer {
+  std::mutex mutex;
+  std::condition_variable cv_pending;
+  std::condition_variable cv_idle;
+  std::vector<MLCAny *> pending;
+  std::atomic<bool> enabled{false};
+  bool started = false;
+  bool busy = false;
+
+  // Leaked on purpose, along with its detached thread
+  static Reclaimer *Get() {
+    static Reclaimer *inst = new Reclaimer();
+    return inst;
+  }
+
+  void SetEnabled(bool enable) {
+    if (enable) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!started) {
+        std::thread(&Reclaimer::Run, this).detach();
+        started = true;
+      }
+      enabled.store(true, std::memory_order_release);
+    } else {
+      enabled.store(false, std::memory_order_release);
+      Flush();
+    }
+  }
+
+  void Push(MLCAny *obj) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.push_back(obj);
+    }
+    cv_pending.notify_one();
+  }
+
+  void Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv_idle.wait(lock, [this]() { return pending.empty() && !busy; });
+  }
+
+  void Run() {
+    tls_is_reclaimer = true;
+    std::vector<MLCAny *> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv_pending.wait(lock, [this]() { return !pending.empty(); });
+      batch.swap(pending);
+      busy = true;
+      lock.unlock();
+      DeleteQueue *queue = LocalDeleteQueue();
+      for (MLCAny *obj : batch) {
+        DeleteIteratively(queue, obj);
+      }
+      batch.clear();
+      lock.lock();
+      busy = false;
+      if (pending.empty()) {
+        cv_idle.notify_all();
+      }
+    }
+  }
+};
+
+void ObjDelete(MLCAny *obj) {
+  DeleteQueue *queue = LocalDeleteQueue();
+  if (queue == nullptr) {
+    obj->v.deleter(obj);
+  } else if (queue->draining) {
+    queue->pending.push_back(obj);
+  } else if (!tls_is_reclaimer && Reclaimer::Get()->enabled.load(std::memory_order_acquire)) {
+    Reclaimer::Get()->Push(obj);
+  } else {
+    DeleteIteratively(queue, obj);
+  }
+}
+
+/****************** Allocation statistics ******************/
+
+/**
+ * Per-type counters, updated by the allocators when enabled, either from the start via environment
+ * variable `MLC_ALLOC_STATS=1`, or at runtime via `mlc.core.SetAllocStats`. Objects allocated while
+ * disabled are not accounted for when they are freed later. Frees are not observed while disabled,
+ * so enabling again resets the live and peak counters, which then cover objects allocated since.
+ *
+ * Counters live in chunks allocated on first use and never freed, indexed by static type indices
+ * followed by dynamic ones. Counted objects and their sizes are kept in a sharded side table.
+ */
+constexpr int32_t kStatsChunkSize = 1024;
+constexpr int32_t kStatsNumChunks = 256;
+constexpr int32_t kStatsNumShards = 64;
+
+struct TypeAllocStats {
+  std::atomic<int64_t> num_allocs{0};
+  std::atomic<int64_t> num_frees{0};
+  std::atomic<int64_t> num_live{0};
+  std::atomic<int64_t> live_bytes{0};
+  std::atomic<int64_t> peak_live{0};
+  std::atomic<int64_t> peak_bytes{0};
+};
+
+struct AllocStatsGlobal {
+  std::atomic<int32_t> enabled{0};
+  std::mutex toggle_mutex;
+  std::atomic<TypeAllocStats *> chunks[kStatsNumChunks] = {};
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<const void *, int64_t> counted_bytes;
+  } shards[kStatsNumShards];
+
+  // Leaked on purpose: objects may be freed during static destruction
+  static AllocStatsGlobal *Get() {
+    static AllocStatsGlobal *inst = []() {
+      AllocStatsGlobal *ret = new AllocStatsGlobal();
+      const char *env = std::getenv("MLC_ALLOC_STATS");
+      ret->enabled.store((env != nullptr && env[0] == '1') ? 1 : 0, std::memory_order_relaxed);
+      return ret;
+    }();
+    return inst;
+  }
+
+  // Returns nullptr if `type_index` is out of range, or if `create` is false and it is not tracked
+  TypeAllocStats *At(int32_t type_index, bool create) {
+    int64_t index = type_index < kMLCDynObjectBegin
+                        ? type_index
+                        : static_cast<int64_t>(type_index) - kMLCDynObjectBegin + kMLCTypingEnd;
+    if (index < 0 || index >= static_cast<int64_t>(kStatsChunkSize) * kStatsNumChunks) {
+      return nullptr;
+    }
+    std::atomic<TypeAllocStats *> &chunk = chunks[index / kStatsChunkSize];
+    TypeAllocStats *ptr = chunk.load(std::memory_order_acquire);
+    if (ptr == nullptr) {
+      if (!create) {
+        return nullptr;
+      }
+      TypeAllocStats *new_chunk = new TypeAllocStats[kStatsChunkSize];
+      if (chunk.compare_exchange_strong(ptr, new_chunk, std::memory_order_acq_rel)) {
+        ptr = new_chunk;
+      } else {
+        delete[] new_chunk;
+      }
+    }
+    return ptr + index % kStatsChunkSize;
+  }
+
+  Shard &ShardOf(const void *ptr) {
+    return shards[(reinterpret_cast<uintptr_t>(ptr) >> 4) % static_cast<uintptr_t>(kStatsNumShards)];
+  }
+
+  // Forgets objects counted before, whose frees may have been missed while disabled
+  void ResetLive() {
+    for (Shard &shard : shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.counted_bytes.clear();
+    }
+    for (std::atomic<TypeAllocStats *> &chunk : chunks) {
+      TypeAllocStats *ptr = chunk.load(std::memory_order_acquire);
+      for (int32_t i = 0; ptr != nullptr && i < kStatsChunkSize; ++i) {
+        ptr[i].num_live.store(0, std::memory_order_relaxed);
+        ptr[i].live_bytes.store(0, std::memory_order_relaxed);
+        ptr[i].peak_live.store(0, std::memory_order_relaxed);
+        ptr[i].peak_bytes.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+MLC_INLINE void UpdatePeak(std::atomic<int64_t> *peak, int64_t value) {
+  int64_t prev = peak->load(std::memory_order_relaxed);
+  while (prev < value && !peak->compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+  }
+}
+
+void AllocStatsOnAlloc(int32_t type_index, int64_t num_bytes, const void *ptr) {
+  AllocStatsGlobal *global = AllocStatsGlobal::Get();
+  {
+    AllocStatsGlobal::Shard &shard = global->ShardOf(ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.counted_bytes[ptr] = num_bytes;
+  }
+  if (TypeAllocStats *stats = global->At(type_index, true)) {
+    stats->num_allocs.fetch_add(1, std::memory_order_relaxed);
+    UpdatePeak(&stats->peak_live, stats->num_live.fetch_add(1, std::memory_order_relaxed) + 1);
+    UpdatePeak(&stats->peak_bytes, stats->live_bytes.fetch_add(num_bytes, std::memory_order_relaxed) + num_bytes);
+  }
+}
+
+void AllocStatsOnFree(int32_t type_index, const void *ptr) {
+  AllocStatsGlobal *global = AllocStatsGlobal::Get();
+  int64_t num_bytes = 0;
+  {
+    AllocStatsGlobal::Shard &shard = global->ShardOf(ptr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.counted_bytes.find(ptr);
+    if (it == shard.counted_bytes.end()) {
+      return; // allocated while statistics were disabled
+    }
+    num_bytes = it->second;
+    shard.counted_bytes.erase(it);
+  }
+  if (TypeAllocStats *stats = global->At(type_index, false)) {
+    stats->num_frees.fetch_add(1, std::memory_order_relaxed);
+    stats->num_live.fetch_sub(1, std::memory_order_relaxed);
+    stats->live_bytes.fetch_sub(num_bytes, std::memory_order_relaxed);
+  }
+}
+
+} // namespace
+} // namespace mlc
+
+namespace mlc {
+namespace registry {
+
+void SetAllocStats(bool enable) {
+  AllocStatsGlobal *global = AllocStatsGlobal::Get();
+  if (enable) {
+    std::lock_guard<std::mutex> lock(global->toggle_mutex);
+    if (global->enabled.load(std::memory_order_relaxed) == 0) {
+      global->ResetLive();
+      global->enabled.store(1, std::memory_order_relaxed);
+    }
+  } else {
+    global->enabled.store(0, std::memory_order_relaxed);
+  }
+}
+
+UDict AllocStats() {
+  AllocStatsGlobal *global = AllocStatsGlobal::Get();
+  UDict ret;
+  for (int32_t i = 0; i < kStatsNumChunks; ++i) {
+    TypeAllocStats *chunk = global->chunks[i].load(std::memory_order_acquire);
+    for (int32_t j = 0; chunk != nullptr && j < kStatsChunkSize; ++j) {
+      const TypeAllocStats &stats = chunk[j];
+      int64_t num_allocs = stats.num_allocs.load(std::memory_order_relaxed);
+      if (num_allocs == 0) {
+        continue;
+      }
+      int32_t index = i * kStatsChunkSize + j;
+      int32_t type_index = index < kMLCTypingEnd ? index : index - kMLCTypingEnd + kMLCDynObjectBegin;
+      ret[Lib::GetTypeKey(type_index)] = UDict{
+          {"num_allocs", num_allocs},
+          {"num_frees", stats.num_frees.load(std::memory_order_relaxed)},
+          {"num_live", stats.num_live.load(std::memory_order_relaxed)},
+          {"live_bytes", stats.live_bytes.load(std::memory_order_relaxed)},
+          {"peak_live", stats.peak_live.load(std::memory_order_relaxed)},
+          {"peak_bytes", stats.peak_bytes.load(std::memory_order_relaxed)},
+      };
+    }
+  }
+  return ret;
+}
+
+void SetBackgroundReclaimer(bool enable) { Reclaimer::Get()->SetEnabled(enable); }
+
+void FlushBackgroundReclaimer() { Reclaimer::Get()->Flush(); }
+
+UDict PoolAllocatorStats() {
+  int64_t num_allocs[kNumSizeClasses] = {};
+  int64_t num_frees[kNumSizeClasses] = {};
+  int64_t num_slabs[kNumSizeClasses] = {};
+  {
+    // Take a snapshot first: building the result allocates, which may re-enter the pool
+    PoolGlobal *global = PoolGlobal::Get();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    for (int32_t c = 0; c < kNumSizeClasses; ++c) {
+      num_allocs[c] = global->retired_allocs[c];
+      num_frees[c] = global->retired_frees[c];
+      num_slabs[c] = global->num_slabs[c];
+      for (const ThreadCache *cache : global->caches) {
+        num_allocs[c] += cache->num_allocs[c].Get();
+        num_frees[c] += cache->num_frees[c].Get();
+      }
+    }
+  }
+  UList size_classes;
+  int64_t total_allocs = 0, total_frees = 0, live_bytes = 0, reserved_bytes = 0;
+  for (int32_t c = 0; c < kNumSizeClasses; ++c) {
+    int64_t num_live = num_allocs[c] - num_frees[c];
+    size_classes.push_back(UDict{
+        {"block_bytes", BlockBytes(c)},
+        {"num_allocs", num_allocs[c]},
+        {"num_frees", num_frees[c]},
+        {"num_live", num_live},
+        {"num_slabs", num_slabs[c]},
+    });
+    total_allocs += num_allocs[c];
+    total_frees += num_frees[c];
+    live_bytes += num_live * BlockBytes(c);
+    reserved_bytes += num_slabs[c] * kSlabBytes;
+  }
+  int64_t arena_num_chunks = 0, arena_num_scopes = 0, arena_num_promoted = 0, arena_num_escaped = 0;
+  {
+    ArenaGlobal *global = ArenaGlobal::Get();
+    std::lock_guard<std::mutex> lock(global->mutex);
+    arena_num_chunks = global->num_chunks;
+    arena_num_scopes = global->num_scopes;
+    arena_num_promoted = global->num_promoted;
+    arena_num_escaped = global->num_escaped;
+  }
+  return UDict{
+      {"size_classes", size_classes},
+      {"num_allocs", total_allocs},
+      {"num_frees", total_frees},
+      {"num_live", total_allocs - total_frees},
+      {"live_bytes", live_bytes},
+      {"reserved_bytes", reserved_bytes},
+      {"arena",
+       UDict{
+           {"num_scopes", arena_num_scopes},
+           {"num_promoted", arena_num_promoted},
+           {"num_escaped", arena_num_escaped},
+           {"reserved_bytes", arena_num_chunks * kArenaChunkBytes},
+       }},
+  };
+}
+
+} // namespace registry
+} // namespace mlc
+
+MLC_API void *MLCPoolAlloc(int64_t num_bytes) {
+  if (num_bytes > static_cast<int64_t>(::mlc::base::kPoolMaxBytes)) {
+    return nullptr;
+  }
+  return ::mlc::PoolAlloc(num_bytes);
+}
+
+MLC_API void MLCPoolFree(void *ptr) {
+  if (ptr != nullptr) {
+    ::mlc::PoolFree(ptr);
+  }
+}
+
+MLC_API void *MLCArenaPush() {
+  ::mlc::Arena *arena = new ::mlc::Arena();
+  arena->prev = ::mlc::tls_arena;
+  ::mlc::tls_arena = arena;
+  return arena;
+}
+
+MLC_API int64_t MLCArenaPop(void *handle) {
+  ::mlc::Arena *arena = static_cast<::mlc::Arena *>(handle);
+  ::mlc::tls_arena = arena->prev;
+  // The arena may be released by another thread as soon as its count is decremented
+  int64_t num_escaped = arena->num_live.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  if (num_escaped == 0) {
+    ::mlc::ArenaRelease(arena);
+  }
+  ::mlc::ArenaGlobal *global = ::mlc::ArenaGlobal::Get();
+  std::lock_guard<std::mutex> lock(global->mutex);
+  global->num_scopes += 1;
+  if (num_escaped > 0) {
+    global->num_promoted += 1;
+    global->num_escaped += num_escaped;
+  }
+  return num_escaped;
+}
+
+MLC_API int64_t MLCArenaNumLive(void *handle) {
+  return static_cast<::mlc::Arena *>(handle)->num_live.load(std::memory_order_acquire) - 1;
+}
+
+MLC_API void *MLCArenaAlloc(int64_t num_bytes) {
+  ::mlc::Arena *arena = ::mlc::tls_arena;
+  if (arena == nullptr || num_bytes > ::mlc::kArenaMaxBytes) {
+    return nullptr;
+  }
+  return ::mlc::ArenaAlloc(arena, num_bytes);
+}
+
+MLC_API void MLCArenaFree(void *ptr) {
+  if (ptr != nullptr) {
+    ::mlc::ArenaFree(ptr);
+  }
+}
+
+MLC_API void MLCObjDelete(MLCAny *obj) { ::mlc::ObjDelete(obj); }
+
+MLC_API int32_t *MLCAllocStatsFlag() {
+  static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t) && std::atomic<int32_t>::is_always_lock_free);
+  return reinterpret_cast<int32_t *>(&::mlc::AllocStatsGlobal::Get()->enabled);
+}
+
+MLC_API void MLCAllocStatsOnAlloc(int32_t type_index, int64_t num_bytes, const void *ptr) {
+  ::mlc::AllocStatsOnAlloc(type_index, num_bytes, ptr);
+}
+
+MLC_API void MLCAllocStatsOnFree(int32_t type_index, const void *ptr) {
+  ::mlc::AllocStatsOnFree(type_index, ptr);
+}
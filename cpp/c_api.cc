@@ -1,5 +1,8 @@
 #include "./registry.h"
 #include <mlc/core/all.h>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
 namespace mlc {
 namespace registry {
@@ -38,6 +41,46 @@ UDict BuildInfo() {
   }();
   return build_info;
 }
+
+// Interned strings are immortal and never removed from the table, so that they can be compared by
+// address and their cached hash never goes stale. Intern identifiers, not arbitrary user data.
+struct StrInternTable {
+  static constexpr int32_t kNumShards = 16;
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string_view, StrObj *> strs;
+  } shards[kNumShards];
+
+  // Leaked on purpose: interned strings may be referenced during static destruction
+  static StrInternTable *Global() {
+    static StrInternTable *inst = new StrInternTable();
+    return inst;
+  }
+};
+
+StrObj *StrIntern(const char *str, int64_t length) {
+  uint64_t hash = ::mlc::base::StrHash(str, length);
+  std::string_view key(str, static_cast<size_t>(length));
+  StrInternTable::Shard &shard = StrInternTable::Global()->shards[hash % StrInternTable::kNumShards];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (auto it = shard.strs.find(key); it != shard.strs.end()) {
+    return it->second;
+  }
+  // Bypass any active `ArenaScope`, whose memory would otherwise be pinned forever
+  StrObj *ret = ::mlc::core::StrStd::Allocator::NewNoArena(std::string(key));
+  ret->MLCStr::hash = hash;
+  ::mlc::base::MakeImmortal(reinterpret_cast<MLCAny *>(ret));
+  shard.strs.emplace(std::string_view(ret->data(), static_cast<size_t>(length)), ret);
+  return ret;
+}
+
+Str StrInternFunc(AnyView str) {
+  if (str.type_index == kMLCRawStr) {
+    return Str::Intern(str.operator const char *());
+  }
+  StrObj *s = str.operator StrObj *();
+  return Str::Intern(s->data(), s->length());
+}
 } // namespace registry
 } // namespace mlc
 
@@ -237,6 +280,12 @@ MLC_API void MLCExtObjDelete(void *objptr) {
   }
 }
 
+MLC_API int32_t MLCStrIntern(const char *str, int64_t length, MLCStr **ret) {
+  MLC_SAFE_CALL_BEGIN();
+  *ret = ::mlc::registry::StrIntern(str, length);
+  MLC_SAFE_CALL_END(&last_error);
+}
+
 MLC_API int32_t MLCHandleGetGlobal(MLCTypeTableHandle *self) {
   MLC_SAFE_CALL_BEGIN();
   *self = TypeTable::Global();
@@ -21,14 +21,31 @@ namespace registry {
 Any JSONParse(AnyView json_str);
 Any JSONDeserialize(AnyView json_str, FuncObj *fn_opaque_deserialize);
 Str JSONSerialize(AnyView source, FuncObj *fn_opaque_serialize);
+Str BinarySerialize(AnyView source, FuncObj *fn_opaque_serialize);
+void JSONSerializeTo(AnyView source, AnyView sink, FuncObj *fn_opaque_serialize);
+void BinarySerializeTo(AnyView source, AnyView sink, FuncObj *fn_opaque_serialize);
+Any BinaryDeserialize(AnyView data, int64_t num_bytes, FuncObj *fn_opaque_deserialize);
+Any BinaryLoad(const char *path, bool lazy, FuncObj *fn_opaque_deserialize);
 bool StructuralEqual(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode);
 int64_t StructuralHash(AnyView root);
+int64_t StructuralHashCached(AnyView root, StructuralHashCache cache);
+int64_t StructuralHashParallel(AnyView root, int64_t num_threads);
+bool StructuralEqualParallel(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode, int64_t num_threads);
 Optional<Str> StructuralEqualFailReason(AnyView lhs, AnyView rhs, bool bind_free_vars);
+Any StructuralIntern(StructuralInternTable table, AnyView obj);
+Any StructuralInternGraph(StructuralInternTable table, AnyView root);
 Any CopyShallow(AnyView root);
 Any CopyDeep(AnyView root);
 void CopyReplace(int32_t num_args, const AnyView *args, Any *ret);
 Str DocToPythonScript(mlc::printer::Node node, mlc::printer::PrinterConfig cfg);
 UDict BuildInfo();
+UDict PoolAllocatorStats();
+void SetBackgroundReclaimer(bool enable);
+void FlushBackgroundReclaimer();
+void SetAllocStats(bool enable);
+UDict AllocStats();
+StrObj *StrIntern(const char *str, int64_t length);
+Str StrInternFunc(AnyView str);
 
 Str TensorToBytes(const TensorObj *src);
 Str TensorToBase64(const TensorObj *src);
@@ -91,6 +108,15 @@ struct ResourcePool {
     }
   }
 
+  // Objects that are never passed to `DelObj` are shared by every caller and live till the end of the
+  // process, so they are made immortal to spare them from reference counting. Objects that can be
+  // replaced later, e.g. methods and vtable entries, must use `AddObj`, or they would leak once dropped.
+  void AddImmortalObj(void *ptr) {
+    if (ptr != nullptr) {
+      ::mlc::base::MakeImmortal(reinterpret_cast<MLCAny *>(ptr));
+    }
+  }
+
   void DelObj(void *ptr) {
     if (ptr != nullptr) {
       this->objects.erase(this->objects.find(ptr));
@@ -213,7 +239,7 @@ struct TypeInfoWrapper {
     for (int64_t i = 0; i < num_fields; i++) {
       MLCTypeField *dst = dsts + i;
       *dst = fields[i];
-      this->pool->AddObj(dst->ty);
+      this->pool->AddImmortalObj(dst->ty);
       dst->name = this->pool->NewStr(dst->name);
       if (dst->index != i) {
         MLC_THROW(ValueError) << "Field index mismatch: " << i << " vs " << dst->index;
@@ -494,7 +520,7 @@ struct TypeTable {
     } else {
       it->second = func;
     }
-    this->pool.AddObj(func);
+    this->pool.AddImmortalObj(func);
   }
 
   TypeInfoWrapper *GetTypeInfoWrapper(int32_t type_index) {
@@ -649,18 +675,35 @@ inline TypeTable *TypeTable::New() {
   self->SetFunc("mlc.core.JSONParse", Func(::mlc::registry::JSONParse).get());
   self->SetFunc("mlc.core.JSONSerialize", Func(::mlc::registry::JSONSerialize).get());
   self->SetFunc("mlc.core.JSONDeserialize", Func(::mlc::registry::JSONDeserialize).get());
+  self->SetFunc("mlc.core.BinarySerialize", Func(::mlc::registry::BinarySerialize).get());
+  self->SetFunc("mlc.core.BinaryDeserialize", Func(::mlc::registry::BinaryDeserialize).get());
+  self->SetFunc("mlc.core.BinaryLoad", Func(::mlc::registry::BinaryLoad).get());
+  self->SetFunc("mlc.core.JSONSerializeTo", Func(::mlc::registry::JSONSerializeTo).get());
+  self->SetFunc("mlc.core.BinarySerializeTo", Func(::mlc::registry::BinarySerializeTo).get());
   self->SetFunc("mlc.core.StructuralEqual", Func(::mlc::registry::StructuralEqual).get());
   self->SetFunc("mlc.core.StructuralHash", Func(::mlc::registry::StructuralHash).get());
+  self->SetFunc("mlc.core.StructuralHashCached", Func(::mlc::registry::StructuralHashCached).get());
+  self->SetFunc("mlc.core.StructuralHashParallel", Func(::mlc::registry::StructuralHashParallel).get());
+  self->SetFunc("mlc.core.StructuralEqualParallel", Func(::mlc::registry::StructuralEqualParallel).get());
   self->SetFunc("mlc.core.StructuralEqualFailReason", Func(::mlc::registry::StructuralEqualFailReason).get());
+  self->SetFunc("mlc.core.StructuralIntern", Func(::mlc::registry::StructuralIntern).get());
+  self->SetFunc("mlc.core.StructuralInternGraph", Func(::mlc::registry::StructuralInternGraph).get());
   self->SetFunc("mlc.core.CopyShallow", Func(::mlc::registry::CopyShallow).get());
   self->SetFunc("mlc.core.CopyDeep", Func(::mlc::registry::CopyDeep).get());
   self->SetFunc("mlc.core.CopyReplace", Func(::mlc::registry::CopyReplace).get());
   self->SetFunc("mlc.core.BuildInfo", Func(::mlc::registry::BuildInfo).get());
+  self->SetFunc("mlc.core.PoolAllocatorStats", Func(::mlc::registry::PoolAllocatorStats).get());
+  self->SetFunc("mlc.core.SetBackgroundReclaimer", Func(::mlc::registry::SetBackgroundReclaimer).get());
+  self->SetFunc("mlc.core.FlushBackgroundReclaimer", Func(::mlc::registry::FlushBackgroundReclaimer).get());
+  self->SetFunc("mlc.core.SetAllocStats", Func(::mlc::registry::SetAllocStats).get());
+  self->SetFunc("mlc.core.AllocStats", Func(::mlc::registry::AllocStats).get());
+  self->SetFunc("mlc.core.StrIntern", Func(::mlc::registry::StrInternFunc).get());
   self->SetFunc("mlc.core.TensorToBytes", Func(::mlc::registry::TensorToBytes).get());
   self->SetFunc("mlc.core.TensorFromBytes", Func(::mlc::registry::TensorFromBytes).get());
   self->SetFunc("mlc.core.TensorToBase64", Func(::mlc::registry::TensorToBase64).get());
   self->SetFunc("mlc.core.TensorFromBase64", Func(::mlc::registry::TensorFromBase64).get());
   self->SetFunc("mlc.core.TensorToDLPack", Func([](Tensor tensor) -> void * { return tensor->DLPack(); }).get());
+  self->SetFunc("mlc.core.TypedListToDLPack", Func([](UTypedList list) -> void * { return list->DLPack(); }).get());
   self->SetFunc("mlc.printer.DocToPythonScript", Func(::mlc::registry::DocToPythonScript).get());
   self->SetFunc("mlc.printer.ToPython", Func(::mlc::printer::ToPython).get());
 
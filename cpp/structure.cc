@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
@@ -11,266 +12,629 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLC_JSON_USE_SSE2 1
+#define MLC_JSON_USE_NEON 0
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MLC_JSON_USE_SSE2 0
+#define MLC_JSON_USE_NEON 1
+#else
+#define MLC_JSON_USE_SSE2 0
+#define MLC_JSON_USE_NEON 0
+#endif
 
 namespace mlc {
 namespace {
 
 using mlc::core::ObjectPath;
+using mlc::core::Sink;
 using mlc::core::TopoVisit;
 using mlc::core::VisitFields;
 using mlc::core::VisitStructure;
 
 /****************** JSON ******************/
 
-inline Any JSONParse(const char *json_str, int64_t json_str_len) {
-  struct JSONParser {
-    Any Parse() {
-      SkipWhitespace();
-      Any result = ParseValue();
-      SkipWhitespace();
-      if (i != json_str_len) {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                              << ": Extra data after valid JSON. JSON string: " << json_str;
-      }
-      return result;
+// A string of `size` bytes copied from `data`, which may contain zeros
+inline Str StrFromBytes(const void *data, int64_t size) {
+  Str ret(::mlc::core::StrPad::Allocator::NewWithPad<char>(size + 1, size));
+  std::memcpy(ret->data(), data, static_cast<size_t>(size));
+  ret->data()[size] = '\0';
+  return ret;
+}
+
+// Character-at-a-time reference parser. It defines the accepted syntax and the error messages, and is used directly
+// for anything `JSONIndexParser` gives up on.
+struct JSONScalarParser {
+  Any Parse() {
+    SkipWhitespace();
+    Any result = ParseValue();
+    SkipWhitespace();
+    if (i != json_str_len) {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                            << ": Extra data after valid JSON. JSON string: " << json_str;
     }
+    return result;
+  }
 
-    void ExpectChar(char c) {
-      if (json_str[i] == c) {
-        ++i;
-      } else {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << c << "' but got '"
-                              << json_str[i] << "'. JSON string: " << json_str;
-      }
+  void ExpectChar(char c) {
+    if (json_str[i] == c) {
+      ++i;
+    } else {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << c << "' but got '"
+                            << json_str[i] << "'. JSON string: " << json_str;
     }
+  }
 
-    char PeekChar() { return i < json_str_len ? json_str[i] : '\0'; }
+  char PeekChar() { return i < json_str_len ? json_str[i] : '\0'; }
 
-    void SkipWhitespace() {
-      while (i < json_str_len && std::isspace(json_str[i])) {
-        ++i;
-      }
+  void SkipWhitespace() {
+    while (i < json_str_len && std::isspace(json_str[i])) {
+      ++i;
     }
+  }
 
-    void ExpectString(const char *expected, int64_t len) {
-      if (i + len <= json_str_len && std::strncmp(json_str + i, expected, len) == 0) {
-        i = i + len;
-      } else {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << expected
-                              << ". JSON string: " << json_str;
-      }
+  void ExpectString(const char *expected, int64_t len) {
+    if (i + len <= json_str_len && std::strncmp(json_str + i, expected, len) == 0) {
+      i = i + len;
+    } else {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << expected
+                            << ". JSON string: " << json_str;
     }
+  }
 
-    Any ParseNull() {
-      ExpectString("null", 4);
-      return Any(nullptr);
+  Any ParseNull() {
+    ExpectString("null", 4);
+    return Any(nullptr);
+  }
+
+  Any ParseBoolean() {
+    if (PeekChar() == 't') {
+      ExpectString("true", 4);
+      return Any(true);
+    } else {
+      ExpectString("false", 5);
+      return Any(false);
     }
+  }
 
-    Any ParseBoolean() {
-      if (PeekChar() == 't') {
-        ExpectString("true", 4);
-        return Any(true);
+  Any ParseNumber() {
+    int64_t start = i;
+    // Identify the end of the numeric sequence
+    while (i < json_str_len) {
+      char c = json_str[i];
+      if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' || std::isdigit(c)) {
+        ++i;
       } else {
-        ExpectString("false", 5);
-        return Any(false);
+        break;
+      }
+    }
+    std::string num_str(json_str + start, i - start);
+    std::size_t pos = 0;
+    try {
+      // Attempt to parse as integer
+      int64_t int_value = std::stoll(num_str, &pos);
+      if (pos == num_str.size()) {
+        i = start + static_cast<int64_t>(pos); // Update the main index
+        return Any(int_value);
       }
+    } catch (const std::invalid_argument &) { // Not an integer, proceed to parse as double
+    } catch (const std::out_of_range &) {     // Integer out of range, proceed to parse as double
+    }
+    try {
+      // Attempt to parse as double
+      double double_value = std::stod(num_str, &pos);
+      if (pos == num_str.size()) {
+        i = start + pos; // Update the main index
+        return Any(double_value);
+      }
+    } catch (const std::invalid_argument &) {
+    } catch (const std::out_of_range &) {
     }
+    MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                          << ": Invalid number format. JSON string: " << json_str;
+    MLC_UNREACHABLE();
+  }
 
-    Any ParseNumber() {
+  Any ParseStr(bool intern = false) {
+    ExpectChar('"');
+    std::string str;
+    while (true) {
+      // Copy the run of regular characters up to the next quote or backslash at once
       int64_t start = i;
-      // Identify the end of the numeric sequence
-      while (i < json_str_len) {
-        char c = json_str[i];
-        if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' || std::isdigit(c)) {
-          ++i;
-        } else {
-          break;
-        }
+      while (i < json_str_len && json_str[i] != '"' && json_str[i] != '\\') {
+        ++i;
       }
-      std::string num_str(json_str + start, i - start);
-      std::size_t pos = 0;
-      try {
-        // Attempt to parse as integer
-        int64_t int_value = std::stoll(num_str, &pos);
-        if (pos == num_str.size()) {
-          i = start + static_cast<int64_t>(pos); // Update the main index
-          return Any(int_value);
-        }
-      } catch (const std::invalid_argument &) { // Not an integer, proceed to parse as double
-      } catch (const std::out_of_range &) {     // Integer out of range, proceed to parse as double
+      str.append(json_str + start, static_cast<size_t>(i - start));
+      if (i >= json_str_len) {
+        MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                              << ": Unterminated string. JSON string: " << json_str;
       }
-      try {
-        // Attempt to parse as double
-        double double_value = std::stod(num_str, &pos);
-        if (pos == num_str.size()) {
-          i = start + pos; // Update the main index
-          return Any(double_value);
-        }
-      } catch (const std::invalid_argument &) {
-      } catch (const std::out_of_range &) {
+      char c = json_str[i++];
+      if (c == '"') {
+        // End of string
+        return intern ? Any(Str::Intern(str)) : Any(Str(str));
       }
-      MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                            << ": Invalid number format. JSON string: " << json_str;
-      MLC_UNREACHABLE();
-    }
-
-    Any ParseStr() {
-      ExpectChar('"');
-      std::ostringstream oss;
-      while (true) {
-        if (i >= json_str_len) {
-          MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                                << ": Unterminated string. JSON string: " << json_str;
+      // Handle escape sequences
+      if (i >= json_str_len) {
+        MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                              << ": Incomplete escape sequence. JSON string: " << json_str;
+      }
+      char next = json_str[i++];
+      switch (next) {
+      case 'n':
+        str += '\n';
+        break;
+      case 't':
+        str += '\t';
+        break;
+      case 'r':
+        str += '\r';
+        break;
+      case '\\':
+        str += '\\';
+        break;
+      case '"':
+        str += '\"';
+        break;
+      case 'x': {
+        if (i + 1 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1])) {
+          int32_t value = std::stoi(std::string(json_str + i, 2), nullptr, 16);
+          str += static_cast<char>(value);
+          i += 2;
+        } else {
+          MLC_THROW(ValueError) << "Invalid hexadecimal escape sequence at position " << i - 2
+                                << " in string: " << json_str;
         }
-        char c = json_str[i++];
-        if (c == '"') {
-          // End of string
-          return Any(Str(oss.str()));
-        } else if (c == '\\') {
-          // Handle escape sequences
-          if (i >= json_str_len) {
-            MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                                  << ": Incomplete escape sequence. JSON string: " << json_str;
-          }
-          char next = json_str[i++];
-          switch (next) {
-          case 'n':
-            oss << '\n';
-            break;
-          case 't':
-            oss << '\t';
-            break;
-          case 'r':
-            oss << '\r';
-            break;
-          case '\\':
-            oss << '\\';
-            break;
-          case '"':
-            oss << '\"';
-            break;
-          case 'x': {
-            if (i + 1 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1])) {
-              int32_t value = std::stoi(std::string(json_str + i, 2), nullptr, 16);
-              oss << static_cast<char>(value);
-              i += 2;
-            } else {
-              MLC_THROW(ValueError) << "Invalid hexadecimal escape sequence at position " << i - 2
-                                    << " in string: " << json_str;
-            }
-            break;
-          }
-          case 'u': {
-            if (i + 3 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1]) &&
-                std::isxdigit(json_str[i + 2]) && std::isxdigit(json_str[i + 3])) {
-              int32_t codepoint = std::stoi(std::string(json_str + i, 4), nullptr, 16);
-              if (codepoint <= 0x7F) {
-                // 1-byte UTF-8
-                oss << static_cast<char>(codepoint);
-              } else if (codepoint <= 0x7FF) {
-                // 2-byte UTF-8
-                oss << static_cast<char>(0xC0 | (codepoint >> 6));
-                oss << static_cast<char>(0x80 | (codepoint & 0x3F));
-              } else {
-                // 3-byte UTF-8
-                oss << static_cast<char>(0xE0 | (codepoint >> 12));
-                oss << static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-                oss << static_cast<char>(0x80 | (codepoint & 0x3F));
-              }
-              i += 4;
-            } else {
-              MLC_THROW(ValueError) << "Invalid Unicode escape sequence at position " << i - 2
-                                    << " in string: " << json_str;
-            }
-            break;
-          }
-          default:
-            // Unrecognized escape sequence, interpret literally
-            oss << next;
-            break;
+        break;
+      }
+      case 'u': {
+        if (i + 3 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1]) &&
+            std::isxdigit(json_str[i + 2]) && std::isxdigit(json_str[i + 3])) {
+          int32_t codepoint = std::stoi(std::string(json_str + i, 4), nullptr, 16);
+          if (codepoint <= 0x7F) {
+            // 1-byte UTF-8
+            str += static_cast<char>(codepoint);
+          } else if (codepoint <= 0x7FF) {
+            // 2-byte UTF-8
+            str += static_cast<char>(0xC0 | (codepoint >> 6));
+            str += static_cast<char>(0x80 | (codepoint & 0x3F));
+          } else {
+            // 3-byte UTF-8
+            str += static_cast<char>(0xE0 | (codepoint >> 12));
+            str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            str += static_cast<char>(0x80 | (codepoint & 0x3F));
           }
+          i += 4;
         } else {
-          // Regular character, copy as-is
-          oss << c;
+          MLC_THROW(ValueError) << "Invalid Unicode escape sequence at position " << i - 2
+                                << " in string: " << json_str;
         }
+        break;
+      }
+      default:
+        // Unrecognized escape sequence, interpret literally
+        str += next;
+        break;
       }
     }
+  }
 
-    UList ParseArray() {
-      UList arr;
-      ExpectChar('[');
+  UList ParseArray() {
+    UList arr;
+    ExpectChar('[');
+    SkipWhitespace();
+    if (PeekChar() == ']') {
+      ExpectChar(']');
+      return arr;
+    }
+    while (true) {
+      SkipWhitespace();
+      arr.push_back(ParseValue());
       SkipWhitespace();
       if (PeekChar() == ']') {
         ExpectChar(']');
         return arr;
       }
-      while (true) {
-        SkipWhitespace();
-        arr.push_back(ParseValue());
-        SkipWhitespace();
-        if (PeekChar() == ']') {
-          ExpectChar(']');
-          return arr;
-        }
-        ExpectChar(',');
-      }
+      ExpectChar(',');
     }
+  }
 
-    Any ParseObject() {
-      UDict obj;
-      ExpectChar('{');
+  Any ParseObject() {
+    UDict obj;
+    ExpectChar('{');
+    SkipWhitespace();
+    if (PeekChar() == '}') {
+      ExpectChar('}');
+      return Any(obj);
+    }
+    while (true) {
+      SkipWhitespace();
+      Any key = ParseStr(intern_keys);
+      SkipWhitespace();
+      ExpectChar(':');
+      SkipWhitespace();
+      Any value = ParseValue();
+      obj[key] = value;
       SkipWhitespace();
       if (PeekChar() == '}') {
         ExpectChar('}');
         return Any(obj);
       }
-      while (true) {
-        SkipWhitespace();
-        Any key = ParseStr();
-        SkipWhitespace();
-        ExpectChar(':');
-        SkipWhitespace();
-        Any value = ParseValue();
-        obj[key] = value;
-        SkipWhitespace();
-        if (PeekChar() == '}') {
-          ExpectChar('}');
-          return Any(obj);
-        }
-        ExpectChar(',');
+      ExpectChar(',');
+    }
+  }
+
+  Any ParseValue() {
+    SkipWhitespace();
+    char c = PeekChar();
+    if (c == '"') {
+      return ParseStr();
+    } else if (c == '{') {
+      return ParseObject();
+    } else if (c == '[') {
+      return ParseArray();
+    } else if (c == 'n') {
+      return ParseNull();
+    } else if (c == 't' || c == 'f') {
+      return ParseBoolean();
+    } else if (std::isdigit(c) || c == '-') {
+      return ParseNumber();
+    } else {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Unexpected character: " << c
+                            << ". JSON string: " << json_str;
+    }
+    MLC_UNREACHABLE();
+  }
+  int64_t i;
+  int64_t json_str_len;
+  const char *json_str;
+  bool intern_keys;
+};
+
+// Stage 1: positions of all structural characters in the input, i.e. brackets, braces, colons and commas outside of
+// strings, the opening and closing quotes of strings, and the first character of each other token (numbers and
+// literals). The input is classified 64 bytes at a time into bit masks, one bit per byte, and strings are found without
+// branching on their content, by a prefix XOR over the mask of unescaped quotes.
+struct JSONStructuralIndex {
+  // Per-byte classes of a 64-byte block
+  struct Block {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;    // `[]{}:,`
+    uint64_t space; // as in `std::isspace`: ' ', '\t', '\n', '\v', '\f', '\r'
+  };
+
+  // Returns false if a string is left unterminated
+  bool Build(const char *str, int64_t len) {
+    indices.clear();
+    indices.reserve(static_cast<size_t>(len / 4 + 64));
+    char padded[64];
+    for (int64_t start = 0; start < len; start += 64) {
+      const char *block = str + start;
+      if (len - start < 64) {
+        // Pad the last block with whitespace, which never starts a token
+        std::memset(padded, ' ', sizeof(padded));
+        std::memcpy(padded, block, static_cast<size_t>(len - start));
+        block = padded;
+      }
+      Block b = Classify(reinterpret_cast<const uint8_t *>(block));
+      uint64_t quote = b.quote & ~Escaped(b.backslash);
+      uint64_t in_string = PrefixXor(quote) ^ prev_in_string;
+      prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+      uint64_t scalar = ~(b.op | b.space | quote | in_string);
+      uint64_t token_starts = scalar & ~((scalar << 1) | prev_scalar);
+      prev_scalar = scalar >> 63;
+      uint64_t structural = ((b.op | token_starts) & ~in_string) | quote;
+      while (structural) {
+        indices.push_back(static_cast<uint32_t>(start + ::mlc::base::CountTrailingZeros(structural)));
+        structural &= structural - 1;
       }
     }
+    return prev_in_string == 0;
+  }
 
-    Any ParseValue() {
-      SkipWhitespace();
-      char c = PeekChar();
-      if (c == '"') {
-        return ParseStr();
-      } else if (c == '{') {
-        return ParseObject();
-      } else if (c == '[') {
-        return ParseArray();
-      } else if (c == 'n') {
-        return ParseNull();
-      } else if (c == 't' || c == 'f') {
-        return ParseBoolean();
-      } else if (std::isdigit(c) || c == '-') {
-        return ParseNumber();
+  // Bits of the characters that follow an odd-length run of backslashes
+  uint64_t Escaped(uint64_t backslash) {
+    uint64_t escaped = 0;
+    if (prev_escape) {
+      escaped = 1;
+      backslash &= ~1ull;
+      prev_escape = false;
+    }
+    while (backslash) {
+      int32_t p = ::mlc::base::CountTrailingZeros(backslash);
+      backslash &= backslash - 1;
+      if (p == 63) {
+        prev_escape = true;
       } else {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Unexpected character: " << c
-                              << ". JSON string: " << json_str;
+        escaped |= 1ull << (p + 1);
+        backslash &= ~(1ull << (p + 1));
       }
-      MLC_UNREACHABLE();
     }
-    int64_t i;
-    int64_t json_str_len;
-    const char *json_str;
-  };
+    return escaped;
+  }
+
+  // Bit `i` of the result is the XOR of bits `[0, i]`, i.e. whether byte `i` is within an odd number of quotes
+  static uint64_t PrefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+#if MLC_JSON_USE_SSE2
+  static Block Classify(const uint8_t *block) {
+    Block b{0, 0, 0, 0};
+    for (int32_t j = 0; j < 4; ++j) {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + j * 16));
+      // `[` and `]` differ from `{` and `}` only in bit 0x20
+      __m128i lower = _mm_or_si128(x, _mm_set1_epi8(0x20));
+      __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')),  //
+                                             _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))), //
+                                _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(':')),      //
+                                             _mm_cmpeq_epi8(x, _mm_set1_epi8(','))));
+      // `'\t' <= x <= '\r'` as an unsigned comparison of `x - '\t'` against 4
+      __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8('\t'));
+      __m128i space = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')),
+                                   _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted));
+      b.quote |= ToMask(_mm_cmpeq_epi8(x, _mm_set1_epi8('"'))) << (j * 16);
+      b.backslash |= ToMask(_mm_cmpeq_epi8(x, _mm_set1_epi8('\\'))) << (j * 16);
+      b.op |= ToMask(op) << (j * 16);
+      b.space |= ToMask(space) << (j * 16);
+    }
+    return b;
+  }
+  static uint64_t ToMask(__m128i x) { return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(x))); }
+#elif MLC_JSON_USE_NEON
+  static Block Classify(const uint8_t *block) {
+    uint8x16_t x[4];
+    uint8x16_t quote[4], backslash[4], op[4], space[4];
+    for (int32_t j = 0; j < 4; ++j) {
+      x[j] = vld1q_u8(block + j * 16);
+      // `[` and `]` differ from `{` and `}` only in bit 0x20
+      uint8x16_t lower = vorrq_u8(x[j], vdupq_n_u8(0x20));
+      op[j] = vorrq_u8(vorrq_u8(vceqq_u8(lower, vdupq_n_u8('{')), vceqq_u8(lower, vdupq_n_u8('}'))),
+                       vorrq_u8(vceqq_u8(x[j], vdupq_n_u8(':')), vceqq_u8(x[j], vdupq_n_u8(','))));
+      space[j] = vorrq_u8(vceqq_u8(x[j], vdupq_n_u8(' ')), vcleq_u8(vsubq_u8(x[j], vdupq_n_u8('\t')), vdupq_n_u8(4)));
+      quote[j] = vceqq_u8(x[j], vdupq_n_u8('"'));
+      backslash[j] = vceqq_u8(x[j], vdupq_n_u8('\\'));
+    }
+    return Block{ToMask(quote), ToMask(backslash), ToMask(op), ToMask(space)};
+  }
+  // Keeps one weighted bit per 0x00/0xFF byte, and sums neighbouring bytes pairwise until each byte of the low half
+  // holds the bits of 8 consecutive input bytes
+  static uint64_t ToMask(const uint8x16_t *m) {
+    const uint8x16_t weights = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t sum01 = vpaddq_u8(vandq_u8(m[0], weights), vandq_u8(m[1], weights));
+    uint8x16_t sum23 = vpaddq_u8(vandq_u8(m[2], weights), vandq_u8(m[3], weights));
+    uint8x16_t sum = vpaddq_u8(sum01, sum23);
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+  }
+#else
+  static Block Classify(const uint8_t *block) {
+    Block b{0, 0, 0, 0};
+    for (int32_t j = 0; j < 64; ++j) {
+      uint8_t c = block[j];
+      uint64_t bit = 1ull << j;
+      b.quote |= c == '"' ? bit : 0;
+      b.backslash |= c == '\\' ? bit : 0;
+      b.op |= (c == '[' || c == ']' || c == '{' || c == '}' || c == ':' || c == ',') ? bit : 0;
+      b.space |= (c == ' ' || (c >= '\t' && c <= '\r')) ? bit : 0;
+    }
+    return b;
+  }
+#endif
+
+  std::vector<uint32_t> indices;
+  uint64_t prev_in_string = 0;
+  uint64_t prev_scalar = 0;
+  bool prev_escape = false;
+};
+
+// Stage 2: builds values by walking the structural index, so whitespace is never looked at and a string without
+// escapes is copied at once. Anything outside of the common path, including every malformed input, throws `Fallback`
+// and is left to `JSONScalarParser`, which then reports the same error at the same position as it always did.
+struct JSONIndexParser {
+  struct Fallback {};
+
+  Any Parse() {
+    if (!index.Build(json_str, json_str_len) || index.indices.empty()) {
+      throw Fallback();
+    }
+    indices = index.indices.data();
+    num_indices = static_cast<int64_t>(index.indices.size());
+    Any result = ParseValue();
+    if (k != num_indices) {
+      throw Fallback();
+    }
+    return result;
+  }
+
+  int64_t Next() {
+    if (k >= num_indices) {
+      throw Fallback();
+    }
+    return indices[k++];
+  }
+
+  char Peek() const { return k < num_indices ? json_str[indices[k]] : '\0'; }
+
+  // A scalar token must end at whitespace, a structural character, or the end of input
+  void ExpectTokenEnd(int64_t end) const {
+    if (end < json_str_len) {
+      char c = json_str[end];
+      if (!(c == ' ' || (c >= '\t' && c <= '\r') || c == ',' || c == ']' || c == '}' || c == ':' || c == '[' ||
+            c == '{' || c == '"')) {
+        throw Fallback();
+      }
+    }
+  }
+
+  void ExpectLiteral(int64_t pos, const char *literal, int64_t len) const {
+    if (pos + len > json_str_len || std::memcmp(json_str + pos, literal, len) != 0) {
+      throw Fallback();
+    }
+    ExpectTokenEnd(pos + len);
+  }
+
+  Any ParseNumber(int64_t pos) {
+    // Fast path: an integer of at most 18 digits, which cannot overflow
+    int64_t end = pos + (json_str[pos] == '-');
+    int64_t digits_begin = end;
+    int64_t value = 0;
+    while (end < json_str_len && end - digits_begin < 18 && json_str[end] >= '0' && json_str[end] <= '9') {
+      value = value * 10 + (json_str[end++] - '0');
+    }
+    char c = end < json_str_len ? json_str[end] : '\0';
+    if (end == digits_begin || (c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+      scalar.i = pos;
+      Any ret = scalar.ParseNumber();
+      ExpectTokenEnd(scalar.i);
+      return ret;
+    }
+    ExpectTokenEnd(end);
+    return Any(json_str[pos] == '-' ? -value : value);
+  }
+
+  Any ParseStr(int64_t pos, bool intern) {
+    // The next structural character is always the closing quote
+    int64_t end = Next();
+    const char *begin = json_str + pos + 1;
+    int64_t size = end - pos - 1;
+    if (std::memchr(begin, '\\', static_cast<size_t>(size)) == nullptr) {
+      return intern ? Any(Str::Intern(begin, size)) : Any(StrFromBytes(begin, size));
+    }
+    scalar.i = pos;
+    Any ret = scalar.ParseStr(intern);
+    if (scalar.i != end + 1) {
+      throw Fallback();
+    }
+    return ret;
+  }
+
+  UList ParseArray() {
+    if (Peek() == ']') {
+      ++k;
+      return UList();
+    }
+    // Elements are collected on `stack` so that the list is allocated once at its final size
+    size_t begin = stack.size();
+    while (true) {
+      stack.push_back(ParseValue());
+      char c = json_str[Next()];
+      if (c == ']') {
+        UList arr(stack.begin() + begin, stack.end());
+        stack.resize(begin);
+        return arr;
+      } else if (c != ',') {
+        throw Fallback();
+      }
+    }
+  }
+
+  Any ParseObject() {
+    UDict obj;
+    if (Peek() == '}') {
+      ++k;
+      return Any(obj);
+    }
+    while (true) {
+      int64_t pos = Next();
+      if (json_str[pos] != '"') {
+        throw Fallback();
+      }
+      Any key = ParseStr(pos, intern_keys);
+      if (json_str[Next()] != ':') {
+        throw Fallback();
+      }
+      Any value = ParseValue();
+      obj[key] = value;
+      char c = json_str[Next()];
+      if (c == '}') {
+        return Any(obj);
+      } else if (c != ',') {
+        throw Fallback();
+      }
+    }
+  }
+
+  Any ParseValue() {
+    int64_t pos = Next();
+    switch (json_str[pos]) {
+    case '"':
+      return ParseStr(pos, false);
+    case '{':
+      return ParseObject();
+    case '[':
+      return ParseArray();
+    case 'n':
+      ExpectLiteral(pos, "null", 4);
+      return Any(nullptr);
+    case 't':
+      ExpectLiteral(pos, "true", 4);
+      return Any(true);
+    case 'f':
+      ExpectLiteral(pos, "false", 5);
+      return Any(false);
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return ParseNumber(pos);
+    default:
+      throw Fallback();
+    }
+  }
+
+  const char *json_str;
+  int64_t json_str_len;
+  bool intern_keys;
+  JSONScalarParser scalar;
+  JSONStructuralIndex index{};
+  std::vector<Any> stack{};
+  const uint32_t *indices = nullptr;
+  int64_t num_indices = 0;
+  int64_t k = 0;
+};
+
+// With `intern_keys`, keys of JSON objects are interned, which suits documents that repeat a small
+// set of keys, e.g. those produced by `Serialize`.
+inline Any JSONParse(const char *json_str, int64_t json_str_len, bool intern_keys = false) {
   if (json_str_len < 0) {
     json_str_len = static_cast<int64_t>(std::strlen(json_str));
   }
-  return JSONParser{0, json_str_len, json_str}.Parse();
+  // Positions in the structural index are 32-bit
+  if (json_str_len <= static_cast<int64_t>(UINT32_MAX)) {
+    try {
+      JSONScalarParser scalar{0, json_str_len, json_str, intern_keys};
+      return JSONIndexParser{json_str, json_str_len, intern_keys, scalar}.Parse();
+    } catch (const JSONIndexParser::Fallback &) {
+    }
+  }
+  return JSONScalarParser{0, json_str_len, json_str, intern_keys}.Parse();
 }
 
 /****************** Base64 Encoding/Decoding ******************/
@@ -372,16 +736,213 @@ struct SEqualError : public std::runtime_error {
   SEqualError(const char *msg, ObjectPath path) : std::runtime_error(msg), path(path) {}
 };
 
+// Pairs of subtrees proven equal by the workers of `StructuralEqualParallelImpl`, one map from lhs to rhs per worker
+struct ProvenEqualPairs {
+  bool Contains(Object *lhs, Object *rhs) const {
+    for (const std::unordered_map<Object *, Object *> &part : parts) {
+      if (auto it = part.find(lhs); it != part.end() && it->second == rhs) {
+        return true;
+      }
+    }
+    return false;
+  }
+  std::vector<std::unordered_map<Object *, Object *>> parts;
+};
+
 template <typename T> MLC_INLINE T *WithOffset(Object *obj, MLCTypeField *field) {
   return reinterpret_cast<T *>(reinterpret_cast<char *>(obj) + field->offset);
 }
 
-#define MLC_CORE_EQ_S_ERR(LHS, RHS, PATH)                                                                              \
+// Collects the objects held by the structure fields of an object in field order, and `nullptr` for other values
+struct StructureChildCollector {
+  static Object *AsObject(const Any &v) {
+    return v.type_index >= kMLCStaticObjectBegin ? v.operator Object *() : nullptr;
+  }
+  template <typename T> void operator()(MLCTypeField *, StructureFieldKind, T *) {}
+  void operator()(MLCTypeField *, StructureFieldKind, Any *v) { children->push_back(AsObject(*v)); }
+  void operator()(MLCTypeField *, StructureFieldKind, ObjectRef *v) { children->push_back(v->get()); }
+  void operator()(MLCTypeField *, StructureFieldKind, Optional<ObjectRef> *v) { children->push_back(v->get()); }
+  std::vector<Object *> *children;
+};
+
+// Appends the children of `obj` in the order the serial traversals pair them up, or returns false if `obj` is a leaf,
+// or a container whose children are not paired up by position, i.e. a dict
+inline bool CollectStructureChildren(Object *obj, std::vector<Object *> *children) {
+  if (obj->IsInstance<UListObj>()) {
+    UListObj *list = reinterpret_cast<UListObj *>(obj);
+    for (int64_t i = 0; i < list->size(); ++i) {
+      children->push_back(StructureChildCollector::AsObject(list->at(i)));
+    }
+    return true;
+  } else if (obj->IsInstance<PersistentListObj>()) {
+    reinterpret_cast<PersistentListObj *>(obj)->ForEach(
+        [children](const Any &elem) { children->push_back(StructureChildCollector::AsObject(elem)); });
+    return true;
+  } else if (obj->GetTypeIndex() < kMLCDynObjectBegin) {
+    return false;
+  }
+  MLCTypeInfo *type_info = Lib::GetTypeInfo(obj->GetTypeIndex());
+  if (type_info->structure_kind == 0) {
+    return false;
+  }
+  VisitStructure(obj, type_info, StructureChildCollector{children});
+  return true;
+}
+
+using ObjectPair = std::pair<Object *, Object *>;
+
+struct ObjectPairHash {
+  size_t operator()(const ObjectPair &pair) const {
+    uint64_t lhs = reinterpret_cast<uintptr_t>(pair.first);
+    uint64_t rhs = reinterpret_cast<uintptr_t>(pair.second);
+    return static_cast<size_t>(::mlc::base::HashCombine(lhs, rhs));
+  }
+};
+
+// Finds NaN among the floating-point values held by the structure fields of an object, see `HoldsNaN`
+struct StructureNaNFinder {
+  static bool IsNaN(const Any &v) { return v.type_index == kMLCFloat && std::isnan(v.v.v_float64); }
+  template <typename T> void operator()(MLCTypeField *, StructureFieldKind, T *) {}
+  void operator()(MLCTypeField *, StructureFieldKind, float *v) { *found = *found || std::isnan(*v); }
+  void operator()(MLCTypeField *, StructureFieldKind, double *v) { *found = *found || std::isnan(*v); }
+  void operator()(MLCTypeField *, StructureFieldKind, Optional<double> *v) {
+    *found = *found || (v->get() != nullptr && std::isnan(*v->get()));
+  }
+  void operator()(MLCTypeField *, StructureFieldKind, Any *v) { *found = *found || IsNaN(*v); }
+  bool *found;
+};
+
+// Returns whether `obj` directly holds a NaN, which is not structurally equal to itself
+inline bool HoldsNaN(Object *obj) {
+  bool found = false;
+  if (UListObj *list = obj->as<UListObj>()) {
+    for (int64_t i = 0; i < list->size() && !found; ++i) {
+      found = StructureNaNFinder::IsNaN(list->at(i));
+    }
+  } else if (UDictObj *dict = obj->as<UDictObj>()) {
+    for (auto &kv : *dict) {
+      found = found || StructureNaNFinder::IsNaN(kv.first) || StructureNaNFinder::IsNaN(kv.second);
+    }
+  } else if (PersistentListObj *list = obj->as<PersistentListObj>()) {
+    list->ForEach([&found](const Any &elem) { found = found || StructureNaNFinder::IsNaN(elem); });
+  } else if (TypedListObj *list = obj->as<TypedListObj>()) {
+    if (list->elem_type_index() == kMLCFloat) {
+      const double *data = list->data_as<double>();
+      found = std::any_of(data, data + list->size(), [](double v) { return std::isnan(v); });
+    }
+  } else if (obj->GetTypeIndex() >= kMLCDynObjectBegin) {
+    MLCTypeInfo *type_info = Lib::GetTypeInfo(obj->GetTypeIndex());
+    if (type_info->structure_kind != 0) {
+      VisitStructure(obj, type_info, StructureNaNFinder{&found});
+    }
+  }
+  return found;
+}
+
+// Returns whether no variable or NaN is reachable from `root`, in which case it is structurally equal to itself
+// however variables are bound. Functions, errors, opaque objects and types without a defined structure count as
+// variables, as comparing them may fail or call back into the frontend. Results for all objects visited are kept in
+// `memo`.
+inline bool IsClosedSubtree(Object *root, std::unordered_map<Object *, bool> *memo) {
+  // Appends the children of `obj`, or returns false if it is a leaf
+  auto collect = [](Object *obj, std::vector<Object *> *children) -> bool {
+    int32_t type_index = obj->GetTypeIndex();
+    if (obj->IsInstance<UDictObj>()) {
+      for (auto &kv : *reinterpret_cast<UDictObj *>(obj)) {
+        children->push_back(StructureChildCollector::AsObject(kv.first));
+        children->push_back(StructureChildCollector::AsObject(kv.second));
+      }
+      return true;
+    } else if (type_index >= kMLCDynObjectBegin) {
+      StructureKind kind = static_cast<StructureKind>(Lib::GetTypeInfo(type_index)->structure_kind);
+      if (kind == StructureKind::kVar || kind == StructureKind::kBind) {
+        return false;
+      }
+    }
+    return CollectStructureChildren(obj, children);
+  };
+  std::vector<std::pair<Object *, bool>> stack{{root, false}}; // (object, whether its children are on the stack)
+  std::vector<Object *> children;
+  while (!stack.empty()) {
+    auto [obj, expanded] = stack.back();
+    if (memo->count(obj)) {
+      stack.pop_back();
+      continue;
+    }
+    children.clear();
+    if (!collect(obj, &children)) {
+      int32_t type_index = obj->GetTypeIndex();
+      bool is_value = type_index == kMLCStr || type_index == kMLCTensor || type_index == kMLCTypedList;
+      (*memo)[obj] = is_value && !HoldsNaN(obj);
+      stack.pop_back();
+    } else if (!expanded) {
+      stack.back().second = true;
+      for (Object *child : children) {
+        if (child != nullptr && !memo->count(child)) {
+          stack.emplace_back(child, false);
+        }
+      }
+    } else {
+      bool closed = !HoldsNaN(obj);
+      for (Object *child : children) {
+        if (child != nullptr && !memo->at(child)) {
+          closed = false;
+          break;
+        }
+      }
+      (*memo)[obj] = closed;
+      stack.pop_back();
+    }
+  }
+  return memo->at(root);
+}
+
+// The path to a task of a traversal, recorded as the last step from the task it was enqueued by, which stays on the
+// stack until all of its children are done. Unlike `ObjectPath`, it allocates nothing, and the traversal materializes
+// it only to report an error. Field names are raw strings, whose `AnyView` does not allocate either.
+struct LazyPath {
+  int64_t parent; // index of the parent task on the stack, or -1 for the root
+  int32_t kind;   // same as `ObjectPathObj::kind`
+  AnyView key;
+
+  static LazyPath Root() { return LazyPath{-1, -1, AnyView()}; }
+  static LazyPath Field(int64_t parent, const char *field_name) { return LazyPath{parent, 0, AnyView(field_name)}; }
+  static LazyPath ListIndex(int64_t parent, int64_t list_index) { return LazyPath{parent, 1, AnyView(list_index)}; }
+  static LazyPath DictKey(int64_t parent, AnyView dict_key) { return LazyPath{parent, 2, dict_key}; }
+
+  // Materializes the path, where `task_path(i)` returns the path of the i-th task on the stack
+  template <typename FTaskPath> ObjectPath Materialize(FTaskPath task_path) const {
+    std::vector<const LazyPath *> steps;
+    for (const LazyPath *p = this; p->kind != -1; p = &task_path(p->parent)) {
+      steps.push_back(p);
+    }
+    ObjectPath ret = ObjectPath::Root();
+    for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+      const LazyPath *p = *it;
+      if (p->kind == 0) {
+        ret = ret->WithField(p->key.v.v_str);
+      } else if (p->kind == 1) {
+        ret = ret->WithListIndex(p->key.v.v_int64);
+      } else {
+        ret = ret->WithDictKey(Any(p->key));
+      }
+    }
+    return ret;
+  }
+};
+
+// Without `state->report`, a mismatch is recorded in `state->failed` rather than formatted and thrown
+#define MLC_CORE_EQ_S_FAIL(MSG, PATH)                                                                                  \
   {                                                                                                                    \
+    if (!state->report) {                                                                                              \
+      state->failed = true;                                                                                            \
+      return;                                                                                                          \
+    }                                                                                                                  \
     std::ostringstream err;                                                                                            \
-    err << (LHS) << " vs " << (RHS);                                                                                   \
+    err << MSG;                                                                                                        \
     throw SEqualError(err.str().c_str(), (PATH));                                                                      \
   }
+#define MLC_CORE_EQ_S_ERR(LHS, RHS, PATH) MLC_CORE_EQ_S_FAIL((LHS) << " vs " << (RHS), PATH)
 #define MLC_CORE_EQ_S_ANY(Cond, Type, EQ, LHS, RHS, PATH)                                                              \
   if (Cond) {                                                                                                          \
     Type lhs_value = LHS->operator Type();                                                                             \
@@ -389,7 +950,7 @@ template <typename T> MLC_INLINE T *WithOffset(Object *obj, MLCTypeField *field)
     if (EQ(lhs_value, rhs_value)) {                                                                                    \
       return;                                                                                                          \
     } else {                                                                                                           \
-      MLC_CORE_EQ_S_ERR(*lhs, *rhs, PATH);                                                                             \
+      MLC_CORE_EQ_S_ERR(*lhs, *rhs, state->Path(PATH));                                                                \
     }                                                                                                                  \
   }
 #define MLC_CORE_EQ_S_OPT(Type, EQ)                                                                                    \
@@ -399,18 +960,41 @@ template <typename T> MLC_INLINE T *WithOffset(Object *obj, MLCTypeField *field)
     if ((lhs != nullptr || rhs != nullptr) && (lhs == nullptr || rhs == nullptr || !EQ(*lhs, *rhs))) {                 \
       AnyView LHS = lhs ? AnyView(*lhs) : AnyView(nullptr);                                                            \
       AnyView RHS = rhs ? AnyView(*rhs) : AnyView(nullptr);                                                            \
-      MLC_CORE_EQ_S_ERR(LHS, RHS, path->WithField(field->name));                                                       \
+      MLC_CORE_EQ_S_ERR(LHS, RHS, FieldPath(field));                                                                   \
     }                                                                                                                  \
   }
 #define MLC_CORE_EQ_S_POD(Type, EQ)                                                                                    \
   MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind, Type *lhs) {                                     \
     const Type *rhs = WithOffset<Type>(obj_rhs, field);                                                                \
     if (!EQ(*lhs, *rhs)) {                                                                                             \
-      MLC_CORE_EQ_S_ERR(AnyView(*lhs), AnyView(*rhs), path->WithField(field->name));                                   \
+      MLC_CORE_EQ_S_ERR(AnyView(*lhs), AnyView(*rhs), FieldPath(field));                                               \
     }                                                                                                                  \
   }
 
-inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
+// Returns the index of the first element in [0, size) where `lhs` and `rhs` differ, or `size` if there is none
+template <typename T, typename FEqual>
+inline int64_t TypedListMismatch(const TypedListObj *lhs, const TypedListObj *rhs, int64_t size, FEqual eq) {
+  const T *lhs_data = lhs->data_as<T>();
+  const T *rhs_data = rhs->data_as<T>();
+  for (int64_t i = 0; i < size; ++i) {
+    if (!eq(lhs_data[i], rhs_data[i])) {
+      return i;
+    }
+  }
+  return size;
+}
+
+// Returns whether `lhs` and `rhs` are structurally equal. With `report`, a mismatch throws `SEqualError` with a message
+// and the path to it. Otherwise, it returns false without formatting or throwing anything, which is the fast path for
+// uses where mismatches are common, e.g. the key equality of hash maps. Either way, paths are recorded as `LazyPath`
+// and only materialized into `ObjectPath` on error, so a successful comparison allocates no paths.
+//
+// Shared subtrees are compared once per pair of objects, so that DAGs with heavy sharing, e.g. expressions after common
+// subexpression elimination, take time linear in the number of objects rather than paths. Identical subtrees are
+// skipped if they are closed, i.e. contain no variables, as otherwise comparing them may still bind variables or find
+// an inconsistent binding.
+inline bool StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars, bool report,
+                                const ProvenEqualPairs *proven = nullptr, const std::atomic<bool> *cancel = nullptr) {
   using CharArray = const char *;
   using VoidPtr = ::mlc::base::VoidPtr;
   using mlc::base::DeviceEqual;
@@ -421,13 +1005,25 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     MLCTypeInfo *type_info;
     bool visited;
     bool bind_free_vars; // `map_free_vars` in TVM
-    ObjectPath path;
+    LazyPath path;
     std::unique_ptr<std::ostringstream> err;
   };
+  struct State {
+    ObjectPath Path(const LazyPath &path) const {
+      return path.Materialize([this](int64_t i) -> const LazyPath & { return tasks[i].path; });
+    }
+    std::vector<Task> tasks;
+    bool report;
+    bool failed;
+    // Pairs of shared objects proven equal, so that each pair in a DAG is compared once rather than once per path
+    std::unordered_set<ObjectPair, ObjectPairHash> proven_pairs;
+    std::unordered_map<Object *, bool> closed;
+  };
   struct Visitor {
     static bool CharArrayEqual(CharArray lhs, CharArray rhs) { return std::strcmp(lhs, rhs) == 0; }
     static bool FloatEqual(float lhs, float rhs) { return std::abs(lhs - rhs) < 1e-6; }
     static bool DoubleEqual(double lhs, double rhs) { return std::abs(lhs - rhs) < 1e-8; }
+    ObjectPath FieldPath(MLCTypeField *field) const { return state->Path(LazyPath::Field(parent, field->name)); }
     MLC_CORE_EQ_S_OPT(bool, std::equal_to<bool>());
     MLC_CORE_EQ_S_OPT(int64_t, std::equal_to<int64_t>());
     MLC_CORE_EQ_S_OPT(double, DoubleEqual);
@@ -448,7 +1044,7 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind field_kind, const Any *lhs) {
       const Any *rhs = WithOffset<Any>(obj_rhs, field);
       bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
-      EnqueueAny(tasks, bind_free_vars, lhs, rhs, path->WithField(field->name));
+      EnqueueAny(state, bind_free_vars, lhs, rhs, LazyPath::Field(parent, field->name));
     }
     MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind field_kind, ObjectRef *_lhs) {
       HandleObject(field, field_kind, _lhs->get(), WithOffset<ObjectRef>(obj_rhs, field)->get());
@@ -459,37 +1055,65 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     inline void HandleObject(MLCTypeField *field, StructureFieldKind field_kind, Object *lhs, Object *rhs) {
       if (lhs || rhs) {
         bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
-        EnqueueTask(tasks, bind_free_vars, lhs, rhs, path->WithField(field->name));
+        EnqueueTask(state, bind_free_vars, lhs, rhs, LazyPath::Field(parent, field->name));
       }
     }
-    static void CheckShapeEqual(const int64_t *lhs, const int64_t *rhs, int32_t ndim, const ObjectPath &path) {
+    static void CheckShapeEqual(State *state, const int64_t *lhs, const int64_t *rhs, int32_t ndim,
+                                const LazyPath &path) {
       for (int32_t i = 0; i < ndim; ++i) {
         if (lhs[i] != rhs[i]) {
           UList lhs_list{lhs, lhs + ndim};
           UList rhs_list{rhs, rhs + ndim};
-          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, path->WithField("shape"));
+          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, state->Path(path)->WithField("shape"));
         }
       }
     }
-    static void CheckStridesEqual(const int64_t *lhs, const int64_t *rhs, int32_t ndim, const ObjectPath &path) {
+    static void CheckTypedListEqual(State *state, const TypedListObj *lhs, const TypedListObj *rhs,
+                                    const LazyPath &path) {
+      int32_t elem_type_index = lhs->elem_type_index();
+      if (elem_type_index != rhs->elem_type_index()) {
+        MLC_CORE_EQ_S_ERR(Lib::GetTypeKey(elem_type_index), Lib::GetTypeKey(rhs->elem_type_index()),
+                          state->Path(path)->WithField("elem_type_index"));
+      }
+      int64_t lhs_size = lhs->size();
+      int64_t rhs_size = rhs->size();
+      int64_t size = lhs_size < rhs_size ? lhs_size : rhs_size;
+      int64_t i = size;
+      if (elem_type_index == kMLCBool) {
+        i = TypedListMismatch<bool>(lhs, rhs, size, std::equal_to<bool>());
+      } else if (elem_type_index == kMLCInt) {
+        i = TypedListMismatch<int64_t>(lhs, rhs, size, std::equal_to<int64_t>());
+      } else if (elem_type_index == kMLCFloat) {
+        i = TypedListMismatch<double>(lhs, rhs, size, DoubleEqual);
+      } else if (elem_type_index == kMLCDataType) {
+        i = TypedListMismatch<DLDataType>(lhs, rhs, size, DType::Equal);
+      }
+      if (i < size) {
+        MLC_CORE_EQ_S_ERR(lhs->at(i), rhs->at(i), state->Path(path)->WithListIndex(i));
+      }
+      if (lhs_size != rhs_size) {
+        MLC_CORE_EQ_S_FAIL("List length mismatch: " << lhs_size << " vs " << rhs_size, state->Path(path));
+      }
+    }
+    static void CheckStridesEqual(State *state, const int64_t *lhs, const int64_t *rhs, int32_t ndim,
+                                  const LazyPath &path) {
       if ((lhs == nullptr) != (rhs == nullptr)) {
         Any lhs_list = lhs ? Any(UList(lhs, lhs + ndim)) : Any();
         Any rhs_list = rhs ? Any(UList(rhs, rhs + ndim)) : Any();
-        MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, path->WithField("strides"));
+        MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, state->Path(path)->WithField("strides"));
       }
       for (int32_t i = 0; i < ndim; ++i) {
         if (lhs[i] != rhs[i]) {
           UList lhs_list{lhs, lhs + ndim};
           UList rhs_list{rhs, rhs + ndim};
-          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, path->WithField("strides"));
+          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, state->Path(path)->WithField("strides"));
         }
       }
     }
-    static void EnqueueAny(std::vector<Task> *tasks, bool bind_free_vars, const Any *lhs, const Any *rhs,
-                           ObjectPath new_path) {
+    static void EnqueueAny(State *state, bool bind_free_vars, const Any *lhs, const Any *rhs, LazyPath new_path) {
       int32_t type_index = lhs->GetTypeIndex();
       if (type_index != rhs->GetTypeIndex()) {
-        MLC_CORE_EQ_S_ERR(lhs->GetTypeKey(), rhs->GetTypeKey(), new_path);
+        MLC_CORE_EQ_S_ERR(lhs->GetTypeKey(), rhs->GetTypeKey(), state->Path(new_path));
       }
       if (type_index == kMLCNone) {
         return;
@@ -504,75 +1128,93 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
       if (type_index < kMLCStaticObjectBegin) {
         MLC_THROW(InternalError) << "Unknown type key: " << lhs->GetTypeKey();
       }
-      EnqueueTask(tasks, bind_free_vars, lhs->operator Object *(), rhs->operator Object *(), new_path);
+      EnqueueTask(state, bind_free_vars, lhs->operator Object *(), rhs->operator Object *(), new_path);
     }
-    static void EnqueueTask(std::vector<Task> *tasks, bool bind_free_vars, Object *lhs, Object *rhs,
-                            ObjectPath new_path) {
+    static void EnqueueTask(State *state, bool bind_free_vars, Object *lhs, Object *rhs, LazyPath new_path) {
       int32_t lhs_type_index = lhs ? lhs->GetTypeIndex() : kMLCNone;
       int32_t rhs_type_index = rhs ? rhs->GetTypeIndex() : kMLCNone;
       if (lhs_type_index != rhs_type_index) {
-        MLC_CORE_EQ_S_ERR(Lib::GetTypeKey(lhs_type_index), Lib::GetTypeKey(rhs_type_index), new_path);
+        MLC_CORE_EQ_S_ERR(Lib::GetTypeKey(lhs_type_index), Lib::GetTypeKey(rhs_type_index),
+                          state->Path(new_path));
       } else if (lhs_type_index == kMLCStr) {
-        Str lhs_str(reinterpret_cast<StrObj *>(lhs));
-        Str rhs_str(reinterpret_cast<StrObj *>(rhs));
-        if (lhs_str != rhs_str) {
-          MLC_CORE_EQ_S_ERR(lhs_str, rhs_str, new_path);
+        // Interned strings are equal iff they are the same object
+        if (lhs != rhs) {
+          Str lhs_str(reinterpret_cast<StrObj *>(lhs));
+          Str rhs_str(reinterpret_cast<StrObj *>(rhs));
+          if ((lhs_str->IsInterned() && rhs_str->IsInterned()) || lhs_str != rhs_str) {
+            MLC_CORE_EQ_S_ERR(lhs_str, rhs_str, state->Path(new_path));
+          }
         }
       } else if (lhs_type_index == kMLCTensor) {
         DLTensor *lhs_tensor = &lhs->DynCast<TensorObj>()->tensor;
         DLTensor *rhs_tensor = &rhs->DynCast<TensorObj>()->tensor;
         int32_t ndim = lhs_tensor->ndim;
         if (ndim != rhs_tensor->ndim) {
-          MLC_CORE_EQ_S_ERR(lhs_tensor->ndim, rhs_tensor->ndim, new_path->WithField("ndim"));
+          MLC_CORE_EQ_S_ERR(lhs_tensor->ndim, rhs_tensor->ndim, state->Path(new_path)->WithField("ndim"));
         }
         if (lhs_tensor->byte_offset != rhs_tensor->byte_offset) {
-          MLC_CORE_EQ_S_ERR(lhs_tensor->byte_offset, rhs_tensor->byte_offset, new_path->WithField("byte_offset"));
+          MLC_CORE_EQ_S_ERR(lhs_tensor->byte_offset, rhs_tensor->byte_offset,
+                            state->Path(new_path)->WithField("byte_offset"));
         }
         if (!::mlc::base::DType::Equal(lhs_tensor->dtype, rhs_tensor->dtype)) {
-          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->dtype), AnyView(rhs_tensor->dtype), new_path->WithField("dtype"));
+          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->dtype), AnyView(rhs_tensor->dtype),
+                            state->Path(new_path)->WithField("dtype"));
         }
         if (!::mlc::base::DeviceEqual(lhs_tensor->device, rhs_tensor->device)) {
-          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->device), AnyView(rhs_tensor->device), new_path->WithField("device"));
+          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->device), AnyView(rhs_tensor->device),
+                            state->Path(new_path)->WithField("device"));
         }
-        CheckShapeEqual(lhs_tensor->shape, rhs_tensor->shape, ndim, new_path);
-        CheckStridesEqual(lhs_tensor->strides, rhs_tensor->strides, ndim, new_path);
+        CheckShapeEqual(state, lhs_tensor->shape, rhs_tensor->shape, ndim, new_path);
+        CheckStridesEqual(state, lhs_tensor->strides, rhs_tensor->strides, ndim, new_path);
+      } else if (lhs_type_index == kMLCTypedList) {
+        CheckTypedListEqual(state, reinterpret_cast<TypedListObj *>(lhs), reinterpret_cast<TypedListObj *>(rhs),
+                            new_path);
       } else if (lhs_type_index == kMLCFunc || lhs_type_index == kMLCError) {
-        throw SEqualError("Cannot compare `mlc.Func` or `mlc.Error`", new_path);
+        MLC_CORE_EQ_S_FAIL("Cannot compare `mlc.Func` or `mlc.Error`", state->Path(new_path));
       } else if (lhs_type_index == kMLCOpaque) {
         std::string func_name = "Opaque.eq_s.";
         func_name += lhs->DynCast<OpaqueObj>()->opaque_type_name;
         FuncObj *func = Func::GetGlobal(func_name.c_str(), true);
         if (func == nullptr) {
-          std::ostringstream err;
-          err << "Cannot compare `mlc.Opaque` of type: " << lhs->DynCast<OpaqueObj>()->opaque_type_name << "; Use "
-              << "`mlc.Func.register(\"" << func_name << "\")(eq_s_func)` to register a comparison method";
-          throw SEqualError(err.str().c_str(), new_path);
+          MLC_CORE_EQ_S_FAIL("Cannot compare `mlc.Opaque` of type: "
+                                 << lhs->DynCast<OpaqueObj>()->opaque_type_name << "; Use `mlc.Func.register(\""
+                                 << func_name << "\")(eq_s_func)` to register a comparison method",
+                             state->Path(new_path));
         }
         Any result = (*func)(lhs, rhs);
         if (result.type_index != kMLCBool) {
-          std::ostringstream err;
-          err << "Comparison function `" << func_name << "` must return a boolean value, but got: " << result;
-          throw SEqualError(err.str().c_str(), new_path);
+          MLC_CORE_EQ_S_FAIL("Comparison function `" << func_name << "` must return a boolean value, but got: "
+                                                     << result,
+                             state->Path(new_path));
         }
         if (result.operator bool() == false) {
-          MLC_CORE_EQ_S_ERR(lhs, rhs, new_path);
+          MLC_CORE_EQ_S_ERR(lhs, rhs, state->Path(new_path));
         }
+      } else if (lhs == rhs && IsClosedSubtree(lhs, &state->closed)) {
+        // An identical subtree is equal to itself unless it contains variables, which may be bound to others
       } else {
         bool visited = false;
         MLCTypeInfo *type_info = Lib::GetTypeInfo(lhs_type_index);
-        tasks->push_back(Task{lhs, rhs, type_info, visited, bind_free_vars, new_path, nullptr});
+        state->tasks.push_back(Task{lhs, rhs, type_info, visited, bind_free_vars, new_path, nullptr});
       }
     }
     Object *obj_rhs;
-    std::vector<Task> *tasks;
+    State *state;
     bool obj_bind_free_vars;
-    ObjectPath path;
+    int64_t parent;
   };
-  std::vector<Task> tasks;
+  State state{{}, report, false, {}, {}};
+  // Only objects referenced more than once can be reached along multiple paths
+  auto is_shared = [](Object *obj) -> bool {
+    int32_t ref_cnt = ::mlc::base::RefCount(reinterpret_cast<MLCAny *>(obj));
+    return ref_cnt > 1 || ref_cnt < 0;
+  };
+  std::vector<Task> &tasks = state.tasks;
   std::unordered_map<Object *, Object *> eq_lhs_to_rhs;
   std::unordered_map<Object *, Object *> eq_rhs_to_lhs;
 
-  auto check_bind = [&eq_lhs_to_rhs, &eq_rhs_to_lhs](Object *lhs, Object *rhs, const ObjectPath &path) -> bool {
+  // Returns whether `lhs` and `rhs` are bound to each other, or sets `err` if either is bound to a different node
+  auto check_bind = [&eq_lhs_to_rhs, &eq_rhs_to_lhs](Object *lhs, Object *rhs, const char **err) -> bool {
     // check binding consistency: lhs -> rhs, rhs -> lhs
     auto it_lhs_to_rhs = eq_lhs_to_rhs.find(lhs);
     auto it_rhs_to_lhs = eq_rhs_to_lhs.find(rhs);
@@ -583,22 +1225,28 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
       if (it_lhs_to_rhs->second == rhs && it_rhs_to_lhs->second == lhs) {
         return true;
       }
-      throw SEqualError("Inconsistent binding: LHS and RHS are both bound, but to different nodes", path);
-    }
-    // inconsistent binding
-    if (exist_lhs_to_rhs) {
-      throw SEqualError("Inconsistent binding. LHS has been bound to a different node while RHS is not bound", path);
-    }
-    if (exist_rhs_to_lhs) {
-      throw SEqualError("Inconsistent binding. RHS has been bound to a different node while LHS is not bound", path);
+      *err = "Inconsistent binding: LHS and RHS are both bound, but to different nodes";
+    } else if (exist_lhs_to_rhs) {
+      // inconsistent binding
+      *err = "Inconsistent binding. LHS has been bound to a different node while RHS is not bound";
+    } else if (exist_rhs_to_lhs) {
+      *err = "Inconsistent binding. RHS has been bound to a different node while LHS is not bound";
     }
     return false;
   };
 
-  Visitor::EnqueueTask(&tasks, bind_free_vars, lhs, rhs, ObjectPath::Root());
+  Visitor::EnqueueTask(&state, bind_free_vars, lhs, rhs, LazyPath::Root());
   while (!tasks.empty()) {
     MLCTypeInfo *type_info;
-    ObjectPath path{::mlc::Null};
+    LazyPath path = LazyPath::Root();
+    if (state.failed) {
+      return false;
+    } else if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+      if (!report) {
+        return false;
+      }
+      throw SEqualError("Cancelled", ObjectPath::Root());
+    }
     {
       Task &task = tasks.back();
       type_info = task.type_info;
@@ -606,9 +1254,19 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
       lhs = task.lhs;
       rhs = task.rhs;
       bind_free_vars = task.bind_free_vars;
+      const char *bind_err = nullptr;
       if (task.err) {
-        throw SEqualError(task.err->str().c_str(), path);
-      } else if (check_bind(lhs, rhs, path)) {
+        throw SEqualError(task.err->str().c_str(), state.Path(path));
+      } else if (check_bind(lhs, rhs, &bind_err)) {
+        tasks.pop_back();
+        continue;
+      } else if (bind_err != nullptr) {
+        if (!report) {
+          return false;
+        }
+        throw SEqualError(bind_err, state.Path(path));
+      } else if (!task.visited && ((proven != nullptr && proven->Contains(lhs, rhs)) ||
+                                   (is_shared(lhs) && state.proven_pairs.count(ObjectPair(lhs, rhs))))) {
         tasks.pop_back();
         continue;
       } else if (task.visited) {
@@ -618,7 +1276,12 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
           eq_lhs_to_rhs[lhs] = rhs;
           eq_rhs_to_lhs[rhs] = lhs;
         } else if (kind == StructureKind::kVar && !bind_free_vars) {
-          throw SEqualError("Unbound variable", path);
+          if (!report) {
+            return false;
+          }
+          throw SEqualError("Unbound variable", state.Path(path));
+        } else if (is_shared(lhs)) {
+          state.proven_pairs.emplace(lhs, rhs);
         }
         tasks.pop_back();
         continue;
@@ -632,8 +1295,12 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
       UListObj *rhs_list = reinterpret_cast<UListObj *>(rhs);
       int64_t lhs_size = lhs_list->size();
       int64_t rhs_size = rhs_list->size();
+      if (lhs_size != rhs_size && !report) {
+        return false;
+      }
       for (int64_t i = (lhs_size < rhs_size ? lhs_size : rhs_size) - 1; i >= 0; --i) {
-        Visitor::EnqueueAny(&tasks, bind_free_vars, &lhs_list->at(i), &rhs_list->at(i), path->WithListIndex(i));
+        Visitor::EnqueueAny(&state, bind_free_vars, &lhs_list->at(i), &rhs_list->at(i),
+                            LazyPath::ListIndex(task_index, i));
       }
       if (lhs_size != rhs_size) {
         auto &err = tasks[task_index].err = std::make_unique<std::ostringstream>();
@@ -642,6 +1309,9 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     } else if (lhs->IsInstance<UDictObj>()) {
       UDictObj *lhs_dict = reinterpret_cast<UDictObj *>(lhs);
       UDictObj *rhs_dict = reinterpret_cast<UDictObj *>(rhs);
+      if (lhs_dict->size() != rhs_dict->size() && !report) {
+        return false;
+      }
       std::vector<AnyView> not_found_lhs_keys;
       for (auto &kv : *lhs_dict) {
         AnyView lhs_key = kv.first;
@@ -659,7 +1329,62 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
           not_found_lhs_keys.push_back(lhs_key);
           continue;
         }
-        Visitor::EnqueueAny(&tasks, bind_free_vars, &kv.second, &rhs_it->second, path->WithDictKey(lhs_key));
+        Visitor::EnqueueAny(&state, bind_free_vars, &kv.second, &rhs_it->second,
+                            LazyPath::DictKey(task_index, lhs_key));
+      }
+      if (!not_found_lhs_keys.empty() && !report) {
+        return false;
+      }
+      auto &err = tasks[task_index].err;
+      if (!not_found_lhs_keys.empty()) {
+        err = std::make_unique<std::ostringstream>();
+        (*err) << "Dict key(s) not found in rhs: " << not_found_lhs_keys[0];
+        for (size_t i = 1; i < not_found_lhs_keys.size(); ++i) {
+          (*err) << ", " << not_found_lhs_keys[i];
+        }
+      } else if (lhs_dict->size() != rhs_dict->size()) {
+        err = std::make_unique<std::ostringstream>();
+        (*err) << "Dict size mismatch: " << lhs_dict->size() << " vs " << rhs_dict->size();
+      }
+    } else if (lhs->IsInstance<PersistentListObj>()) {
+      std::vector<const Any *> lhs_elems, rhs_elems;
+      reinterpret_cast<PersistentListObj *>(lhs)->ForEach([&](const Any &elem) { lhs_elems.push_back(&elem); });
+      reinterpret_cast<PersistentListObj *>(rhs)->ForEach([&](const Any &elem) { rhs_elems.push_back(&elem); });
+      int64_t lhs_size = static_cast<int64_t>(lhs_elems.size());
+      int64_t rhs_size = static_cast<int64_t>(rhs_elems.size());
+      if (lhs_size != rhs_size && !report) {
+        return false;
+      }
+      for (int64_t i = (lhs_size < rhs_size ? lhs_size : rhs_size) - 1; i >= 0; --i) {
+        Visitor::EnqueueAny(&state, bind_free_vars, lhs_elems[i], rhs_elems[i], LazyPath::ListIndex(task_index, i));
+      }
+      if (lhs_size != rhs_size) {
+        auto &err = tasks[task_index].err = std::make_unique<std::ostringstream>();
+        (*err) << "List length mismatch: " << lhs_size << " vs " << rhs_size;
+      }
+    } else if (lhs->IsInstance<PersistentDictObj>()) {
+      PersistentDictObj *lhs_dict = reinterpret_cast<PersistentDictObj *>(lhs);
+      PersistentDictObj *rhs_dict = reinterpret_cast<PersistentDictObj *>(rhs);
+      if (lhs_dict->size() != rhs_dict->size() && !report) {
+        return false;
+      }
+      std::vector<AnyView> not_found_lhs_keys;
+      lhs_dict->ForEach([&](const Any &lhs_key, const Any &lhs_value) {
+        int32_t type_index = lhs_key.type_index;
+        const Any *rhs_value = nullptr;
+        if (type_index < kMLCStaticObjectBegin || type_index == kMLCStr) {
+          rhs_value = rhs_dict->find(lhs_key);
+        } else if (auto it = eq_lhs_to_rhs.find(lhs_key.operator Object *()); it != eq_lhs_to_rhs.end()) {
+          rhs_value = rhs_dict->find(Any(it->second));
+        }
+        if (rhs_value == nullptr) {
+          not_found_lhs_keys.push_back(lhs_key);
+          return;
+        }
+        Visitor::EnqueueAny(&state, bind_free_vars, &lhs_value, rhs_value, LazyPath::DictKey(task_index, lhs_key));
+      });
+      if (!not_found_lhs_keys.empty() && !report) {
+        return false;
       }
       auto &err = tasks[task_index].err;
       if (!not_found_lhs_keys.empty()) {
@@ -673,9 +1398,10 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
         (*err) << "Dict size mismatch: " << lhs_dict->size() << " vs " << rhs_dict->size();
       }
     } else {
-      VisitStructure(lhs, type_info, Visitor{rhs, &tasks, bind_free_vars, path});
+      VisitStructure(lhs, type_info, Visitor{rhs, &state, bind_free_vars, task_index});
     }
   }
+  return !state.failed;
 }
 
 /****************** Structural Hash ******************/
@@ -708,6 +1434,7 @@ struct HashCache {
   inline static const uint64_t MLC_SYMBOL_HIDE kRawStr = Lib::GetTypeInfo(kMLCRawStr)->type_key_hash;
   inline static const uint64_t MLC_SYMBOL_HIDE kStrObj = Lib::GetTypeInfo(kMLCStr)->type_key_hash;
   inline static const uint64_t MLC_SYMBOL_HIDE kTensorObj = Lib::GetTypeInfo(kMLCTensor)->type_key_hash;
+  inline static const uint64_t MLC_SYMBOL_HIDE kTypedListObj = Lib::GetTypeInfo(kMLCTypedList)->type_key_hash;
   inline static const uint64_t MLC_SYMBOL_HIDE kBound = ::mlc::base::StrHash("$$Bounds$$");
   inline static const uint64_t MLC_SYMBOL_HIDE kUnbound = ::mlc::base::StrHash("$$Unbound$$");
 };
@@ -722,17 +1449,80 @@ template <typename T> MLC_INLINE uint64_t HashTyped(uint64_t type_hash, T value)
   return ::mlc::base::HashCombine(type_hash, u.tgt);
 }
 
-inline uint64_t StructuralHashImpl(Object *obj) {
-  using CharArray = const char *;
-  using VoidPtr = ::mlc::base::VoidPtr;
-  using mlc::base::HashCombine;
-  struct Task {
-    Object *obj;
-    MLCTypeInfo *type_info;
+// Whether the structural hash of `obj` stays valid as long as `obj` is alive, see `StructuralHashCacheObj`
+inline bool IsHashImmutable(Object *obj, MLCTypeInfo *type_info, bool assume_immutable) {
+  if (assume_immutable || obj->IsInstance<PersistentListObj>() || obj->IsInstance<PersistentDictObj>()) {
+    return true;
+  } else if (obj->IsInstance<UListObj>()) {
+    return reinterpret_cast<MLCList *>(obj)->frozen != 0;
+  } else if (obj->IsInstance<UDictObj>()) {
+    return reinterpret_cast<MLCDict *>(obj)->frozen != 0;
+  }
+  for (MLCTypeField *field = type_info->fields; field->name != nullptr; ++field) {
+    if (!field->frozen) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Hashes of subtrees that `StructuralHashImpl` reuses and records. Only subtrees whose hashes do not depend on the
+// rest of the graph are recorded, see `StructuralHashCacheObj`
+struct HashMemo {
+  virtual ~HashMemo() = default;
+  virtual bool Find(Object *obj, uint64_t *hash_value) = 0;
+  virtual void Record(Object *obj, uint64_t hash_value) = 0;
+  // Whether objects may be treated as immutable for the duration of the memo
+  bool assume_immutable = false;
+  // Whether to fail instead of calling back into the frontend, for memos filled off the main thread
+  bool no_callbacks = false;
+  // Set if any dict keyed by objects is hashed, whose hash depends on which keys are recorded
+  bool has_object_keyed_dict = false;
+  // Set if a key of such a dict is not bound before the dict, which happens if it is only inside a reused subtree
+  bool has_unbound_object_key = false;
+};
+
+struct CacheHashMemo : public HashMemo {
+  explicit CacheHashMemo(StructuralHashCacheObj *cache) : cache(cache) {
+    this->assume_immutable = cache->assume_immutable;
+  }
+  bool Find(Object *obj, uint64_t *hash_value) final {
+    if (!reuse) {
+      return false;
+    }
+    if (auto it = cache->table->find(obj); it != cache->table->end()) {
+      ++num_reused;
+      ++cache->num_hits;
+      *hash_value = static_cast<uint64_t>((*it).second.operator int64_t());
+      return true;
+    }
+    ++cache->num_misses;
+    return false;
+  }
+  void Record(Object *obj, uint64_t hash_value) final {
+    cache->table->operator[](obj) = static_cast<int64_t>(hash_value);
+  }
+  StructuralHashCacheObj *cache;
+  // Whether to reuse the cached hashes, or only record new ones
+  bool reuse = true;
+  int64_t num_reused = 0;
+};
+
+inline uint64_t StructuralHashImpl(Object *obj, HashMemo *memo = nullptr) {
+  using CharArray = const char *;
+  using VoidPtr = ::mlc::base::VoidPtr;
+  using mlc::base::HashCombine;
+  struct Task {
+    Object *obj;
+    MLCTypeInfo *type_info;
     bool visited;
     bool bind_free_vars;
     uint64_t hash_value;
     size_t index_in_result_hashes{0xffffffffffffffff};
+    // Only tracked with a memo: whether the hash of a leaf may change over time, and for objects, the number of
+    // unrecordable tasks finished before it was visited
+    bool is_open{false};
+    int64_t num_open_at_visit{0};
   };
   struct Visitor {
     static uint64_t HashBool(bool a) { return HashTyped<int64_t>(HashCache::kBool, static_cast<int64_t>(a)); }
@@ -764,7 +1554,7 @@ inline uint64_t StructuralHashImpl(Object *obj) {
     MLC_CORE_HASH_S_POD(CharArray, HashCharArray);
     MLC_INLINE void operator()(MLCTypeField *, StructureFieldKind field_kind, const Any *v) {
       bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
-      EnqueueAny(tasks, bind_free_vars, v);
+      EnqueueAny(tasks, bind_free_vars, v, no_callbacks);
     }
     MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind field_kind, ObjectRef *_v) {
       HandleObject(field, field_kind, _v->get());
@@ -774,12 +1564,12 @@ inline uint64_t StructuralHashImpl(Object *obj) {
     }
     inline void HandleObject(MLCTypeField *, StructureFieldKind field_kind, Object *v) {
       bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
-      EnqueueTask(tasks, bind_free_vars, v);
+      EnqueueTask(tasks, bind_free_vars, v, no_callbacks);
     }
-    static void EnqueuePOD(std::vector<Task> *tasks, uint64_t hash_value) {
-      tasks->emplace_back(Task{nullptr, nullptr, false, false, hash_value});
+    static void EnqueuePOD(std::vector<Task> *tasks, uint64_t hash_value, bool is_open = false) {
+      tasks->emplace_back(Task{nullptr, nullptr, false, false, hash_value, 0xffffffffffffffff, is_open});
     }
-    static void EnqueueAny(std::vector<Task> *tasks, bool bind_free_vars, const Any *v) {
+    static void EnqueueAny(std::vector<Task> *tasks, bool bind_free_vars, const Any *v, bool no_callbacks) {
       int32_t type_index = v->GetTypeIndex();
       MLC_CORE_HASH_S_ANY(type_index == kMLCBool, bool, HashBool);
       MLC_CORE_HASH_S_ANY(type_index == kMLCInt, int64_t, HashInteger);
@@ -788,15 +1578,14 @@ inline uint64_t StructuralHashImpl(Object *obj) {
       MLC_CORE_HASH_S_ANY(type_index == kMLCDataType, DLDataType, HashDataType);
       MLC_CORE_HASH_S_ANY(type_index == kMLCDevice, DLDevice, HashDevice);
       MLC_CORE_HASH_S_ANY(type_index == kMLCRawStr, CharArray, HashCharArray);
-      EnqueueTask(tasks, bind_free_vars, v->operator Object *());
+      EnqueueTask(tasks, bind_free_vars, v->operator Object *(), no_callbacks);
     }
-    static void EnqueueTask(std::vector<Task> *tasks, bool bind_free_vars, Object *obj) {
+    static void EnqueueTask(std::vector<Task> *tasks, bool bind_free_vars, Object *obj, bool no_callbacks) {
       int32_t type_index = obj ? obj->GetTypeIndex() : kMLCNone;
       if (type_index == kMLCNone) {
         EnqueuePOD(tasks, HashCache::kNoneCombined);
       } else if (type_index == kMLCStr) {
-        const MLCStr *str = reinterpret_cast<const MLCStr *>(obj);
-        uint64_t hash_value = ::mlc::base::StrHash(str->data, str->length);
+        uint64_t hash_value = reinterpret_cast<const StrObj *>(obj)->Hash();
         hash_value = HashTyped(HashCache::kStrObj, hash_value);
         EnqueuePOD(tasks, hash_value);
       } else if (type_index == kMLCTensor) {
@@ -815,9 +1604,40 @@ inline uint64_t StructuralHashImpl(Object *obj) {
         }
         hash_value = HashTyped(HashCache::kTensorObj, hash_value);
         EnqueuePOD(tasks, hash_value);
+      } else if (type_index == kMLCTypedList) {
+        const TypedListObj *list = reinterpret_cast<const TypedListObj *>(obj);
+        int32_t elem_type_index = list->elem_type_index();
+        int64_t size = list->size();
+        uint64_t hash_value = HashCombine(HashInteger(elem_type_index), HashInteger(size));
+        if (elem_type_index == kMLCBool) {
+          const bool *data = list->data_as<bool>();
+          for (int64_t i = 0; i < size; ++i) {
+            hash_value = HashCombine(hash_value, HashBool(data[i]));
+          }
+        } else if (elem_type_index == kMLCInt) {
+          const int64_t *data = list->data_as<int64_t>();
+          for (int64_t i = 0; i < size; ++i) {
+            hash_value = HashCombine(hash_value, HashInteger(data[i]));
+          }
+        } else if (elem_type_index == kMLCFloat) {
+          const double *data = list->data_as<double>();
+          for (int64_t i = 0; i < size; ++i) {
+            hash_value = HashCombine(hash_value, HashDouble(data[i]));
+          }
+        } else if (elem_type_index == kMLCDataType) {
+          const DLDataType *data = list->data_as<DLDataType>();
+          for (int64_t i = 0; i < size; ++i) {
+            hash_value = HashCombine(hash_value, HashDataType(data[i]));
+          }
+        }
+        hash_value = HashTyped(HashCache::kTypedListObj, hash_value);
+        EnqueuePOD(tasks, hash_value, /*is_open=*/list->MLCTypedList::frozen == 0);
       } else if (type_index == kMLCFunc || type_index == kMLCError) {
         throw SEqualError("Cannot compare `mlc.Func` or `mlc.Error`", ObjectPath::Root());
       } else if (type_index == kMLCOpaque) {
+        if (no_callbacks) {
+          throw SEqualError("Cannot hash `mlc.Opaque` without calling back into the frontend", ObjectPath::Root());
+        }
         std::string func_name = "Opaque.hash_s.";
         func_name += obj->DynCast<OpaqueObj>()->opaque_type_name;
         FuncObj *func = Func::GetGlobal(func_name.c_str(), true);
@@ -832,7 +1652,7 @@ inline uint64_t StructuralHashImpl(Object *obj) {
                                << "` must return an integer value, but got: " << result;
         }
         int64_t hash_value = result.operator int64_t();
-        EnqueuePOD(tasks, hash_value);
+        EnqueuePOD(tasks, hash_value, /*is_open=*/true);
       } else {
         MLCTypeInfo *type_info = Lib::GetTypeInfo(type_index);
         tasks->emplace_back(Task{obj, type_info, false, bind_free_vars, type_info->type_key_hash});
@@ -841,13 +1661,17 @@ inline uint64_t StructuralHashImpl(Object *obj) {
 
     std::vector<Task> *tasks;
     bool obj_bind_free_vars;
+    bool no_callbacks;
   };
+  bool no_callbacks = memo != nullptr && memo->no_callbacks;
   std::vector<Task> tasks;
   std::vector<uint64_t> result_hashes;
   std::unordered_map<Object *, uint64_t> obj2hash;
   int64_t num_bound_nodes = 0;
   int64_t num_unbound_vars = 0;
-  Visitor::EnqueueTask(&tasks, false, obj);
+  int64_t num_open = 0;
+  std::unordered_set<Object *> open_objs;
+  Visitor::EnqueueTask(&tasks, false, obj, no_callbacks);
   while (!tasks.empty()) {
     MLCTypeInfo *type_info;
     bool bind_free_vars;
@@ -875,39 +1699,70 @@ inline uint64_t StructuralHashImpl(Object *obj) {
           hash_value = HashCombine(hash_value, HashCache::kUnbound);
           hash_value = HashCombine(hash_value, num_unbound_vars++);
         }
+        if (memo != nullptr) {
+          // Record the subtree only if no task under it is open, so that its hash does not depend on the context
+          if (task.is_open || num_open != task.num_open_at_visit || kind == StructureKind::kBind ||
+              kind == StructureKind::kVar || !IsHashImmutable(obj, type_info, memo->assume_immutable)) {
+            ++num_open;
+            open_objs.insert(obj);
+          } else {
+            memo->Record(obj, hash_value);
+          }
+        }
         obj2hash[obj] = hash_value;
         result_hashes.push_back(hash_value);
         tasks.pop_back();
         continue;
       } else if (auto it = obj2hash.find(obj); it != obj2hash.end()) {
+        if (memo != nullptr && open_objs.count(obj)) {
+          ++num_open;
+        }
         result_hashes.push_back(it->second);
         tasks.pop_back();
         continue;
       } else if (obj == nullptr) {
+        if (task.is_open && memo != nullptr && !memo->assume_immutable) {
+          ++num_open;
+        }
+        result_hashes.push_back(hash_value);
+        tasks.pop_back();
+        continue;
+      } else if (memo != nullptr && memo->Find(obj, &hash_value)) {
+        obj2hash[obj] = hash_value;
         result_hashes.push_back(hash_value);
         tasks.pop_back();
         continue;
       }
       task.visited = true;
       task.index_in_result_hashes = result_hashes.size();
+      task.num_open_at_visit = num_open;
     }
     // `task.visited` was `False`
     if (obj->IsInstance<UListObj>()) {
       UListObj *list = reinterpret_cast<UListObj *>(obj);
       hash_value = HashCombine(hash_value, list->size());
       for (int64_t i = list->size() - 1; i >= 0; --i) {
-        Visitor::EnqueueAny(&tasks, bind_free_vars, &list->at(i));
+        Visitor::EnqueueAny(&tasks, bind_free_vars, &list->at(i), no_callbacks);
+      }
+    } else if (obj->IsInstance<PersistentListObj>()) {
+      PersistentListObj *list = reinterpret_cast<PersistentListObj *>(obj);
+      hash_value = HashCombine(hash_value, list->size());
+      std::vector<const Any *> elems;
+      elems.reserve(list->size());
+      list->ForEach([&elems](const Any &elem) { elems.push_back(&elem); });
+      for (auto it = elems.rbegin(); it != elems.rend(); ++it) {
+        Visitor::EnqueueAny(&tasks, bind_free_vars, *it, no_callbacks);
       }
-    } else if (obj->IsInstance<UDictObj>()) {
-      UDictObj *dict = reinterpret_cast<UDictObj *>(obj);
-      hash_value = HashCombine(hash_value, dict->size());
+    } else if (obj->IsInstance<UDictObj>() || obj->IsInstance<PersistentDictObj>()) {
       struct KVPair {
         uint64_t hash;
         AnyView key;
         AnyView value;
       };
       std::vector<KVPair> kv_pairs;
-      for (auto &[k, v] : *dict) {
+      // A dict keyed by objects hashes by which keys are already seen elsewhere in the graph
+      bool has_object_keys = false;
+      auto add_pair = [&](const Any &k, const Any &v) {
         uint64_t hash = 0;
         if (k.type_index == kMLCNone) {
           hash = HashCache::kNoneCombined;
@@ -925,17 +1780,34 @@ inline uint64_t StructuralHashImpl(Object *obj) {
           hash = Visitor::HashDevice(k.v.v_device);
         } else if (k.type_index == kMLCStr) {
           const StrObj *str = k;
-          hash = ::mlc::base::StrHash(str->data(), str->length());
+          hash = str->Hash();
           hash = HashTyped(HashCache::kStrObj, hash);
         } else if (k.type_index >= kMLCStaticObjectBegin) {
-          obj = k;
-          if (auto it = obj2hash.find(obj); it != obj2hash.end()) {
+          has_object_keys = true;
+          if (auto it = obj2hash.find(k.operator Object *()); it != obj2hash.end()) {
             hash = it->second;
           } else {
-            continue; // Skip unbound nodes
+            if (memo != nullptr) {
+              memo->has_unbound_object_key = true;
+            }
+            return; // Skip unbound nodes
           }
         }
         kv_pairs.push_back(KVPair{hash, k, v});
+      };
+      if (UDictObj *dict = obj->as<UDictObj>()) {
+        hash_value = HashCombine(hash_value, dict->size());
+        for (auto &[k, v] : *dict) {
+          add_pair(k, v);
+        }
+      } else {
+        PersistentDictObj *pdict = reinterpret_cast<PersistentDictObj *>(obj);
+        hash_value = HashCombine(hash_value, pdict->size());
+        pdict->ForEach(add_pair);
+      }
+      tasks.back().is_open = has_object_keys;
+      if (memo != nullptr && has_object_keys) {
+        memo->has_object_keyed_dict = true;
       }
       std::sort(kv_pairs.begin(), kv_pairs.end(), [](const KVPair &a, const KVPair &b) { return a.hash < b.hash; });
       for (size_t i = 0; i < kv_pairs.size();) {
@@ -947,12 +1819,13 @@ inline uint64_t StructuralHashImpl(Object *obj) {
         if (i + 1 == j) {
           Any k = kv_pairs[i].key;
           Any v = kv_pairs[i].value;
-          Visitor::EnqueueAny(&tasks, bind_free_vars, &k);
-          Visitor::EnqueueAny(&tasks, bind_free_vars, &v);
+          Visitor::EnqueueAny(&tasks, bind_free_vars, &k, no_callbacks);
+          Visitor::EnqueueAny(&tasks, bind_free_vars, &v, no_callbacks);
         }
+        i = j;
       }
     } else {
-      VisitStructure(obj, type_info, Visitor{&tasks, bind_free_vars});
+      VisitStructure(obj, type_info, Visitor{&tasks, bind_free_vars, no_callbacks});
     }
   }
   if (result_hashes.size() != 1) {
@@ -962,10 +1835,246 @@ inline uint64_t StructuralHashImpl(Object *obj) {
   return result_hashes[0];
 }
 
+/****************** Parallel Structural Equal and Hash ******************/
+
+// Runs `fn(thread_id, i)` for every `i` in `[0, n)` on `num_threads` threads including the calling one. Threads pull
+// indices from a shared cursor, so a thread done with a small subtree moves on to the next one. `fn` must not throw.
+template <typename F> inline void ParallelFor(int32_t num_threads, int64_t n, F fn) {
+  std::atomic<int64_t> cursor{0};
+  auto worker = [&cursor, &fn, n](int32_t thread_id) {
+    for (int64_t i = cursor.fetch_add(1); i < n; i = cursor.fetch_add(1)) {
+      fn(thread_id, i);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int32_t thread_id = 1; thread_id < num_threads; ++thread_id) {
+    threads.emplace_back(worker, thread_id);
+  }
+  worker(0);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+inline int32_t NumParallelThreads(int64_t num_threads) {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int64_t>(std::thread::hardware_concurrency());
+  }
+  return static_cast<int32_t>(std::max<int64_t>(num_threads, 1));
+}
+
+// Replaces pairs in `frontier` by their children breadth-first until there are at least `target` of them. Pairs whose
+// lhs is already in the frontier are dropped. Returns false if a pair differs in type or number of children, in which
+// case the serial check fails too.
+inline bool ExpandFrontier(std::vector<ObjectPair> *frontier, size_t target) {
+  constexpr int32_t kMaxDepth = 64;
+  std::unordered_set<Object *> seen;
+  std::vector<ObjectPair> next;
+  std::vector<Object *> lhs_children, rhs_children;
+  for (int32_t depth = 0; depth < kMaxDepth && frontier->size() < target; ++depth) {
+    bool expanded = false;
+    next.clear();
+    for (const ObjectPair &pair : *frontier) {
+      if (pair.first->GetTypeIndex() != pair.second->GetTypeIndex()) {
+        return false;
+      }
+      lhs_children.clear();
+      rhs_children.clear();
+      if (!CollectStructureChildren(pair.first, &lhs_children)) {
+        next.push_back(pair);
+        continue;
+      }
+      CollectStructureChildren(pair.second, &rhs_children);
+      if (lhs_children.size() != rhs_children.size()) {
+        return false;
+      }
+      expanded = true;
+      for (size_t i = 0; i < lhs_children.size(); ++i) {
+        if ((lhs_children[i] == nullptr) != (rhs_children[i] == nullptr)) {
+          return false;
+        } else if (lhs_children[i] != nullptr && seen.insert(lhs_children[i]).second) {
+          next.emplace_back(lhs_children[i], rhs_children[i]);
+        }
+      }
+    }
+    frontier->swap(next);
+    if (!expanded) {
+      break;
+    }
+  }
+  return true;
+}
+
+// Memo of a parallel worker. Nothing is mutated while the graph is hashed, and the frontend is never called, as the
+// calling thread holds on to it while waiting for workers
+struct LocalHashMemo : public HashMemo {
+  LocalHashMemo() {
+    this->assume_immutable = true;
+    this->no_callbacks = true;
+  }
+  bool Find(Object *obj, uint64_t *hash_value) final {
+    if (auto it = table.find(obj); it != table.end()) {
+      *hash_value = it->second;
+      return true;
+    }
+    return false;
+  }
+  void Record(Object *obj, uint64_t hash_value) final { table[obj] = hash_value; }
+  std::unordered_map<Object *, uint64_t> table;
+};
+
+// Read-only union of the memos of all workers, for the final serial pass
+struct JoinedHashMemo : public HashMemo {
+  explicit JoinedHashMemo(std::vector<LocalHashMemo> *parts) : parts(parts) { this->assume_immutable = true; }
+  bool Find(Object *obj, uint64_t *hash_value) final {
+    for (LocalHashMemo &part : *parts) {
+      if (part.Find(obj, hash_value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  void Record(Object *, uint64_t) final {}
+  std::vector<LocalHashMemo> *parts;
+};
+
+// Number of subtrees per thread to split the graph into, so that uneven subtrees balance out
+constexpr size_t kParallelSubtreesPerThread = 8;
+
+// Workers hash disjoint subtrees and record the hashes of closed ones, i.e. those without variables, which do not
+// depend on where they appear. The final serial pass reuses them and only walks the rest, so the result is identical
+// to `StructuralHashImpl`. Falls back to the serial hash if a worker meets an opaque object, which needs a callback,
+// a dict keyed by objects, which hashes differently when parts of the graph are skipped, or any error.
+inline uint64_t StructuralHashParallelImpl(Object *root, int32_t num_threads) {
+  std::vector<ObjectPair> frontier;
+  if (num_threads > 1 && root != nullptr) {
+    frontier.emplace_back(root, root);
+    ExpandFrontier(&frontier, num_threads * kParallelSubtreesPerThread);
+  }
+  if (frontier.size() < 2) {
+    return StructuralHashImpl(root);
+  }
+  std::vector<LocalHashMemo> memos(num_threads);
+  std::atomic<bool> failed{false};
+  ParallelFor(num_threads, static_cast<int64_t>(frontier.size()), [&](int32_t thread_id, int64_t i) {
+    if (failed.load(std::memory_order_relaxed)) {
+      return;
+    }
+    try {
+      StructuralHashImpl(frontier[i].first, &memos[thread_id]);
+    } catch (...) {
+      failed.store(true, std::memory_order_relaxed);
+    }
+  });
+  bool fallback = failed.load();
+  for (const LocalHashMemo &memo : memos) {
+    fallback = fallback || memo.has_object_keyed_dict;
+  }
+  if (fallback) {
+    return StructuralHashImpl(root);
+  }
+  JoinedHashMemo joined(&memos);
+  return StructuralHashImpl(root, &joined);
+}
+
+// Finds the closed subtrees under a pair of subtrees by hashing the lhs, proves each of them equal to its rhs
+// counterpart, and descends through the rest by position. Returns false on a mismatch.
+inline bool ProveEqualSubtrees(ObjectPair root, LocalHashMemo *memo, std::unordered_map<Object *, Object *> *proven,
+                               const std::atomic<bool> *cancel) {
+  try {
+    StructuralHashImpl(root.first, memo);
+  } catch (...) {
+    // Subtrees met after the error are not recorded, and are left to the serial pass
+  }
+  std::vector<ObjectPair> stack{root};
+  std::vector<Object *> lhs_children, rhs_children;
+  while (!stack.empty() && !cancel->load(std::memory_order_relaxed)) {
+    auto [lhs, rhs] = stack.back();
+    stack.pop_back();
+    if (lhs->GetTypeIndex() != rhs->GetTypeIndex()) {
+      return false;
+    }
+    if (uint64_t hash_value; memo->Find(lhs, &hash_value)) {
+      bool equal = false;
+      try {
+        equal = StructuralEqualImpl(lhs, rhs, false, /*report=*/false, nullptr, cancel);
+      } catch (...) {
+        continue;
+      }
+      if (!equal) {
+        return cancel->load();
+      }
+      proven->emplace(lhs, rhs);
+      continue;
+    }
+    lhs_children.clear();
+    rhs_children.clear();
+    if (!CollectStructureChildren(lhs, &lhs_children)) {
+      continue;
+    }
+    CollectStructureChildren(rhs, &rhs_children);
+    if (lhs_children.size() != rhs_children.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < lhs_children.size(); ++i) {
+      if ((lhs_children[i] == nullptr) != (rhs_children[i] == nullptr)) {
+        return false;
+      } else if (lhs_children[i] != nullptr) {
+        stack.emplace_back(lhs_children[i], rhs_children[i]);
+      }
+    }
+  }
+  return true;
+}
+
+// Workers prove closed subtrees equal in parallel and stop all others on the first mismatch. Otherwise, the final
+// serial pass skips the proven pairs, so binding of variables happens in the same order as in `StructuralEqualImpl`.
+// Mismatches are not reported, see `SEqualFailReason`.
+inline bool StructuralEqualParallelImpl(Object *lhs, Object *rhs, bool bind_free_vars, int32_t num_threads) {
+  std::vector<ObjectPair> frontier;
+  if (num_threads > 1 && lhs != nullptr && rhs != nullptr) {
+    frontier.emplace_back(lhs, rhs);
+    if (!ExpandFrontier(&frontier, num_threads * kParallelSubtreesPerThread)) {
+      return false;
+    }
+  }
+  if (frontier.size() < 2) {
+    return StructuralEqualImpl(lhs, rhs, bind_free_vars, /*report=*/false);
+  }
+  std::vector<LocalHashMemo> memos(num_threads);
+  ProvenEqualPairs proven;
+  proven.parts.resize(num_threads);
+  std::atomic<bool> mismatch{false};
+  ParallelFor(num_threads, static_cast<int64_t>(frontier.size()), [&](int32_t thread_id, int64_t i) {
+    if (!mismatch.load(std::memory_order_relaxed) &&
+        !ProveEqualSubtrees(frontier[i], &memos[thread_id], &proven.parts[thread_id], &mismatch)) {
+      mismatch.store(true);
+    }
+  });
+  if (mismatch.load()) {
+    return false;
+  }
+  return StructuralEqualImpl(lhs, rhs, bind_free_vars, /*report=*/false, &proven);
+}
+
+// Reruns the comparison of a known mismatch with paths tracked, so that only failed comparisons pay for reporting
+inline std::string SEqualFailReason(Object *lhs, Object *rhs, bool bind_free_vars) {
+  try {
+    StructuralEqualImpl(lhs, rhs, bind_free_vars, /*report=*/true);
+  } catch (SEqualError &e) {
+    std::ostringstream os;
+    os << "Structural equality check failed at " << e.path << ": " << e.what();
+    return os.str();
+  }
+  return "";
+}
+
 #undef MLC_CORE_EQ_S_OPT
 #undef MLC_CORE_EQ_S_POD
 #undef MLC_CORE_EQ_S_ANY
 #undef MLC_CORE_EQ_S_ERR
+#undef MLC_CORE_EQ_S_FAIL
 #undef MLC_CORE_HASH_S_OPT
 #undef MLC_CORE_HASH_S_POD
 #undef MLC_CORE_HASH_S_ANY
@@ -980,6 +2089,12 @@ inline Any CopyShallowImpl(AnyView source) {
     return UList(list->begin(), list->end());
   } else if (UDictObj *dict = source.as<UDictObj>()) {
     return UDict(dict->begin(), dict->end());
+  } else if (TypedListObj *list = source.as<TypedListObj>()) {
+    return Ref<TypedListObj>::New(*list);
+  } else if (PersistentListObj *list = source.as<PersistentListObj>()) {
+    return Ref<PersistentListObj>::New(*list);
+  } else if (PersistentDictObj *dict = source.as<PersistentDictObj>()) {
+    return Ref<PersistentDictObj>::New(*dict);
   } else if (source.IsInstance<StrObj>() || source.IsInstance<ErrorObj>() || source.IsInstance<FuncObj>() ||
              source.IsInstance<TensorObj>()) {
     // TODO: do we want to shallow copy these types at all?
@@ -1026,7 +2141,9 @@ inline void CopyReplaceImpl(int32_t num_args, const AnyView *args, Any *ret) {
   if (::mlc::base::IsTypeIndexPOD(type_index)) {
     MLC_THROW(TypeError) << "TypeError: `__replace__` doesn't work on a POD type: " << source;
   } else if (source.IsInstance<StrObj>() || source.IsInstance<ErrorObj>() || source.IsInstance<FuncObj>() ||
-             source.IsInstance<UListObj>() || source.IsInstance<UDictObj>() || source.IsInstance<TensorObj>()) {
+             source.IsInstance<UListObj>() || source.IsInstance<UDictObj>() || source.IsInstance<TensorObj>() ||
+             source.IsInstance<TypedListObj>() || source.IsInstance<PersistentListObj>() ||
+             source.IsInstance<PersistentDictObj>()) {
     MLC_THROW(TypeError) << "TypeError: `__replace__` doesn't work on type: " << source.GetTypeKey();
   }
   struct Copier {
@@ -1148,6 +2265,20 @@ inline Any CopyDeepImpl(AnyView source) {
         Copier{&orig2copy, &fields}.HandleAny(&value);
       }
       UDict::FromAnyTuple(static_cast<int32_t>(fields.size()), fields.data(), &ret);
+    } else if (TypedListObj *list = object->as<TypedListObj>()) {
+      ret = Ref<TypedListObj>::New(*list);
+    } else if (PersistentListObj *list = object->as<PersistentListObj>()) {
+      fields.clear();
+      fields.reserve(list->size());
+      list->ForEach([&](const Any &e) { Copier{&orig2copy, &fields}.HandleAny(&e); });
+      PersistentList::FromAnyTuple(static_cast<int32_t>(fields.size()), fields.data(), &ret);
+    } else if (PersistentDictObj *dict = object->as<PersistentDictObj>()) {
+      fields.clear();
+      dict->ForEach([&](const Any &key, const Any &value) {
+        Copier{&orig2copy, &fields}.HandleAny(&key);
+        Copier{&orig2copy, &fields}.HandleAny(&value);
+      });
+      PersistentDict::FromAnyTuple(static_cast<int32_t>(fields.size()), fields.data(), &ret);
     } else if (object->IsInstance<StrObj>() || object->IsInstance<ErrorObj>() || object->IsInstance<FuncObj>() ||
                object->IsInstance<TensorObj>()) {
       ret = object;
@@ -1172,6 +2303,233 @@ inline Any CopyDeepImpl(AnyView source) {
   return orig2copy.at(source.operator Object *());
 }
 
+/****************** Interning ******************/
+
+// Whether `StructuralInternTableObj` merges objects of this type. Variables are never merged, as they are compared by
+// identity, nor are objects without a structure, e.g. tensors, functions and opaque objects
+inline bool IsInternable(MLCTypeInfo *type_info) {
+  int32_t type_index = type_info->type_index;
+  if (type_index == kMLCList || type_index == kMLCDict || type_index == kMLCStr || type_index == kMLCTypedList) {
+    return true;
+  }
+  return type_info->structure_kind != 0 && type_info->structure_kind != static_cast<int32_t>(StructureKind::kVar);
+}
+
+// Children are hashed and compared by identity, except for strings, which are compared by content
+MLC_INLINE uint64_t InternChildHash(const MLCAny &any) {
+  return ::mlc::base::HashCombine(static_cast<uint64_t>(any.type_index), ::mlc::base::AnyHash(any));
+}
+MLC_INLINE uint64_t InternChildHash(Object *obj) { return obj ? InternChildHash(AnyView(obj)) : 0; }
+MLC_INLINE bool InternChildEqual(const MLCAny &lhs, const MLCAny &rhs) { return ::mlc::base::AnyEqual(lhs, rhs); }
+MLC_INLINE bool InternChildEqual(Object *lhs, Object *rhs) {
+  return lhs == rhs || (lhs && rhs && InternChildEqual(AnyView(lhs), AnyView(rhs)));
+}
+
+struct InternFieldHasher {
+  template <typename T> MLC_INLINE void operator()(MLCTypeField *, T *v) { Combine(HashTyped<T>(0, *v)); }
+  template <typename T> MLC_INLINE void operator()(MLCTypeField *, Optional<T> *v) {
+    Combine(v->has_value() ? HashTyped<T>(1, *v->get()) : 0);
+  }
+  MLC_INLINE void operator()(MLCTypeField *, const char **v) { Combine(*v ? ::mlc::base::StrHash(*v) : 0); }
+  MLC_INLINE void operator()(MLCTypeField *, Any *v) { Combine(InternChildHash(*v)); }
+  MLC_INLINE void operator()(MLCTypeField *, ObjectRef *v) { Combine(InternChildHash(v->get())); }
+  MLC_INLINE void operator()(MLCTypeField *, Optional<ObjectRef> *v) { Combine(InternChildHash(v->get())); }
+  MLC_INLINE void Combine(uint64_t v) { hash = ::mlc::base::HashCombine(hash, v); }
+  uint64_t hash;
+};
+
+struct InternFieldEqual {
+  template <typename T> MLC_INLINE void operator()(MLCTypeField *field, T *v) {
+    equal = equal && std::memcmp(v, WithOffset<T>(rhs, field), sizeof(T)) == 0;
+  }
+  template <typename T> MLC_INLINE void operator()(MLCTypeField *field, Optional<T> *v) {
+    const T *l = v->get();
+    const T *r = WithOffset<Optional<T>>(rhs, field)->get();
+    equal = equal && (l == r || (l && r && std::memcmp(l, r, sizeof(T)) == 0));
+  }
+  MLC_INLINE void operator()(MLCTypeField *field, const char **v) {
+    const char *l = *v;
+    const char *r = *WithOffset<const char *>(rhs, field);
+    equal = equal && (l == r || (l && r && std::strcmp(l, r) == 0));
+  }
+  MLC_INLINE void operator()(MLCTypeField *field, Any *v) {
+    equal = equal && InternChildEqual(*v, *WithOffset<Any>(rhs, field));
+  }
+  MLC_INLINE void operator()(MLCTypeField *field, ObjectRef *v) {
+    equal = equal && InternChildEqual(v->get(), WithOffset<ObjectRef>(rhs, field)->get());
+  }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<ObjectRef> *v) {
+    equal = equal && InternChildEqual(v->get(), WithOffset<Optional<ObjectRef>>(rhs, field)->get());
+  }
+  Object *rhs;
+  bool equal;
+};
+
+// Points the fields of an object to the representatives of their values
+struct InternFieldRewriter {
+  template <typename T> MLC_INLINE void operator()(MLCTypeField *, T *) {}
+  MLC_INLINE void operator()(MLCTypeField *, Any *v) {
+    if (Object *obj = v->as<Object>()) {
+      if (const ObjectRef *rep = Find(obj)) {
+        *v = *rep;
+      }
+    }
+  }
+  MLC_INLINE void operator()(MLCTypeField *, ObjectRef *v) {
+    if (const ObjectRef *rep = Find(v->get())) {
+      *v = *rep;
+    }
+  }
+  MLC_INLINE void operator()(MLCTypeField *, Optional<ObjectRef> *v) {
+    if (const ObjectRef *rep = Find(v->get())) {
+      *v = *rep;
+    }
+  }
+  const ObjectRef *Find(Object *obj) const {
+    if (obj != nullptr) {
+      if (auto it = canonical->find(obj); it != canonical->end() && it->second.get() != obj) {
+        return &it->second;
+      }
+    }
+    return nullptr;
+  }
+  std::unordered_map<Object *, ObjectRef> *canonical;
+};
+
+inline uint64_t InternHash(Object *obj, MLCTypeInfo *type_info) {
+  uint64_t hash = type_info->type_key_hash;
+  if (StrObj *str = obj->as<StrObj>()) {
+    return ::mlc::base::HashCombine(hash, ::mlc::base::StrHash(str->data(), str->size()));
+  } else if (TypedListObj *list = obj->as<TypedListObj>()) {
+    hash = ::mlc::base::HashCombine(hash, static_cast<uint64_t>(list->elem_type_index()));
+    return ::mlc::base::HashCombine(hash, ::mlc::base::StrHash(static_cast<const char *>(list->data()),
+                                                               list->size() * list->elem_size()));
+  } else if (UListObj *list = obj->as<UListObj>()) {
+    for (const Any &e : *list) {
+      hash = ::mlc::base::HashCombine(hash, InternChildHash(e));
+    }
+    return hash;
+  } else if (UDictObj *dict = obj->as<UDictObj>()) {
+    // Iteration order of a dict depends on its history, so items are combined in an order-independent way
+    uint64_t items = 0;
+    for (const auto &kv : *dict) {
+      items += ::mlc::base::HashCombine(InternChildHash(kv.first), InternChildHash(kv.second));
+    }
+    return ::mlc::base::HashCombine(::mlc::base::HashCombine(hash, items), static_cast<uint64_t>(dict->size()));
+  }
+  InternFieldHasher hasher{hash};
+  VisitFields(obj, type_info, hasher);
+  return hasher.hash;
+}
+
+inline bool InternEqual(Object *lhs, Object *rhs, MLCTypeInfo *type_info) {
+  if (lhs->GetTypeIndex() != rhs->GetTypeIndex()) {
+    return false;
+  } else if (StrObj *str = lhs->as<StrObj>()) {
+    return str->Compare(rhs->as<StrObj>()) == 0;
+  } else if (TypedListObj *l = lhs->as<TypedListObj>()) {
+    TypedListObj *r = rhs->as<TypedListObj>();
+    return l->elem_type_index() == r->elem_type_index() && l->size() == r->size() &&
+           std::memcmp(l->data(), r->data(), l->size() * l->elem_size()) == 0;
+  } else if (UListObj *l = lhs->as<UListObj>()) {
+    UListObj *r = rhs->as<UListObj>();
+    if (l->size() != r->size()) {
+      return false;
+    }
+    for (int64_t i = 0, n = l->size(); i < n; ++i) {
+      if (!InternChildEqual((*l)[i], (*r)[i])) {
+        return false;
+      }
+    }
+    return true;
+  } else if (UDictObj *l = lhs->as<UDictObj>()) {
+    UDictObj *r = rhs->as<UDictObj>();
+    if (l->size() != r->size()) {
+      return false;
+    }
+    for (const auto &kv : *l) {
+      auto it = r->find(kv.first);
+      if (it == r->end() || !InternChildEqual(kv.second, it->second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  InternFieldEqual eq{rhs, true};
+  VisitFields(lhs, type_info, eq);
+  return eq.equal;
+}
+
+// Approximate number of bytes held by an object alone, i.e. excluding its children
+inline int64_t InternNumBytes(Object *obj, MLCTypeInfo *type_info) {
+  if (StrObj *str = obj->as<StrObj>()) {
+    return static_cast<int64_t>(sizeof(MLCStr)) + str->size() + 1;
+  } else if (TypedListObj *list = obj->as<TypedListObj>()) {
+    return static_cast<int64_t>(sizeof(MLCTypedList)) + list->capacity() * list->elem_size();
+  } else if (obj->IsInstance<UListObj>()) {
+    return static_cast<int64_t>(sizeof(MLCList) + sizeof(MLCAny) * reinterpret_cast<MLCList *>(obj)->capacity);
+  } else if (obj->IsInstance<UDictObj>()) {
+    return static_cast<int64_t>(sizeof(MLCDict) + 2 * sizeof(MLCAny) * reinterpret_cast<MLCDict *>(obj)->capacity);
+  }
+  int64_t num_bytes = static_cast<int64_t>(sizeof(MLCAny));
+  for (MLCTypeField *field = type_info->fields; field->name != nullptr; ++field) {
+    num_bytes = std::max(num_bytes, field->offset + static_cast<int64_t>(field->num_bytes));
+  }
+  return num_bytes;
+}
+
+inline ObjectRef InternImpl(StructuralInternTableObj *self, Object *obj, MLCTypeInfo *type_info) {
+  if (!IsInternable(type_info)) {
+    return ObjectRef(obj);
+  }
+  self->num_lookups += 1;
+  std::vector<ObjectRef> &bucket = self->buckets[InternHash(obj, type_info)];
+  for (ObjectRef &rep : bucket) {
+    if (rep.get() == obj) {
+      return rep;
+    } else if (InternEqual(rep.get(), obj, type_info)) {
+      self->num_merged += 1;
+      self->bytes_saved += InternNumBytes(obj, type_info);
+      return rep;
+    }
+  }
+  bucket.push_back(ObjectRef(obj));
+  return bucket.back();
+}
+
+inline Any InternGraphImpl(StructuralInternTableObj *self, AnyView root) {
+  if (root.type_index < kMLCStaticObjectBegin) {
+    return root;
+  }
+  // Duplicates may lose their last reference once their parents are rewritten, so all visited objects are kept alive
+  // until the end, as `canonical` is keyed by their addresses
+  std::vector<ObjectRef> visited;
+  std::unordered_map<Object *, ObjectRef> canonical;
+  TopoVisit(root.operator Object *(), nullptr, [&](Object *object, MLCTypeInfo *type_info) -> void {
+    visited.push_back(ObjectRef(object));
+    InternFieldRewriter rewriter{&canonical};
+    if (UListObj *list = object->as<UListObj>()) {
+      for (Any &e : *list) {
+        rewriter(nullptr, &e);
+      }
+    } else if (UDictObj *dict = object->as<UDictObj>()) {
+      // Keys are kept, as lookups of objects in a dict depend on their identity
+      for (auto &kv : *dict) {
+        rewriter(nullptr, &kv.second);
+      }
+    } else if (object->IsInstance<StrObj>() || object->IsInstance<TypedListObj>() ||
+               object->IsInstance<PersistentListObj>() || object->IsInstance<PersistentDictObj>() ||
+               object->IsInstance<ErrorObj>() || object->IsInstance<FuncObj>() || object->IsInstance<OpaqueObj>() ||
+               object->IsInstance<TensorObj>()) {
+      // Leaves, or persistent containers whose nodes may be shared with other versions
+    } else {
+      VisitFields(object, type_info, rewriter);
+    }
+    canonical[object] = InternImpl(self, object, type_info);
+  });
+  return canonical.at(root.operator Object *());
+}
+
 /****************** Tensor <=> Bytes ******************/
 
 template <int N, typename T> union BytesUnion {
@@ -1268,6 +2626,26 @@ Str TensorToBytes(const DLTensor *src) {
   return ret;
 }
 
+// A CPU tensor whose `data`, allocated with `new uint8_t[]`, and `shape` are owned and filled in by the caller
+Tensor NewOwnedCPUTensor(int32_t ndim) {
+  TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::NewNoArena();
+  ret->tensor.data = nullptr;
+  ret->tensor.device = DLDevice{kDLCPU, 0};
+  ret->tensor.ndim = ndim;
+  ret->tensor.dtype = DLDataType{kDLFloat, 32, 1};
+  ret->tensor.shape = new int64_t[ndim + 1];
+  ret->tensor.strides = nullptr;
+  ret->tensor.byte_offset = 0;
+  ret->manager_ctx = nullptr;
+  ret->_mlc_header.v.deleter = +[](void *_self) {
+    TensorObj *self = static_cast<TensorObj *>(_self);
+    uint8_t *data = static_cast<uint8_t *>(self->tensor.data);
+    delete[] data;
+    ::mlc::DefaultObjectAllocator<TensorObj>::Deleter(self);
+  };
+  return Tensor(ret);
+}
+
 Tensor TensorFromBytes(const uint8_t *data_ptr, int64_t max_size) {
   int64_t head = 0;
   uint64_t header = ReadElem<8, uint64_t>(data_ptr, &head, max_size);
@@ -1275,24 +2653,7 @@ Tensor TensorFromBytes(const uint8_t *data_ptr, int64_t max_size) {
     MLC_THROW(ValueError) << "LoadDLPack: Magic number mismatch.";
   }
   int32_t ndim = ReadElem<4, int32_t>(data_ptr, &head, max_size);
-  Tensor ret = [ndim]() {
-    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::New();
-    ret->tensor.data = nullptr;
-    ret->tensor.device = DLDevice{kDLCPU, 0};
-    ret->tensor.ndim = ndim;
-    ret->tensor.dtype = DLDataType{kDLFloat, 32, 1};
-    ret->tensor.shape = new int64_t[ndim + 1];
-    ret->tensor.strides = nullptr;
-    ret->tensor.byte_offset = 0;
-    ret->manager_ctx = nullptr;
-    ret->_mlc_header.v.deleter = +[](void *_self) {
-      TensorObj *self = static_cast<TensorObj *>(_self);
-      uint8_t *data = static_cast<uint8_t *>(self->tensor.data);
-      delete[] data;
-      ::mlc::DefaultObjectAllocator<TensorObj>::Deleter(self);
-    };
-    return Tensor(ret);
-  }();
+  Tensor ret = NewOwnedCPUTensor(ndim);
   DLTensor *tensor = &ret->tensor;
   tensor->dtype = ReadElem<4, DLDataType>(data_ptr, &head, max_size);
   for (int32_t i = 0; i < ndim; ++i) {
@@ -1309,7 +2670,75 @@ Tensor TensorFromBytes(const uint8_t *data_ptr, int64_t max_size) {
 
 /****************** Serialize / Deserialize ******************/
 
-inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
+// Buffers serialized output and hands it to `sink` in chunks of `Sink::kChunkSize` bytes. `Finish` emits the last,
+// possibly shorter, chunk and flushes the sink.
+class SinkStreamBuf : public std::streambuf {
+public:
+  explicit SinkStreamBuf(Sink *sink) : sink(sink), chunk(Sink::kChunkSize) { Reset(); }
+  int64_t Tell() const { return emitted + static_cast<int64_t>(pptr() - pbase()); }
+  void Finish() {
+    EmitChunk();
+    sink->Flush();
+  }
+
+protected:
+  int_type overflow(int_type c) override {
+    EmitChunk();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+private:
+  void EmitChunk() {
+    if (int64_t size = static_cast<int64_t>(pptr() - pbase()); size > 0) {
+      sink->Write(pbase(), size);
+      emitted += size;
+      Reset();
+    }
+  }
+  void Reset() { setp(chunk.data(), chunk.data() + chunk.size()); }
+
+  Sink *sink;
+  std::vector<char> chunk;
+  int64_t emitted = 0;
+};
+
+// Collects serialized output in memory, for callers that want the whole document as a `Str`
+struct StringSink : public Sink {
+  void Write(const char *data, int64_t size) override { buffer.append(data, static_cast<size_t>(size)); }
+  std::string buffer;
+};
+
+// Calls `fn(Sink *)` with the sink described by `target`, which is one of
+// - a pointer to `mlc::core::Sink`,
+// - a file descriptor, which is not closed afterwards,
+// - a file path, which is created or truncated, or
+// - a callback `(data: void *, size: int) -> None` called on each chunk.
+template <typename FSerialize> void WithSink(AnyView target, FSerialize fn) {
+  if (target.type_index == kMLCPtr) {
+    fn(static_cast<Sink *>(target.v.v_ptr));
+  } else if (target.type_index == kMLCInt) {
+    ::mlc::core::FDSink sink(static_cast<int>(target.v.v_int64));
+    fn(&sink);
+  } else if (target.type_index == kMLCRawStr) {
+    ::mlc::core::FileSink sink(target.v.v_str);
+    fn(&sink);
+  } else if (target.type_index == kMLCStr) {
+    ::mlc::core::FileSink sink(reinterpret_cast<StrObj *>(target.v.v_obj)->data());
+    fn(&sink);
+  } else if (target.type_index == kMLCFunc) {
+    ::mlc::core::CallbackSink sink(Func(reinterpret_cast<FuncObj *>(target.v.v_obj)));
+    fn(&sink);
+  } else {
+    MLC_THROW(TypeError) << "Expected a sink pointer, file descriptor, file path or callback, but got: "
+                         << Lib::GetTypeKey(target.type_index);
+  }
+}
+
+inline void Serialize(Any any, FuncObj *fn_opaque_serialize, std::ostream &os) {
   using mlc::base::TypeTraits;
   // Section 1. Define two lookups
   // 1) `type_keys` and `get_json_type_index`, which maps a `type_key` to type index/key to that in JSON
@@ -1382,11 +2811,11 @@ inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
     }
     inline void EmitDevice(DLDevice v) {
       int32_t type_device = (*get_json_type_index)(TypeTraits<DLDevice>::type_str);
-      (*os) << ", [" << type_device << ", " << ::mlc::base::TypeTraits<DLDevice>::__str__(v) << "]";
+      (*os) << ", [" << type_device << ", \"" << ::mlc::base::TypeTraits<DLDevice>::__str__(v) << "\"]";
     }
     inline void EmitDType(DLDataType v) {
       int32_t type_dtype = (*get_json_type_index)(TypeTraits<DLDataType>::type_str);
-      (*os) << ", [" << type_dtype << ", " << ::mlc::base::DType::Str(v) << "]";
+      (*os) << ", [" << type_dtype << ", \"" << ::mlc::base::DType::Str(v) << "\"]";
     }
     inline void EmitAny(const Any *any) {
       int32_t type_index = any->type_index;
@@ -1418,7 +2847,7 @@ inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
       }
       (*os) << ", " << obj_idx;
     }
-    std::ostringstream *os;
+    std::ostream *os;
     TGetJSONTypeIndex *get_json_type_index;
     const std::unordered_map<Object *, int32_t> *topo_index;
   };
@@ -1432,7 +2861,6 @@ inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
   //     * list: TODO: explain
   //     * str / bool / float / None: literals
   std::vector<TensorObj *> tensors;
-  std::ostringstream os;
   auto on_visit =
       [get_json_type_index = &get_json_type_index, os = &os, &tensors, &get_opaque_index, is_first_object = true,
        topo_indices = std::unordered_map<Object *, int32_t>()](Object *object, MLCTypeInfo *type_info) mutable -> void {
@@ -1459,9 +2887,11 @@ inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
     // [1...] = each field of the type. A few possible cases:
     // 1) list
     // 2) dict
-    // 3) tensor
-    // 4) opaque
-    // 5) a normal dataclass
+    // 3) typed list
+    // 4) persistent list or dict
+    // 5) tensor
+    // 6) opaque
+    // 7) a normal dataclass
     if (UListObj *list = object->as<UListObj>()) {
       Emitter emitter{os, get_json_type_index, &topo_indices};
       for (Any &any : *list) {
@@ -1473,6 +2903,22 @@ inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
         emitter.EmitAny(&kv.first);
         emitter.EmitAny(&kv.second);
       }
+    } else if (PersistentListObj *list = object->as<PersistentListObj>()) {
+      Emitter emitter{os, get_json_type_index, &topo_indices};
+      list->ForEach([&emitter](const Any &any) { emitter.EmitAny(&any); });
+    } else if (PersistentDictObj *dict = object->as<PersistentDictObj>()) {
+      Emitter emitter{os, get_json_type_index, &topo_indices};
+      dict->ForEach([&emitter](const Any &key, const Any &value) {
+        emitter.EmitAny(&key);
+        emitter.EmitAny(&value);
+      });
+    } else if (TypedListObj *list = object->as<TypedListObj>()) {
+      Emitter emitter{os, get_json_type_index, &topo_indices};
+      emitter.EmitInt(list->elem_type_index());
+      for (int64_t i = 0; i < list->size(); ++i) {
+        Any elem = list->at(i);
+        emitter.EmitAny(&elem);
+      }
     } else if (TensorObj *tensor = object->as<TensorObj>()) {
       (*os) << ", " << tensors.size();
       tensors.push_back(tensor);
@@ -1545,52 +2991,107 @@ inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
     opaque_repr->PrintEscape(os);
   }
   os << "}";
+}
+
+inline mlc::Str Serialize(Any any, FuncObj *fn_opaque_serialize) {
+  std::ostringstream os;
+  Serialize(std::move(any), fn_opaque_serialize, os);
   return os.str();
 }
 
-inline Any Deserialize(const char *json_str, int64_t json_str_len, FuncObj *fn_opaque_deserialize) {
-  int32_t json_type_index_tensor = -1;
-  int32_t json_type_index_opaque = -1;
-  // Step 0. Parse JSON string
-  UDict json_obj = JSONParse(json_str, json_str_len);
-  // Step 1. type_key => constructors
-  UList type_keys = json_obj->at("type_keys");
-  std::vector<FuncObj *> constructors;
-  constructors.reserve(type_keys.size());
-  for (Str type_key : type_keys) {
-    int32_t type_index = Lib::GetTypeIndex(type_key->data());
-    FuncObj *func = nullptr;
-    if (type_index == kMLCTensor) {
-      json_type_index_tensor = static_cast<int32_t>(constructors.size());
-    } else if (type_index == kMLCOpaque) {
-      json_type_index_opaque = static_cast<int32_t>(constructors.size());
+// Builds objects directly from the tokens of `values`, without materializing the document as lists and dicts first.
+// `Serialize` emits `values` before `type_keys`, so the top-level object is read in two passes: the first one reads
+// every other member and only skips over `values`, and the second one constructs `values` in order. Besides the objects
+// themselves, only the arguments of the constructor calls in flight are kept, which grows with nesting depth alone.
+struct JSONDeserializer {
+  Any Run() {
+    // Pass 1. `type_keys`, `tensors` and `opaques`
+    int64_t values_begin = -1;
+    p.SkipWhitespace();
+    p.ExpectChar('{');
+    p.SkipWhitespace();
+    if (p.PeekChar() == '}') {
+      p.ExpectChar('}');
     } else {
-      func = Lib::_init(type_index);
+      while (true) {
+        p.SkipWhitespace();
+        Str key = p.ParseStr().operator Str();
+        p.SkipWhitespace();
+        p.ExpectChar(':');
+        p.SkipWhitespace();
+        if (key == "values") {
+          values_begin = p.i;
+          SkipValue();
+        } else if (key == "type_keys") {
+          ParseTypeKeys();
+        } else if (key == "tensors") {
+          ParseTensors();
+        } else if (key == "opaques") {
+          ParseOpaques();
+        } else {
+          p.ParseValue();
+        }
+        p.SkipWhitespace();
+        if (p.PeekChar() == '}') {
+          p.ExpectChar('}');
+          break;
+        }
+        p.ExpectChar(',');
+      }
     }
-    constructors.push_back(func);
-  }
-  auto invoke_init = [&constructors](UList args) {
-    int32_t json_type_index = args[0];
-    Any ret;
-    ::mlc::base::FuncCall(constructors.at(json_type_index), static_cast<int32_t>(args.size()) - 1, args->data() + 1,
-                          &ret);
-    return ret;
-  };
-  // Step 2. Handle tensors
-  std::vector<Tensor> tensors;
-  if (json_obj->count("tensors")) {
-    UList tensors_b64 = json_obj->at("tensors");
-    while (!tensors_b64->empty()) {
-      Tensor tensor = Tensor::FromBase64(tensors_b64->back());
-      tensors.push_back(tensor);
-      tensors_b64->pop_back();
+    p.SkipWhitespace();
+    if (p.i != p.json_str_len) {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << p.i
+                            << ": Extra data after valid JSON. JSON string: " << p.json_str;
+    }
+    if (values_begin == -1) {
+      MLC_THROW(KeyError) << "values";
+    }
+    if (!has_type_keys) {
+      MLC_THROW(KeyError) << "type_keys";
+    }
+    // Pass 2. `values`
+    p.i = values_begin;
+    p.ExpectChar('[');
+    p.SkipWhitespace();
+    if (p.PeekChar() == ']') {
+      MLC_THROW(ValueError) << "Nothing to deserialize: `values` is empty";
+    }
+    while (true) {
+      p.SkipWhitespace();
+      values.push_back(ParseValue());
+      p.SkipWhitespace();
+      if (p.PeekChar() == ']') {
+        break;
+      }
+      p.ExpectChar(',');
     }
-    json_obj->erase("tensors");
-    std::reverse(tensors.begin(), tensors.end());
+    return values.back();
   }
-  // Step 3. Handle opaque objects
-  UList opaques;
-  if (json_obj.count("opaques")) {
+
+  void ParseTypeKeys() {
+    has_type_keys = true;
+    ParseList([this]() {
+      Str type_key = p.ParseStr().operator Str();
+      int32_t type_index = Lib::GetTypeIndex(type_key->data());
+      FuncObj *func = nullptr;
+      if (type_index == kMLCTensor) {
+        json_type_index_tensor = static_cast<int32_t>(constructors.size());
+      } else if (type_index == kMLCOpaque) {
+        json_type_index_opaque = static_cast<int32_t>(constructors.size());
+      } else {
+        func = Lib::_init(type_index);
+      }
+      constructors.push_back(func);
+      type_keys.push_back(std::move(type_key));
+    });
+  }
+
+  void ParseTensors() {
+    ParseList([this]() { tensors.push_back(Tensor::FromBase64(p.ParseStr().operator Str())); });
+  }
+
+  void ParseOpaques() {
     if (!fn_opaque_deserialize) {
       fn_opaque_deserialize = Func::GetGlobal("mlc.Opaque.default.deserialize", true);
     }
@@ -1599,63 +3100,786 @@ inline Any Deserialize(const char *json_str, int64_t json_str_len, FuncObj *fn_o
           << "Cannot find deserialization function `mlc.Opaque.default.deserialize`. Register it with "
              "`mlc.Func.register(\"mlc.Opaque.default.deserialize\")(deserialize_func)`";
     }
-    opaques = (*fn_opaque_deserialize)(json_obj->at("opaques")).operator UList();
-  }
-  // Step 4. Translate JSON object to objects
-  UList values = json_obj->at("values");
-  for (int64_t i = 0; i < values->size(); ++i) {
-    Any &value = values[i];
-    // every `value` is
-    // 1) integer `i` -> refer to `values[i]`
-    // 2) string `s` -> string literal `s`
-    // 3) list -> normal case, its layout is:
-    //   - [0] = json_type_index
-    //   - [1...] = each field of the type
-    //     * int: refer to `values[i]`
-    //     * list: TODO: explain
-    //     * str / bool / float / None: literals
-    // TODO: how about kMLCBool, kMLCFloat, kMLCNone?
-    if (UListObj *list = value.as<UListObj>()) {
-      // Layout of the list:
-      int32_t json_type_index = (*list)[0];
-      if (json_type_index == json_type_index_tensor) {
-        int32_t idx = (*list)[1];
-        value = tensors[idx];
-      } else if (json_type_index == json_type_index_opaque) {
-        int32_t idx = (*list)[1];
-        value = opaques[idx];
-      } else {
-        for (int64_t j = 1; j < list->size(); ++j) {
-          Any arg = (*list)[j];
-          if (arg.type_index == kMLCInt) {
-            int64_t k = arg;
-            if (k < i) {
-              (*list)[j] = values[k];
-            } else {
+    opaques = (*fn_opaque_deserialize)(p.ParseValue()).operator UList();
+  }
+
+  // Calls `fn` on each element of a list, with the parser positioned at the element
+  template <typename Fn> void ParseList(Fn &&fn) {
+    p.ExpectChar('[');
+    p.SkipWhitespace();
+    if (p.PeekChar() == ']') {
+      p.ExpectChar(']');
+      return;
+    }
+    while (true) {
+      p.SkipWhitespace();
+      fn();
+      p.SkipWhitespace();
+      if (p.PeekChar() == ']') {
+        p.ExpectChar(']');
+        return;
+      }
+      p.ExpectChar(',');
+    }
+  }
+
+  // Moves past a JSON value by matching brackets, without building anything. Malformed content is reported when
+  // `values` is parsed in the second pass.
+  void SkipValue() {
+    const char *json_str = p.json_str;
+    int64_t depth = 0;
+    do {
+      p.SkipWhitespace();
+      if (p.i >= p.json_str_len) {
+        p.ParseValue(); // Reports the unexpected end of input
+      }
+      char c = json_str[p.i];
+      if (c == '"') {
+        int64_t begin = p.i++;
+        while (p.i < p.json_str_len && json_str[p.i] != '"') {
+          p.i += json_str[p.i] == '\\' ? 2 : 1;
+        }
+        if (p.i >= p.json_str_len) {
+          p.i = begin;
+          p.ParseStr(); // Reports the unterminated string
+        }
+      } else if (c == '[' || c == '{') {
+        ++depth;
+      } else if (c == ']' || c == '}') {
+        --depth;
+      }
+      ++p.i;
+    } while (depth > 0);
+  }
+
+  // Each entry of `values` is one of the following:
+  // 1) string `s`: string literal `s`
+  // 2) integer `k`: the same object as `values[k]`
+  // 3) list `[json_type_index, fields...]`: an object constructed from its fields, where each field is
+  //   * int `k`: `values[k]`
+  //   * list `[json_type_index, args...]`: a POD value (int, dtype, device) constructed from literal arguments
+  //   * str / bool / float / None: literals
+  //   Tensors and opaque objects instead have a single field, their index into `tensors` or `opaques`.
+  Any ParseValue() {
+    char c = p.PeekChar();
+    if (c == '"') {
+      return p.ParseStr();
+    } else if (c == '[') {
+      p.ExpectChar('[');
+      p.SkipWhitespace();
+      int32_t json_type_index = ParseTypeIndex();
+      if (json_type_index == json_type_index_tensor || json_type_index == json_type_index_opaque) {
+        p.SkipWhitespace();
+        p.ExpectChar(',');
+        p.SkipWhitespace();
+        int64_t idx = ParseInt();
+        p.SkipWhitespace();
+        p.ExpectChar(']');
+        bool is_tensor = json_type_index == json_type_index_tensor;
+        int64_t size = is_tensor ? static_cast<int64_t>(tensors.size()) : opaques->size();
+        if (idx < 0 || idx >= size) {
+          MLC_THROW(ValueError) << "Invalid reference when parsing type `" << type_keys[json_type_index]
+                                << "`: referring #" << idx << " of " << size << " at #" << values.size();
+        }
+        if (is_tensor) {
+          return Any(tensors[idx]);
+        }
+        return opaques[idx];
+      }
+      size_t begin = args.size();
+      while (true) {
+        p.SkipWhitespace();
+        if (p.PeekChar() == ']') {
+          p.ExpectChar(']');
+          break;
+        }
+        p.ExpectChar(',');
+        p.SkipWhitespace();
+        c = p.PeekChar();
+        if (c == '[') {
+          args.push_back(ParsePOD());
+        } else if (std::isdigit(c) || c == '-') {
+          Any num = ParseNumber();
+          if (num.type_index == kMLCInt) {
+            int64_t k = num.v.v_int64;
+            if (k < 0 || k >= static_cast<int64_t>(values.size())) {
               MLC_THROW(ValueError) << "Invalid reference when parsing type `" << type_keys[json_type_index]
-                                    << "`: referring #" << k << " at #" << i << ". v = " << value;
+                                    << "`: referring #" << k << " at #" << values.size();
             }
-          } else if (UListObj *arg_list = arg.as<UListObj>()) {
-            (*list)[j] = invoke_init(UList(arg_list));
-          } else if (arg.type_index == kMLCStr || arg.type_index == kMLCBool || arg.type_index == kMLCFloat ||
-                     arg.type_index == kMLCNone) {
-            // Do nothing
+            args.push_back(values[k]);
           } else {
+            args.push_back(std::move(num));
+          }
+        } else {
+          Any arg = p.ParseValue();
+          if (arg.type_index != kMLCStr && arg.type_index != kMLCBool && arg.type_index != kMLCFloat &&
+              arg.type_index != kMLCNone) {
             MLC_THROW(ValueError) << "Unexpected value: " << arg;
           }
+          args.push_back(std::move(arg));
         }
-        value = invoke_init(UList(list));
       }
-    } else if (value.type_index == kMLCInt) {
-      int32_t k = value;
-      value = values[k];
-    } else if (value.type_index == kMLCStr) {
-      // Do nothing
+      return Invoke(json_type_index, begin);
+    } else if (std::isdigit(c) || c == '-') {
+      int64_t k = ParseInt();
+      if (k < 0 || k >= static_cast<int64_t>(values.size())) {
+        MLC_THROW(ValueError) << "Invalid reference: referring #" << k << " at #" << values.size();
+      }
+      return values[k];
+    }
+    MLC_THROW(ValueError) << "Unexpected value: " << p.ParseValue();
+    MLC_UNREACHABLE();
+  }
+
+  // `[json_type_index, args...]`, whose arguments are passed to the constructor as they are
+  Any ParsePOD() {
+    p.ExpectChar('[');
+    p.SkipWhitespace();
+    int32_t json_type_index = ParseTypeIndex();
+    size_t begin = args.size();
+    while (true) {
+      p.SkipWhitespace();
+      if (p.PeekChar() == ']') {
+        p.ExpectChar(']');
+        break;
+      }
+      p.ExpectChar(',');
+      p.SkipWhitespace();
+      args.push_back(p.ParseValue());
+    }
+    return Invoke(json_type_index, begin);
+  }
+
+  int32_t ParseTypeIndex() {
+    int64_t json_type_index = ParseInt();
+    if (json_type_index < 0 || json_type_index >= static_cast<int64_t>(constructors.size())) {
+      MLC_THROW(ValueError) << "Invalid type index: " << json_type_index;
+    }
+    return static_cast<int32_t>(json_type_index);
+  }
+
+  int64_t ParseInt() {
+    Any ret = ParseNumber();
+    if (ret.type_index != kMLCInt) {
+      MLC_THROW(ValueError) << "Expected an integer, but got: " << ret;
+    }
+    return ret.v.v_int64;
+  }
+
+  Any ParseNumber() {
+    // Fast path: a non-negative integer of at most 18 digits, e.g. a reference
+    const char *json_str = p.json_str;
+    int64_t end = p.i;
+    int64_t value = 0;
+    while (end < p.json_str_len && end - p.i < 18 && std::isdigit(json_str[end])) {
+      value = value * 10 + (json_str[end++] - '0');
+    }
+    if (end != p.i && (end == p.json_str_len || !(std::isdigit(json_str[end]) || json_str[end] == '.' ||
+                                                  json_str[end] == 'e' || json_str[end] == 'E' ||
+                                                  json_str[end] == '+' || json_str[end] == '-'))) {
+      p.i = end;
+      return Any(value);
+    }
+    return p.ParseNumber();
+  }
+
+  // Constructs an object from `args[begin:]`, and pops them
+  Any Invoke(int32_t json_type_index, size_t begin) {
+    FuncObj *func = constructors[json_type_index];
+    if (func == nullptr) {
+      MLC_THROW(ValueError) << "Cannot construct type `" << type_keys[json_type_index] << "` from its fields";
+    }
+    Any ret;
+    ::mlc::base::FuncCall(func, static_cast<int32_t>(args.size() - begin), args.data() + begin, &ret);
+    args.resize(begin);
+    return ret;
+  }
+
+  JSONScalarParser p;
+  FuncObj *fn_opaque_deserialize;
+  bool has_type_keys = false;
+  int32_t json_type_index_tensor = -1;
+  int32_t json_type_index_opaque = -1;
+  std::vector<Str> type_keys{};
+  std::vector<FuncObj *> constructors{};
+  std::vector<Tensor> tensors{};
+  UList opaques{};
+  std::vector<Any> values{};
+  std::vector<Any> args{};
+};
+
+inline Any Deserialize(const char *json_str, int64_t json_str_len, FuncObj *fn_opaque_deserialize) {
+  if (json_str_len < 0) {
+    json_str_len = static_cast<int64_t>(std::strlen(json_str));
+  }
+  return JSONDeserializer{JSONScalarParser{0, json_str_len, json_str, false}, fn_opaque_deserialize}.Run();
+}
+
+/****************** Binary Serialize / Deserialize ******************/
+
+// Layout of the binary format, where fixed-size integers are little-endian and `varint` is LEB128:
+// - Header: u64 magic, u32 version, u32 reserved
+// - Objects in topological order, each a varint `type_ref` followed by its payload, and a final `type_ref` of 0.
+//   Type keys are numbered from 1 in order of first use, and the first use of a type key is followed by the key.
+// - The root value
+// - Opaque objects as the string returned by `fn_opaque_serialize`, which is empty if there are none
+// - u64 offset of the opaque objects, which are read first, as objects refer to them
+//
+// Payloads are a varint count followed by values, where a value is a `BinaryTag` followed by its content, and objects
+// refer to earlier objects by index, so that shared objects are stored once. Exceptions are strings, whose bytes
+// follow their length, opaque objects, stored as their index, and tensors, stored as ndim, dtype and shape followed by
+// the raw data, aligned to `kBinaryTensorAlign` bytes from the start of the buffer, so that a mapped file can back
+// tensors in place.
+constexpr uint64_t kMLCBinaryMagic = 0x3142434C4DB4A13FULL;
+constexpr uint32_t kMLCBinaryVersion = 1;
+constexpr int64_t kBinaryTensorAlign = 64;
+
+enum class BinaryTag : uint8_t {
+  kNone = 0,
+  kFalse = 1,
+  kTrue = 2,
+  kInt = 3,    // zigzag varint
+  kFloat = 4,  // f64
+  kDevice = 5, // varint device type, varint device id
+  kDType = 6,  // u8 code, u8 bits, u16 lanes
+  kObject = 7, // varint index of an earlier object
+};
+
+struct BinaryWriter {
+  void WriteU8(uint8_t v) { buf->sputc(static_cast<char>(v)); }
+  template <int N, typename T> void WriteFixed(T v) {
+    uint8_t bytes[N];
+    int64_t tail = 0;
+    WriteElem<N>(bytes, &tail, v);
+    WriteRaw(bytes, N);
+  }
+  void WriteVarint(uint64_t v) {
+    while (v >= 0x80) {
+      WriteU8(static_cast<uint8_t>(v) | 0x80);
+      v >>= 7;
+    }
+    WriteU8(static_cast<uint8_t>(v));
+  }
+  void WriteZigzag(int64_t v) { WriteVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+  void WriteBytes(const void *data, int64_t size) {
+    WriteVarint(static_cast<uint64_t>(size));
+    WriteRaw(data, size);
+  }
+  void WriteRaw(const void *data, int64_t size) { buf->sputn(static_cast<const char *>(data), size); }
+  void Align(int64_t alignment) {
+    for (int64_t padding = (alignment - Tell() % alignment) % alignment; padding > 0; --padding) {
+      WriteU8(0);
+    }
+  }
+  int64_t Tell() const { return buf->Tell(); }
+  SinkStreamBuf *buf;
+};
+
+struct BinaryReader {
+  [[noreturn]] void Fail(const char *msg) const {
+    MLC_THROW(ValueError) << "BinaryDeserialize: " << msg << " at byte " << head;
+  }
+  void Require(int64_t n) const {
+    if (n < 0 || n > size - head) {
+      Fail("Unexpected end of input");
+    }
+  }
+  uint8_t ReadU8() {
+    Require(1);
+    return data[head++];
+  }
+  template <int N, typename T> T ReadFixed() { return ReadElem<N, T>(data, &head, size); }
+  uint64_t ReadVarint() {
+    uint64_t ret = 0;
+    for (int32_t shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = ReadU8();
+      ret |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return ret;
+      }
+    }
+    Fail("Malformed varint");
+  }
+  int64_t ReadZigzag() {
+    uint64_t v = ReadVarint();
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+  }
+  // Number of elements of a tensor whose `elem_size`-byte payload must fit in the rest of the input
+  int64_t RequireTensor(int32_t ndim, const int64_t *shape, int32_t elem_size) const {
+    int64_t numel = 1;
+    for (int32_t i = 0; i < ndim; ++i) {
+      if (shape[i] < 0) {
+        Fail("Negative tensor dimension");
+      }
+      if (shape[i] == 0) {
+        numel = 0;
+      }
+    }
+    int64_t limit = size - head;
+    for (int32_t i = 0; i < ndim && numel != 0; ++i) {
+      if (numel > limit / shape[i]) {
+        Fail("Tensor size exceeds input");
+      }
+      numel *= shape[i];
+    }
+    if (elem_size > 0 && numel > limit / elem_size) {
+      Fail("Tensor size exceeds input");
+    }
+    return numel;
+  }
+  int64_t ReadSize() {
+    uint64_t v = ReadVarint();
+    if (v > static_cast<uint64_t>(size - head)) {
+      Fail("Size exceeds input");
+    }
+    return static_cast<int64_t>(v);
+  }
+  const uint8_t *ReadBytes(int64_t *n) {
+    *n = ReadSize();
+    const uint8_t *ret = data + head;
+    head += *n;
+    return ret;
+  }
+  void Align(int64_t alignment) {
+    int64_t padding = (alignment - head % alignment) % alignment;
+    Require(padding);
+    head += padding;
+  }
+  const uint8_t *data;
+  int64_t size;
+  int64_t head;
+};
+
+inline void BinarySerialize(AnyView root, FuncObj *fn_opaque_serialize, SinkStreamBuf *buf) {
+  struct Emitter {
+    // clang-format off
+    void operator()(MLCTypeField *, const Any *any) { EmitAny(*any); }
+    void operator()(MLCTypeField *, ObjectRef *obj) { if (Object *v = obj->get()) EmitObject(v); else EmitNone(); }
+    void operator()(MLCTypeField *, Optional<ObjectRef> *opt) { if (Object *v = opt->get()) EmitObject(v); else EmitNone(); }
+    void operator()(MLCTypeField *, Optional<bool> *opt) { if (const bool *v = opt->get()) EmitBool(*v); else EmitNone(); }
+    void operator()(MLCTypeField *, Optional<int64_t> *opt) { if (const int64_t *v = opt->get()) EmitInt(*v); else EmitNone(); }
+    void operator()(MLCTypeField *, Optional<double> *opt) { if (const double *v = opt->get()) EmitFloat(*v); else EmitNone(); }
+    void operator()(MLCTypeField *, Optional<DLDevice> *opt) { if (const DLDevice *v = opt->get()) EmitDevice(*v); else EmitNone(); }
+    void operator()(MLCTypeField *, Optional<DLDataType> *opt) { if (const DLDataType *v = opt->get()) EmitDType(*v); else EmitNone(); }
+    // clang-format on
+    void operator()(MLCTypeField *, bool *v) { EmitBool(*v); }
+    void operator()(MLCTypeField *, int8_t *v) { EmitInt(*v); }
+    void operator()(MLCTypeField *, int16_t *v) { EmitInt(*v); }
+    void operator()(MLCTypeField *, int32_t *v) { EmitInt(*v); }
+    void operator()(MLCTypeField *, int64_t *v) { EmitInt(*v); }
+    void operator()(MLCTypeField *, float *v) { EmitFloat(*v); }
+    void operator()(MLCTypeField *, double *v) { EmitFloat(*v); }
+    void operator()(MLCTypeField *, DLDataType *v) { EmitDType(*v); }
+    void operator()(MLCTypeField *, DLDevice *v) { EmitDevice(*v); }
+    void operator()(MLCTypeField *, Optional<void *> *) { MLC_THROW(TypeError) << "Unserializable type: void *"; }
+    void operator()(MLCTypeField *, void **) { MLC_THROW(TypeError) << "Unserializable type: void *"; }
+    void operator()(MLCTypeField *, const char **) { MLC_THROW(TypeError) << "Unserializable type: const char *"; }
+    void EmitNone() { out->WriteU8(static_cast<uint8_t>(BinaryTag::kNone)); }
+    void EmitBool(bool v) { out->WriteU8(static_cast<uint8_t>(v ? BinaryTag::kTrue : BinaryTag::kFalse)); }
+    void EmitInt(int64_t v) {
+      out->WriteU8(static_cast<uint8_t>(BinaryTag::kInt));
+      out->WriteZigzag(v);
+    }
+    void EmitFloat(double v) {
+      out->WriteU8(static_cast<uint8_t>(BinaryTag::kFloat));
+      out->WriteFixed<8>(v);
+    }
+    void EmitDevice(DLDevice v) {
+      out->WriteU8(static_cast<uint8_t>(BinaryTag::kDevice));
+      out->WriteVarint(static_cast<uint64_t>(v.device_type));
+      out->WriteZigzag(v.device_id);
+    }
+    void EmitDType(DLDataType v) {
+      out->WriteU8(static_cast<uint8_t>(BinaryTag::kDType));
+      out->WriteFixed<4>(v);
+    }
+    void EmitObject(Object *obj) {
+      out->WriteU8(static_cast<uint8_t>(BinaryTag::kObject));
+      out->WriteVarint(static_cast<uint64_t>(obj_index->at(obj)));
+    }
+    void EmitAny(AnyView any) {
+      int32_t type_index = any.type_index;
+      if (type_index == kMLCNone) {
+        EmitNone();
+      } else if (type_index == kMLCBool) {
+        EmitBool(any.operator bool());
+      } else if (type_index == kMLCInt) {
+        EmitInt(any.operator int64_t());
+      } else if (type_index == kMLCFloat) {
+        EmitFloat(any.operator double());
+      } else if (type_index == kMLCDevice) {
+        EmitDevice(any.operator DLDevice());
+      } else if (type_index == kMLCDataType) {
+        EmitDType(any.operator DLDataType());
+      } else if (type_index >= kMLCStaticObjectBegin) {
+        EmitObject(any.operator Object *());
+      } else {
+        MLC_THROW(TypeError) << "Cannot serialize type: " << Lib::GetTypeKey(type_index);
+      }
+    }
+    BinaryWriter *out;
+    const std::unordered_map<Object *, int64_t> *obj_index;
+  };
+  BinaryWriter out{buf};
+  std::unordered_map<Object *, int64_t> obj_index;
+  std::unordered_map<int32_t, uint64_t> type_refs;
+  UList opaques;
+  std::unordered_map<void *, int64_t> opaque_index;
+  Emitter emitter{&out, &obj_index};
+  out.WriteFixed<8>(kMLCBinaryMagic);
+  out.WriteFixed<4>(kMLCBinaryVersion);
+  out.WriteFixed<4>(static_cast<uint32_t>(0));
+  auto on_visit = [&](Object *object, MLCTypeInfo *type_info) -> void {
+    obj_index.emplace(object, static_cast<int64_t>(obj_index.size()));
+    if (auto it = type_refs.find(type_info->type_index); it != type_refs.end()) {
+      out.WriteVarint(it->second);
+    } else {
+      uint64_t type_ref = type_refs.size() + 1;
+      type_refs.emplace(type_info->type_index, type_ref);
+      out.WriteVarint(type_ref);
+      out.WriteBytes(type_info->type_key, static_cast<int64_t>(std::strlen(type_info->type_key)));
+    }
+    if (StrObj *str = object->as<StrObj>()) {
+      out.WriteBytes(str->data(), str->size());
+    } else if (UListObj *list = object->as<UListObj>()) {
+      out.WriteVarint(static_cast<uint64_t>(list->size()));
+      for (const Any &any : *list) {
+        emitter.EmitAny(any);
+      }
+    } else if (UDictObj *dict = object->as<UDictObj>()) {
+      out.WriteVarint(static_cast<uint64_t>(dict->size()));
+      for (auto &kv : *dict) {
+        emitter.EmitAny(kv.first);
+        emitter.EmitAny(kv.second);
+      }
+    } else if (PersistentListObj *list = object->as<PersistentListObj>()) {
+      out.WriteVarint(static_cast<uint64_t>(list->size()));
+      list->ForEach([&emitter](const Any &any) { emitter.EmitAny(any); });
+    } else if (PersistentDictObj *dict = object->as<PersistentDictObj>()) {
+      // Same arguments as the constructor: keys and values interleaved
+      out.WriteVarint(static_cast<uint64_t>(dict->size() * 2));
+      dict->ForEach([&emitter](const Any &key, const Any &value) {
+        emitter.EmitAny(key);
+        emitter.EmitAny(value);
+      });
+    } else if (TypedListObj *list = object->as<TypedListObj>()) {
+      // Same arguments as the constructor: the element type index followed by the elements
+      out.WriteVarint(static_cast<uint64_t>(list->size() + 1));
+      emitter.EmitInt(list->elem_type_index());
+      for (int64_t i = 0; i < list->size(); ++i) {
+        emitter.EmitAny(list->at(i));
+      }
+    } else if (TensorObj *tensor = object->as<TensorObj>()) {
+      const DLTensor *src = &tensor->tensor;
+      if (src->device.device_type != kDLCPU || src->strides != nullptr) {
+        MLC_THROW(ValueError) << "BinarySerialize: Only CPU tensor without strides is supported.";
+      }
+      int64_t numel = ::mlc::core::ShapeToNumel(src->ndim, src->shape);
+      int32_t elem_size = ::mlc::base::DType::Size(src->dtype);
+      out.WriteVarint(static_cast<uint64_t>(src->ndim));
+      out.WriteFixed<4>(src->dtype);
+      for (int32_t i = 0; i < src->ndim; ++i) {
+        out.WriteZigzag(src->shape[i]);
+      }
+      out.Align(kBinaryTensorAlign);
+      // Converted to little-endian one chunk at a time, so that a large tensor is never copied as a whole
+      uint8_t *data = static_cast<uint8_t *>(src->data) + src->byte_offset;
+      int64_t chunk_numel = std::max<int64_t>(1, Sink::kChunkSize / std::max<int32_t>(elem_size, 1));
+      std::vector<uint8_t> chunk;
+      for (int64_t i = 0; i < numel; i += chunk_numel) {
+        int64_t n = std::min(chunk_numel, numel - i);
+        int64_t written = 0;
+        chunk.resize(static_cast<size_t>(n * elem_size));
+        WriteElemMany(chunk.data(), &written, data + i * elem_size, elem_size, n);
+        out.WriteRaw(chunk.data(), written);
+      }
+    } else if (OpaqueObj *opaque = object->as<OpaqueObj>()) {
+      auto [it, inserted] = opaque_index.emplace(opaque->handle, opaques.size());
+      if (inserted) {
+        opaques.push_back(opaque);
+      }
+      out.WriteVarint(static_cast<uint64_t>(it->second));
+    } else if (object->IsInstance<FuncObj>() || object->IsInstance<ErrorObj>()) {
+      MLC_THROW(TypeError) << "Unserializable type: " << object->GetTypeKey();
+    } else {
+      int64_t num_fields = 0;
+      for (MLCTypeField *field = type_info->fields; field->name != nullptr; ++field) {
+        ++num_fields;
+      }
+      out.WriteVarint(static_cast<uint64_t>(num_fields));
+      VisitFields(object, type_info, emitter);
+    }
+  };
+  if (root.type_index >= kMLCStaticObjectBegin) {
+    TopoVisit(root.operator Object *(), nullptr, on_visit);
+  }
+  out.WriteVarint(0);
+  emitter.EmitAny(root);
+  int64_t opaques_offset = out.Tell();
+  if (opaques.empty()) {
+    out.WriteVarint(0);
+  } else {
+    if (!fn_opaque_serialize) {
+      fn_opaque_serialize = Func::GetGlobal("mlc.Opaque.default.serialize", true);
+    }
+    if (!fn_opaque_serialize) {
+      MLC_THROW(ValueError) << "Cannot find serialization function `mlc.Opaque.default.serialize`. Register it with "
+                               "`mlc.Func.register(\"mlc.Opaque.default.serialize\")(serialize_func)`";
+    }
+    Str opaque_repr = (*fn_opaque_serialize)(opaques);
+    out.WriteBytes(opaque_repr->data(), opaque_repr->size());
+  }
+  out.WriteFixed<8>(static_cast<uint64_t>(opaques_offset));
+}
+
+inline Str BinarySerialize(AnyView root, FuncObj *fn_opaque_serialize) {
+  StringSink sink;
+  SinkStreamBuf buf(&sink);
+  BinarySerialize(root, fn_opaque_serialize, &buf);
+  buf.Finish();
+  return Str(std::move(sink.buffer));
+}
+
+// A whole file mapped into memory, so that tensors loaded from it refer to its pages instead of copying them. The file
+// is opened read-only and mapped privately: writes to a tensor copy the touched pages and never reach the file. Unless
+// `lazy`, all pages are read in up front; otherwise each page is read from disk on first access. Without `mmap`, the
+// file is read into a single aligned buffer shared the same way.
+struct FileMapping {
+  explicit FileMapping(const char *path, bool lazy) {
+#ifdef _MSC_VER
+    (void)lazy;
+    std::FILE *file = std::fopen(path, "rb");
+    if (file == nullptr) {
+      MLC_THROW(ValueError) << "Cannot open file: " << path << ": " << std::strerror(errno);
+    }
+    std::fseek(file, 0, SEEK_END);
+    size = static_cast<int64_t>(_ftelli64(file));
+    std::fseek(file, 0, SEEK_SET);
+    data = static_cast<uint8_t *>(_aligned_malloc(static_cast<size_t>(std::max<int64_t>(size, 1)), kBinaryTensorAlign));
+    bool ok = data != nullptr && std::fread(data, 1, static_cast<size_t>(size), file) == static_cast<size_t>(size);
+    std::fclose(file);
+    if (!ok) {
+      MLC_THROW(ValueError) << "Failed to read file: " << path;
+    }
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      MLC_THROW(ValueError) << "Cannot open file: " << path << ": " << std::strerror(errno);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      MLC_THROW(ValueError) << "Cannot stat file: " << path << ": " << std::strerror(err);
+    }
+    size = static_cast<int64_t>(st.st_size);
+    if (size > 0) {
+      int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+      flags |= lazy ? 0 : MAP_POPULATE;
+#endif
+      void *addr = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, flags, fd, 0);
+      int err = errno;
+      ::close(fd);
+      if (addr == MAP_FAILED) {
+        MLC_THROW(ValueError) << "Cannot map file: " << path << ": " << std::strerror(err);
+      }
+#ifndef MAP_POPULATE
+      if (!lazy) {
+        ::madvise(addr, static_cast<size_t>(size), MADV_WILLNEED);
+      }
+#endif
+      data = static_cast<uint8_t *>(addr);
     } else {
-      MLC_THROW(ValueError) << "Unexpected value: " << value;
+      ::close(fd);
     }
+#endif
   }
-  return values->back();
+  FileMapping(const FileMapping &) = delete;
+  FileMapping &operator=(const FileMapping &) = delete;
+  ~FileMapping() {
+#ifdef _MSC_VER
+    _aligned_free(data);
+#else
+    if (data != nullptr) {
+      ::munmap(data, static_cast<size_t>(size));
+    }
+#endif
+  }
+  uint8_t *data = nullptr;
+  int64_t size = 0;
+};
+
+// A CPU tensor whose data lives in `mapping`, which it keeps alive through `manager_ctx`. The managed tensor owns a
+// copy of the shape, as `src.shape` may not outlive this call.
+Tensor NewMappedCPUTensor(const DLTensor &src, std::shared_ptr<FileMapping> mapping) {
+  struct Context {
+    std::shared_ptr<FileMapping> mapping;
+    std::vector<int64_t> shape;
+  };
+  Context *ctx = new Context{std::move(mapping), std::vector<int64_t>(src.shape, src.shape + src.ndim)};
+  DLManagedTensor *ext = new DLManagedTensor();
+  ext->dl_tensor = src;
+  ext->dl_tensor.shape = ctx->shape.data();
+  ext->manager_ctx = ctx;
+  ext->deleter = +[](DLManagedTensor *self) {
+    delete static_cast<Context *>(self->manager_ctx);
+    delete self;
+  };
+  return Tensor(ext);
+}
+
+// With `mapping`, which must contain `data`, tensors refer to their payloads in place instead of copying them
+inline Any BinaryDeserialize(const uint8_t *data, int64_t size, FuncObj *fn_opaque_deserialize,
+                             const std::shared_ptr<FileMapping> &mapping = nullptr) {
+  BinaryReader in{data, size, 0};
+  if (in.ReadFixed<8, uint64_t>() != kMLCBinaryMagic) {
+    in.Fail("Magic number mismatch");
+  }
+  if (uint32_t version = in.ReadFixed<4, uint32_t>(); version != kMLCBinaryVersion) {
+    in.Fail("Unsupported version");
+  }
+  in.ReadFixed<4, uint32_t>();
+  // Step 1. Opaque objects, which objects may refer to
+  UList opaques;
+  {
+    in.Require(8);
+    BinaryReader trailer{data, size, size - 8};
+    int64_t offset = static_cast<int64_t>(trailer.ReadFixed<8, uint64_t>());
+    if (offset < in.head || offset > size - 8) {
+      trailer.Fail("Invalid offset of opaque objects");
+    }
+    trailer.head = offset;
+    int64_t repr_size = 0;
+    const uint8_t *repr = trailer.ReadBytes(&repr_size);
+    if (repr_size > 0) {
+      if (!fn_opaque_deserialize) {
+        fn_opaque_deserialize = Func::GetGlobal("mlc.Opaque.default.deserialize", true);
+      }
+      if (!fn_opaque_deserialize) {
+        MLC_THROW(ValueError)
+            << "Cannot find deserialization function `mlc.Opaque.default.deserialize`. Register it with "
+               "`mlc.Func.register(\"mlc.Opaque.default.deserialize\")(deserialize_func)`";
+      }
+      opaques = (*fn_opaque_deserialize)(StrFromBytes(repr, repr_size)).operator UList();
+    }
+    in.size = offset;
+  }
+  // Step 2. Objects in topological order
+  std::vector<Any> values;
+  std::vector<int32_t> type_indices;
+  std::vector<Any> args;
+  std::vector<int64_t> shape;
+  auto read_value = [&in, &values]() -> Any {
+    BinaryTag tag = static_cast<BinaryTag>(in.ReadU8());
+    switch (tag) {
+    case BinaryTag::kNone:
+      return Any();
+    case BinaryTag::kFalse:
+      return Any(false);
+    case BinaryTag::kTrue:
+      return Any(true);
+    case BinaryTag::kInt:
+      return Any(in.ReadZigzag());
+    case BinaryTag::kFloat:
+      return Any(in.ReadFixed<8, double>());
+    case BinaryTag::kDevice: {
+      DLDevice device;
+      device.device_type = static_cast<DLDeviceType>(in.ReadVarint());
+      device.device_id = static_cast<int32_t>(in.ReadZigzag());
+      return Any(device);
+    }
+    case BinaryTag::kDType:
+      return Any(in.ReadFixed<4, DLDataType>());
+    case BinaryTag::kObject: {
+      uint64_t index = in.ReadVarint();
+      if (index >= values.size()) {
+        in.Fail("Reference to an object not yet defined");
+      }
+      return values[index];
+    }
+    }
+    in.Fail("Unknown value tag");
+  };
+  while (true) {
+    uint64_t type_ref = in.ReadVarint();
+    if (type_ref == 0) {
+      break;
+    } else if (type_ref == type_indices.size() + 1) {
+      int64_t key_size = 0;
+      const char *key = reinterpret_cast<const char *>(in.ReadBytes(&key_size));
+      type_indices.push_back(Lib::GetTypeIndex(std::string(key, static_cast<size_t>(key_size)).c_str()));
+    } else if (type_ref > type_indices.size()) {
+      in.Fail("Reference to a type key not yet defined");
+    }
+    int32_t type_index = type_indices[type_ref - 1];
+    if (type_index == kMLCStr) {
+      int64_t n = 0;
+      const uint8_t *str = in.ReadBytes(&n);
+      values.push_back(StrFromBytes(str, n));
+    } else if (type_index == kMLCList) {
+      int64_t n = in.ReadSize();
+      UList list;
+      list->reserve(n);
+      for (int64_t i = 0; i < n; ++i) {
+        list->push_back(read_value());
+      }
+      values.push_back(std::move(list));
+    } else if (type_index == kMLCDict) {
+      int64_t n = in.ReadSize();
+      UDict dict;
+      for (int64_t i = 0; i < n; ++i) {
+        Any key = read_value();
+        dict[key] = read_value();
+      }
+      values.push_back(std::move(dict));
+    } else if (type_index == kMLCTensor) {
+      int32_t ndim = static_cast<int32_t>(in.ReadSize());
+      DLDataType dtype = in.ReadFixed<4, DLDataType>();
+      shape.resize(ndim);
+      for (int32_t i = 0; i < ndim; ++i) {
+        shape[i] = in.ReadZigzag();
+      }
+      in.Align(kBinaryTensorAlign);
+      int32_t elem_size = ::mlc::base::DType::Size(dtype);
+      int64_t numel = in.RequireTensor(ndim, shape.data(), elem_size);
+      if (mapping != nullptr && !kIsBigEndian) {
+        DLTensor src{const_cast<uint8_t *>(in.data + in.head), DLDevice{kDLCPU, 0}, ndim, dtype, shape.data(), nullptr,
+                     0};
+        in.head += numel * elem_size;
+        values.push_back(NewMappedCPUTensor(src, mapping));
+      } else {
+        Tensor tensor = NewOwnedCPUTensor(ndim);
+        DLTensor *dst = &tensor->tensor;
+        dst->dtype = dtype;
+        std::copy(shape.begin(), shape.end(), dst->shape);
+        dst->shape[ndim] = -1;
+        dst->data = new uint8_t[numel * elem_size];
+        ReadElemMany(in.data, &in.head, in.size, static_cast<uint8_t *>(dst->data), elem_size, numel);
+        values.push_back(std::move(tensor));
+      }
+    } else if (type_index == kMLCOpaque) {
+      uint64_t index = in.ReadVarint();
+      if (index >= static_cast<uint64_t>(opaques.size())) {
+        in.Fail("Invalid index of opaque object");
+      }
+      values.push_back(opaques[static_cast<int64_t>(index)]);
+    } else {
+      int64_t n = in.ReadSize();
+      args.clear();
+      for (int64_t i = 0; i < n; ++i) {
+        args.push_back(read_value());
+      }
+      Any ret;
+      ::mlc::base::FuncCall(Lib::_init(type_index), static_cast<int32_t>(n), args.data(), &ret);
+      values.push_back(std::move(ret));
+    }
+  }
+  Any ret = read_value();
+  if (in.head != in.size) {
+    in.Fail("Unexpected trailing bytes");
+  }
+  return ret;
 }
 
 } // namespace
@@ -1665,28 +3889,27 @@ namespace mlc {
 namespace registry {
 
 bool StructuralEqual(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode) {
-  try {
-    // TODO: support non objects
-    ::mlc::StructuralEqualImpl(lhs.operator Object *(), rhs.operator Object *(), bind_free_vars);
+  // TODO: support non objects
+  Object *lhs_obj = lhs.operator Object *();
+  Object *rhs_obj = rhs.operator Object *();
+  if (::mlc::StructuralEqualImpl(lhs_obj, rhs_obj, bind_free_vars, /*report=*/false)) {
     return true;
-  } catch (SEqualError &e) {
-    if (assert_mode) {
-      std::ostringstream os;
-      os << "Structural equality check failed at " << e.path << ": " << e.what();
-      MLC_THROW(ValueError) << os.str();
+  } else if (assert_mode) {
+    if (std::string reason = SEqualFailReason(lhs_obj, rhs_obj, bind_free_vars); !reason.empty()) {
+      MLC_THROW(ValueError) << reason;
     }
   }
   return false;
 }
 
 Optional<Str> StructuralEqualFailReason(AnyView lhs, AnyView rhs, bool bind_free_vars) {
-  try {
-    // TODO: support non objects
-    ::mlc::StructuralEqualImpl(lhs.operator Object *(), rhs.operator Object *(), bind_free_vars);
-  } catch (SEqualError &e) {
-    std::ostringstream os;
-    os << "Structural equality check failed at " << e.path << ": " << e.what();
-    return Str(os.str());
+  // TODO: support non objects
+  Object *lhs_obj = lhs.operator Object *();
+  Object *rhs_obj = rhs.operator Object *();
+  if (::mlc::StructuralEqualImpl(lhs_obj, rhs_obj, bind_free_vars, /*report=*/false)) {
+    return Null;
+  } else if (std::string reason = SEqualFailReason(lhs_obj, rhs_obj, bind_free_vars); !reason.empty()) {
+    return Str(reason);
   }
   return Null;
 }
@@ -1696,6 +3919,46 @@ int64_t StructuralHash(AnyView root) {
   return static_cast<int64_t>(::mlc::StructuralHashImpl(root.operator Object *()));
 }
 
+int64_t StructuralHashParallel(AnyView root, int64_t num_threads) {
+  uint64_t hash_value = ::mlc::StructuralHashParallelImpl(root.operator Object *(), NumParallelThreads(num_threads));
+  return static_cast<int64_t>(hash_value);
+}
+
+bool StructuralEqualParallel(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode, int64_t num_threads) {
+  Object *lhs_obj = lhs.operator Object *();
+  Object *rhs_obj = rhs.operator Object *();
+  if (::mlc::StructuralEqualParallelImpl(lhs_obj, rhs_obj, bind_free_vars, NumParallelThreads(num_threads))) {
+    return true;
+  } else if (assert_mode) {
+    // Report the same mismatch as the serial check
+    if (std::string reason = SEqualFailReason(lhs_obj, rhs_obj, bind_free_vars); !reason.empty()) {
+      MLC_THROW(ValueError) << reason;
+    }
+  }
+  return false;
+}
+
+int64_t StructuralHashCached(AnyView root, StructuralHashCache cache) {
+  CacheHashMemo memo(cache.get());
+  uint64_t hash_value = ::mlc::StructuralHashImpl(root.operator Object *(), &memo);
+  if (memo.num_reused > 0 && memo.has_unbound_object_key) {
+    // A reused subtree does not bind its descendants, which may be the keys of a dict outside of it
+    memo.reuse = false;
+    hash_value = ::mlc::StructuralHashImpl(root.operator Object *(), &memo);
+  }
+  return static_cast<int64_t>(hash_value);
+}
+
+Any StructuralIntern(StructuralInternTable table, AnyView obj) {
+  if (obj.type_index < kMLCStaticObjectBegin) {
+    return obj;
+  }
+  Object *object = obj.operator Object *();
+  return InternImpl(table.get(), object, Lib::GetTypeInfo(object->GetTypeIndex()));
+}
+
+Any StructuralInternGraph(StructuralInternTable table, AnyView root) { return InternGraphImpl(table.get(), root); }
+
 Any CopyShallow(AnyView source) { return CopyShallowImpl(source); }
 Any CopyDeep(AnyView source) { return CopyDeepImpl(source); }
 void CopyReplace(int32_t num_args, const AnyView *args, Any *ret) { CopyReplaceImpl(num_args, args, ret); }
@@ -1722,6 +3985,48 @@ Str JSONSerialize(AnyView source, FuncObj *fn_opaque_serialize) {
   return ::mlc::Serialize(source, fn_opaque_serialize);
 }
 
+Str BinarySerialize(AnyView source, FuncObj *fn_opaque_serialize) {
+  return ::mlc::BinarySerialize(source, fn_opaque_serialize);
+}
+
+Any BinaryLoad(const char *path, bool lazy, FuncObj *fn_opaque_deserialize) {
+  auto mapping = std::make_shared<::mlc::FileMapping>(path, lazy);
+  return ::mlc::BinaryDeserialize(mapping->data, mapping->size, fn_opaque_deserialize, mapping);
+}
+
+void JSONSerializeTo(AnyView source, AnyView sink, FuncObj *fn_opaque_serialize) {
+  ::mlc::WithSink(sink, [&](::mlc::core::Sink *sink) {
+    ::mlc::SinkStreamBuf buf(sink);
+    std::ostream os(&buf);
+    os.exceptions(std::ios::badbit); // rethrow errors from the sink
+    ::mlc::Serialize(source, fn_opaque_serialize, os);
+    buf.Finish();
+  });
+}
+
+void BinarySerializeTo(AnyView source, AnyView sink, FuncObj *fn_opaque_serialize) {
+  ::mlc::WithSink(sink, [&](::mlc::core::Sink *sink) {
+    ::mlc::SinkStreamBuf buf(sink);
+    ::mlc::BinarySerialize(source, fn_opaque_serialize, &buf);
+    buf.Finish();
+  });
+}
+
+Any BinaryDeserialize(AnyView data, int64_t num_bytes, FuncObj *fn_opaque_deserialize) {
+  if (data.type_index == kMLCPtr) {
+    if (num_bytes < 0) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: `num_bytes` is required when `data` is a pointer";
+    }
+    return ::mlc::BinaryDeserialize(static_cast<const uint8_t *>(data.operator void *()), num_bytes,
+                                    fn_opaque_deserialize);
+  }
+  StrObj *bytes = data.operator StrObj *();
+  if (num_bytes < 0 || num_bytes > bytes->size()) {
+    num_bytes = bytes->size();
+  }
+  return ::mlc::BinaryDeserialize(reinterpret_cast<const uint8_t *>(bytes->data()), num_bytes, fn_opaque_deserialize);
+}
+
 Str TensorToBytes(const TensorObj *src) {
   return ::mlc::TensorToBytes(&src->tensor); //
 }
@@ -17,6 +17,7 @@ struct OpRegistry {
     auto it = registry.find(name);
     if (it == registry.end()) {
       Op ret(name);
+      ::mlc::base::MakeImmortal(reinterpret_cast<MLCAny *>(ret.get()));
       registry.Set(name, ret);
       return ret;
     }
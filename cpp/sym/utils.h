@@ -12,8 +12,12 @@ static constexpr int64_t kPosInf = std::numeric_limits<int64_t>::max();
 static constexpr int64_t kNegInf = -kPosInf;
 
 struct SymbolicLimits {
-  inline static Expr pos_inf_ = Var("pos_inf", DType::Int(64));
-  inline static Expr neg_inf_ = Var("neg_inf", DType::Int(64));
+  static Expr Immortal(Expr expr) {
+    ::mlc::base::MakeImmortal(reinterpret_cast<MLCAny *>(expr.get()));
+    return expr;
+  }
+  inline static Expr pos_inf_ = Immortal(Var("pos_inf", DType::Int(64)));
+  inline static Expr neg_inf_ = Immortal(Var("neg_inf", DType::Int(64)));
 };
 
 inline Expr pos_inf() { return SymbolicLimits::pos_inf_; }
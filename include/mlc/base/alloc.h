@@ -3,73 +3,202 @@
 
 #include "./utils.h"
 #include <cstring>
+#include <new>
 #include <type_traits>
 
+#ifndef MLC_USE_POOL_ALLOCATOR
+#define MLC_USE_POOL_ALLOCATOR 0
+#endif
+
 namespace mlc {
+namespace base {
+
+// Allocations up to `kPoolMaxBytes` with alignment up to `kPoolAlignment` are served from
+// per-thread size-class free lists (see `MLCPoolAlloc`) when `MLC_USE_POOL_ALLOCATOR` is on.
+constexpr size_t kPoolAlignment = 16;
+constexpr size_t kPoolMaxBytes = 256;
+
+MLC_INLINE constexpr bool PoolFits(size_t num_bytes, size_t alignment) {
+  return MLC_USE_POOL_ALLOCATOR && num_bytes <= kPoolMaxBytes && alignment <= kPoolAlignment;
+}
+
+MLC_INLINE void *PoolAlloc(size_t num_bytes) {
+  if (void *ret = ::MLCPoolAlloc(static_cast<int64_t>(num_bytes))) {
+    return ret;
+  }
+  throw std::bad_alloc();
+}
+
+// Whether an `ArenaScope` is active on the calling thread, so that allocations outside of any scope do
+// not call into the library. Each binary has its own copy, which only sees the scopes it opens.
+inline thread_local bool arena_active = false;
+
+// Returns nullptr unless an `ArenaScope` is active on the calling thread and can serve the request.
+MLC_INLINE void *ArenaAlloc(size_t num_bytes, size_t alignment) {
+  if (!arena_active || alignment > kPoolAlignment) {
+    return nullptr;
+  }
+  return ::MLCArenaAlloc(static_cast<int64_t>(num_bytes));
+}
+
+// Per-type allocation statistics (see `mlc.core.AllocStats`) are only collected when enabled, so the
+// hooks below cost a relaxed load when they are off. Objects pass their address to let the library
+// remember which of them were counted, and how large they are, until they are freed.
+MLC_INLINE bool AllocStatsEnabled() {
+  static int32_t *flag = ::MLCAllocStatsFlag();
+#ifdef _MSC_VER
+  return __iso_volatile_load32(reinterpret_cast<const volatile int *>(flag)) != 0;
+#else
+  return __atomic_load_n(flag, __ATOMIC_RELAXED) != 0;
+#endif
+}
+
+MLC_INLINE void AllocStatsOnAlloc(int32_t type_index, size_t num_bytes, const void *ptr) {
+  if (AllocStatsEnabled()) {
+    ::MLCAllocStatsOnAlloc(type_index, static_cast<int64_t>(num_bytes), ptr);
+  }
+}
+
+MLC_INLINE void AllocStatsOnFree(int32_t type_index, const void *ptr) {
+  if (AllocStatsEnabled()) {
+    ::MLCAllocStatsOnFree(type_index, ptr);
+  }
+}
+
+} // namespace base
 
 template <typename T> struct DefaultObjectAllocator {
   using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+  static constexpr bool kPooled = ::mlc::base::PoolFits(sizeof(Storage), alignof(Storage));
 
   template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
   MLC_INLINE_NO_MSVC static T *New(Args &&...args) {
-    Storage *data = new Storage;
-    try {
-      new (data) T(std::forward<Args>(args)...);
-    } catch (...) {
-      delete data;
-      throw;
+    if (void *data = ::mlc::base::ArenaAlloc(sizeof(Storage), alignof(Storage))) {
+      return Construct(data, DeleterArena, ::MLCArenaFree, sizeof(Storage), std::forward<Args>(args)...);
     }
-    T *ret = reinterpret_cast<T *>(data);
-    ret->_mlc_header.type_index = T::_type_index;
-    ret->_mlc_header.ref_cnt = 0;
-    ret->_mlc_header.v.deleter = DefaultObjectAllocator<T>::Deleter;
-    return ret;
+    return NewNoArena(std::forward<Args>(args)...);
+  }
+
+  // Never allocates from an active `ArenaScope`, which is required if the caller replaces
+  // `_mlc_header.v.deleter` with one that eventually calls `Deleter`.
+  template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+  MLC_INLINE_NO_MSVC static T *NewNoArena(Args &&...args) {
+    void *data = kPooled ? ::mlc::base::PoolAlloc(sizeof(Storage)) : static_cast<void *>(new Storage);
+    return Construct(data, Deleter, FreeStorage, sizeof(Storage), std::forward<Args>(args)...);
   }
 
   template <typename PadType, typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
   MLC_INLINE_NO_MSVC static T *NewWithPad(size_t pad_size, Args &&...args) {
     size_t num_storages = (sizeof(T) + pad_size * sizeof(PadType) + sizeof(Storage) - 1) / sizeof(Storage);
-    Storage *data = new Storage[num_storages];
-    try {
-      new (data) T(std::forward<Args>(args)...);
-    } catch (...) {
-      delete[] data;
-      throw;
+    size_t num_bytes = num_storages * sizeof(Storage);
+    if (void *data = ::mlc::base::ArenaAlloc(num_bytes, alignof(Storage))) {
+      return Construct(data, DeleterArenaWithPad, ::MLCArenaFree, num_bytes, std::forward<Args>(args)...);
     }
-    T *ret = reinterpret_cast<T *>(data);
-    ret->_mlc_header.type_index = T::_type_index;
-    ret->_mlc_header.ref_cnt = 0;
-    ret->_mlc_header.v.deleter = DefaultObjectAllocator<T>::DeleterArray;
-    return ret;
+    if (::mlc::base::PoolFits(num_bytes, alignof(Storage))) {
+      return Construct(::mlc::base::PoolAlloc(num_bytes), DeleterPool, ::MLCPoolFree, num_bytes,
+                       std::forward<Args>(args)...);
+    }
+    return Construct(new Storage[num_storages], DeleterArray, FreeStorageArray, num_bytes,
+                     std::forward<Args>(args)...);
   }
 
   static void Deleter(void *objptr) {
     T *tptr = static_cast<T *>(objptr);
+    ::mlc::base::AllocStatsOnFree(tptr->_mlc_header.type_index, tptr);
     tptr->T::~T();
-    delete reinterpret_cast<Storage *>(tptr);
+    FreeStorage(tptr);
   }
 
   static void DeleterArray(void *objptr) {
     T *tptr = static_cast<T *>(objptr);
+    ::mlc::base::AllocStatsOnFree(tptr->_mlc_header.type_index, tptr);
+    tptr->T::~T();
+    FreeStorageArray(tptr);
+  }
+
+  static void DeleterPool(void *objptr) {
+    T *tptr = static_cast<T *>(objptr);
+    ::mlc::base::AllocStatsOnFree(tptr->_mlc_header.type_index, tptr);
+    tptr->T::~T();
+    ::MLCPoolFree(tptr);
+  }
+
+  static void DeleterArena(void *objptr) {
+    T *tptr = static_cast<T *>(objptr);
+    ::mlc::base::AllocStatsOnFree(tptr->_mlc_header.type_index, tptr);
     tptr->T::~T();
-    delete[] reinterpret_cast<Storage *>(tptr);
+    ::MLCArenaFree(tptr);
+  }
+
+  static void DeleterArenaWithPad(void *objptr) {
+    T *tptr = static_cast<T *>(objptr);
+    ::mlc::base::AllocStatsOnFree(tptr->_mlc_header.type_index, tptr);
+    tptr->T::~T();
+    ::MLCArenaFree(tptr);
+  }
+
+private:
+  template <typename... Args>
+  MLC_INLINE static T *Construct(void *data, MLCDeleterType deleter, MLCDeleterType free_storage, size_t num_bytes,
+                                 Args &&...args) {
+    try {
+      new (data) T(std::forward<Args>(args)...);
+    } catch (...) {
+      free_storage(data);
+      throw;
+    }
+    T *ret = static_cast<T *>(data);
+    ret->_mlc_header.type_index = T::_type_index;
+    ret->_mlc_header.ref_cnt = 0;
+    ret->_mlc_header.v.deleter = deleter;
+    ::mlc::base::AllocStatsOnAlloc(T::_type_index, num_bytes, data);
+    return ret;
+  }
+
+  static void FreeStorage(void *data) {
+    if constexpr (kPooled) {
+      ::MLCPoolFree(data);
+    } else {
+      delete static_cast<Storage *>(data);
+    }
   }
+
+  static void FreeStorageArray(void *data) { delete[] static_cast<Storage *>(data); }
 };
 
 template <typename T> struct PODAllocator;
 
 #define MLC_DEF_POD_ALLOCATOR(Type, TypeIndex, Field)                                                                  \
   template <> struct PODAllocator<Type> {                                                                              \
+    static constexpr bool kPooled = ::mlc::base::PoolFits(sizeof(MLCBoxedPOD), alignof(MLCBoxedPOD));                  \
     MLC_INLINE_NO_MSVC static MLCAny *New(Type data) {                                                                 \
-      MLCBoxedPOD *ret = new MLCBoxedPOD;                                                                              \
+      MLCBoxedPOD *ret =                                                                                               \
+          static_cast<MLCBoxedPOD *>(::mlc::base::ArenaAlloc(sizeof(MLCBoxedPOD), alignof(MLCBoxedPOD)));              \
+      MLCDeleterType deleter = PODAllocator::DeleterArena;                                                             \
+      if (ret == nullptr) {                                                                                            \
+        ret = kPooled ? static_cast<MLCBoxedPOD *>(::mlc::base::PoolAlloc(sizeof(MLCBoxedPOD))) : new MLCBoxedPOD;     \
+        deleter = PODAllocator::Deleter;                                                                               \
+      }                                                                                                                \
       ret->_mlc_header.type_index = static_cast<int32_t>(TypeIndex);                                                   \
       ret->_mlc_header.ref_cnt = 0;                                                                                    \
-      ret->_mlc_header.v.deleter = PODAllocator::Deleter;                                                              \
+      ret->_mlc_header.v.deleter = deleter;                                                                            \
       ret->data.v_int64 = 0;                                                                                           \
       ret->data.Field = data;                                                                                          \
+      ::mlc::base::AllocStatsOnAlloc(static_cast<int32_t>(TypeIndex), sizeof(MLCBoxedPOD), ret);                       \
       return reinterpret_cast<MLCAny *>(ret);                                                                          \
     }                                                                                                                  \
-    static void Deleter(void *objptr) { delete static_cast<MLCBoxedPOD *>(objptr); }                                   \
+    static void DeleterArena(void *objptr) {                                                                           \
+      ::mlc::base::AllocStatsOnFree(static_cast<int32_t>(TypeIndex), objptr);                                          \
+      ::MLCArenaFree(objptr);                                                                                          \
+    }                                                                                                                  \
+    static void Deleter(void *objptr) {                                                                                \
+      ::mlc::base::AllocStatsOnFree(static_cast<int32_t>(TypeIndex), objptr);                                          \
+      if constexpr (kPooled) {                                                                                         \
+        ::MLCPoolFree(objptr);                                                                                         \
+      } else {                                                                                                         \
+        delete static_cast<MLCBoxedPOD *>(objptr);                                                                     \
+      }                                                                                                                \
+    }                                                                                                                  \
   }
 
 MLC_DEF_POD_ALLOCATOR(bool, MLCTypeIndex::kMLCBool, v_bool);
@@ -81,12 +210,34 @@ MLC_DEF_POD_ALLOCATOR(::mlc::base::VoidPtr, MLCTypeIndex::kMLCPtr, v_ptr);
 
 #undef MLC_DEF_POD_ALLOCATOR
 
+// While alive, objects created on the calling thread by `DefaultObjectAllocator` and `PODAllocator`
+// are carved out of a bump arena, and the arena's memory is released in bulk when the scope ends.
+// Objects may escape the scope, e.g. via a `Ref` stored elsewhere: the arena is then promoted and
+// kept until the last of them is freed. Use `NumLive` to detect escapes before the scope ends.
+struct ArenaScope {
+  ArenaScope() : arena_(::MLCArenaPush()), was_active_(::mlc::base::arena_active) {
+    ::mlc::base::arena_active = true;
+  }
+  ~ArenaScope() {
+    ::MLCArenaPop(arena_);
+    ::mlc::base::arena_active = was_active_;
+  }
+  ArenaScope(const ArenaScope &) = delete;
+  ArenaScope &operator=(const ArenaScope &) = delete;
+  int64_t NumLive() const { return ::MLCArenaNumLive(arena_); }
+
+private:
+  void *arena_;
+  bool was_active_;
+};
+
 MLC_INLINE mlc::Object *AllocExternObject(int32_t type_index, int32_t num_bytes) {
   MLCAny *ptr = reinterpret_cast<MLCAny *>(std::malloc(num_bytes));
   std::memset(ptr, 0, num_bytes);
   ptr->type_index = type_index;
   ptr->ref_cnt = 0;
   ptr->v.deleter = MLCExtObjDelete;
+  ::mlc::base::AllocStatsOnAlloc(type_index, static_cast<size_t>(num_bytes), ptr);
   return reinterpret_cast<mlc::Object *>(ptr);
 }
 
@@ -8,8 +8,10 @@
 #ifdef _MSC_VER
 #include <intrin.h>
 #pragma intrinsic(_BitScanReverse64)
+#pragma intrinsic(_BitScanForward64)
 #pragma intrinsic(_InterlockedIncrement)
 #pragma intrinsic(_InterlockedDecrement)
+#pragma intrinsic(_InterlockedExchange)
 #endif
 #if __cplusplus >= 202002L
 #include <bit>
@@ -174,8 +176,33 @@ template <typename _T> struct Type2Str {
   }
 };
 
-MLC_INLINE void IncRef(MLCAny *obj) {
+// Objects with a negative `ref_cnt` are immortal: `IncRef` and `DecRef` only read their header, so that
+// widely shared objects, e.g. registered functions and types, do not bounce a cache line between
+// cores. The sentinel is far from zero, so concurrent updates racing with `MakeImmortal` cannot bring
+// the count back to a positive value.
+constexpr int32_t kImmortalRefCnt = -(1 << 30);
+
+MLC_INLINE bool IsImmortal(const MLCAny *obj) {
+#ifdef _MSC_VER
+  return __iso_volatile_load32(reinterpret_cast<const volatile int *>(&obj->ref_cnt)) < 0;
+#else
+  return __atomic_load_n(&obj->ref_cnt, __ATOMIC_RELAXED) < 0;
+#endif
+}
+
+// Leaks `obj` on purpose: it is never deleted afterwards.
+MLC_INLINE void MakeImmortal(MLCAny *obj) {
   if (obj != nullptr) {
+#ifdef _MSC_VER
+    _InterlockedExchange(reinterpret_cast<volatile long *>(&obj->ref_cnt), kImmortalRefCnt);
+#else
+    __atomic_store_n(&obj->ref_cnt, kImmortalRefCnt, __ATOMIC_RELAXED);
+#endif
+  }
+}
+
+MLC_INLINE void IncRef(MLCAny *obj) {
+  if (obj != nullptr && !IsImmortal(obj)) {
 #ifdef _MSC_VER
     _InterlockedIncrement(reinterpret_cast<volatile long *>(&obj->ref_cnt));
 #else
@@ -197,7 +224,7 @@ MLC_INLINE void IncRef(MLCAny *obj) {
 }
 
 MLC_INLINE void DecRef(MLCAny *obj) {
-  if (obj != nullptr) {
+  if (obj != nullptr && !IsImmortal(obj)) {
 #if MLC_DEBUG_MODE == 1
     {
       int32_t type_index = obj->type_index;
@@ -217,11 +244,12 @@ MLC_INLINE void DecRef(MLCAny *obj) {
     int32_t ref_cnt = __atomic_fetch_sub(&obj->ref_cnt, 1, __ATOMIC_ACQ_REL);
 #endif
     if (ref_cnt == 1 && obj->v.deleter) {
-      obj->v.deleter(obj);
+      ::MLCObjDelete(obj);
     }
   }
 }
 
+// Negative for immortal objects
 MLC_INLINE int32_t RefCount(MLCAny *obj) {
   if (obj == nullptr) {
     return 0;
@@ -249,6 +277,31 @@ MLC_INLINE int32_t CountLeadingZeros(uint64_t x) {
 #endif
 }
 
+MLC_INLINE int32_t CountTrailingZeros(uint64_t x) {
+#if __cplusplus >= 202002L
+  return std::countr_zero(x);
+#elif defined(_MSC_VER)
+  unsigned long trailing_zero = 0;
+  if (_BitScanForward64(&trailing_zero, x)) {
+    return static_cast<int32_t>(trailing_zero);
+  } else {
+    return 64;
+  }
+#else
+  return x == 0 ? 64 : __builtin_ctzll(x);
+#endif
+}
+
+MLC_INLINE int32_t PopCount(uint32_t x) {
+#if __cplusplus >= 202002L
+  return std::popcount(x);
+#elif defined(_MSC_VER)
+  return static_cast<int32_t>(__popcnt(x));
+#else
+  return __builtin_popcount(x);
+#endif
+}
+
 MLC_INLINE uint64_t BitCeil(uint64_t x) {
 #if __cplusplus >= 202002L
   return std::bit_ceil(x);
@@ -295,37 +348,114 @@ MLC_INLINE int32_t StrCompare(const char *a, const char *b, int64_t a_len, int64
   return std::strncmp(a, b, a_len);
 }
 
-inline uint64_t StrHash(const char *str, int64_t length) {
-  const char *it = str;
-  const char *end = str + length;
-  uint64_t result = 0;
-  for (; it + 8 <= end; it += 8) {
-    uint64_t b = (static_cast<uint64_t>(it[0]) << 56) | (static_cast<uint64_t>(it[1]) << 48) |
-                 (static_cast<uint64_t>(it[2]) << 40) | (static_cast<uint64_t>(it[3]) << 32) |
-                 (static_cast<uint64_t>(it[4]) << 24) | (static_cast<uint64_t>(it[5]) << 16) |
-                 (static_cast<uint64_t>(it[6]) << 8) | static_cast<uint64_t>(it[7]);
-    result = HashCombine(result, b);
-  }
-  if (it < end) {
-    uint64_t b = 0;
-    if (it + 4 <= end) {
-      b = (static_cast<uint64_t>(it[0]) << 24) | (static_cast<uint64_t>(it[1]) << 16) |
-          (static_cast<uint64_t>(it[2]) << 8) | static_cast<uint64_t>(it[3]);
-      it += 4;
+// 64-bit hash of arbitrary bytes in the style of wyhash. Input is consumed 8 bytes at a time, in three
+// independent multiply-mix lanes for long inputs, and always read as little-endian so that the output
+// is identical across platforms. Not suitable for cryptographic use.
+constexpr uint64_t kHashSecret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+                                     0x589965cc75374cc3ull};
+
+MLC_INLINE uint64_t HashLoad64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+MLC_INLINE uint64_t HashLoad32(const uint8_t *p) {
+  uint32_t v;
+  std::memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap32(v);
+#endif
+  return v;
+}
+
+// Replaces `a` and `b` with the low and high halves of their 128-bit product
+MLC_INLINE void HashMultiply(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_t;
+  uint128_t r = static_cast<uint128_t>(*a) * static_cast<uint128_t>(*b);
+  *a = static_cast<uint64_t>(r);
+  *b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  *a = _umul128(*a, *b, b);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32, la = static_cast<uint32_t>(*a), lb = static_cast<uint32_t>(*b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+MLC_INLINE uint64_t HashMix(uint64_t a, uint64_t b) {
+  HashMultiply(&a, &b);
+  return a ^ b;
+}
+
+// `seed` is expected to be pre-mixed, see `Hash64`
+inline uint64_t HashBytes(const void *data, int64_t length, uint64_t seed) {
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  uint64_t len = static_cast<uint64_t>(length);
+  uint64_t a = 0, b = 0;
+  if (len <= 16) {
+    if (len >= 4) {
+      uint64_t shift = (len >> 3) << 2;
+      a = (HashLoad32(p) << 32) | HashLoad32(p + shift);
+      b = (HashLoad32(p + len - 4) << 32) | HashLoad32(p + len - 4 - shift);
+    } else if (len > 0) {
+      a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
     }
-    if (it + 2 <= end) {
-      b = (b << 16) | (static_cast<uint64_t>(it[0]) << 8) | static_cast<uint64_t>(it[1]);
-      it += 2;
+  } else {
+    uint64_t i = len;
+    if (i > 48) {
+      uint64_t lane1 = seed, lane2 = seed;
+      do {
+        seed = HashMix(HashLoad64(p) ^ kHashSecret[1], HashLoad64(p + 8) ^ seed);
+        lane1 = HashMix(HashLoad64(p + 16) ^ kHashSecret[2], HashLoad64(p + 24) ^ lane1);
+        lane2 = HashMix(HashLoad64(p + 32) ^ kHashSecret[3], HashLoad64(p + 40) ^ lane2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= lane1 ^ lane2;
     }
-    if (it + 1 <= end) {
-      b = (b << 8) | static_cast<uint64_t>(it[0]);
-      it += 1;
+    while (i > 16) {
+      seed = HashMix(HashLoad64(p) ^ kHashSecret[1], HashLoad64(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
     }
-    result = HashCombine(result, b);
+    a = HashLoad64(p + i - 16);
+    b = HashLoad64(p + i - 8);
   }
-  return result;
+  a ^= kHashSecret[1];
+  b ^= seed;
+  HashMultiply(&a, &b);
+  return HashMix(a ^ kHashSecret[0] ^ len, b ^ kHashSecret[1]);
 }
 
+// Equals `HashMix(kHashSecret[0], kHashSecret[1])`, i.e. the pre-mixed seed 0
+constexpr uint64_t kHashSeedZero = 0x1ff5c2923a788d2cull;
+
+inline uint64_t Hash64(const void *data, int64_t length, uint64_t seed = 0) {
+  return HashBytes(data, length, seed ^ HashMix(seed ^ kHashSecret[0], kHashSecret[1]));
+}
+
+struct Hash128Value {
+  uint64_t low;
+  uint64_t high;
+};
+
+// Two independently seeded 64-bit hashes, e.g. for content fingerprints where 64 bits may collide.
+inline Hash128Value Hash128(const void *data, int64_t length) {
+  return Hash128Value{Hash64(data, length, kHashSecret[2]), Hash64(data, length, kHashSecret[3])};
+}
+
+inline uint64_t StrHash(const char *str, int64_t length) { return HashBytes(str, length, kHashSeedZero); }
+
 inline uint64_t StrHash(const char *str) {
   int64_t length = static_cast<int64_t>(std::strlen(str));
   return StrHash(str, length);
@@ -334,7 +464,7 @@ inline uint64_t StrHash(const char *str) {
 inline uint64_t AnyHash(const MLCAny &a) {
   if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr)) {
     const MLCStr *str = reinterpret_cast<MLCStr *>(a.v.v_obj);
-    return ::mlc::base::StrHash(str->data, str->length);
+    return str->hash != 0 ? str->hash : ::mlc::base::StrHash(str->data, str->length);
   }
   union {
     int64_t i64;
@@ -351,6 +481,12 @@ inline bool AnyEqual(const MLCAny &a, const MLCAny &b) {
   if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr)) {
     const MLCStr *str_a = reinterpret_cast<MLCStr *>(a.v.v_obj);
     const MLCStr *str_b = reinterpret_cast<MLCStr *>(b.v.v_obj);
+    if (str_a == str_b) {
+      return true;
+    }
+    if (str_a->hash != 0 && str_b->hash != 0) {
+      return false; // distinct interned strings
+    }
     return ::mlc::base::StrCompare(str_a->data, str_b->data, str_a->length, str_b->length) == 0;
   }
   return a.v.v_int64 == b.v.v_int64;
@@ -85,6 +85,9 @@ typedef enum {
   kMLCStr = 1005,
   kMLCTensor = 1006,
   kMLCOpaque = 1007,
+  kMLCTypedList = 1008,
+  kMLCPersistentList = 1009,
+  kMLCPersistentDict = 1010,
   kMLCCoreEnd = 1100,
   // }
   // kMLCTyping [1100: 1200) {
@@ -151,6 +154,7 @@ typedef struct {
   MLCAny _mlc_header;
   int64_t length;
   char *data;
+  uint64_t hash; // Cached hash of `data` for interned strings, otherwise 0
 } MLCStr;
 
 typedef struct {
@@ -173,6 +177,29 @@ typedef struct {
   int64_t size;
   int8_t frozen;
   void *data;
+  int32_t elem_type_index;
+} MLCTypedList;
+
+typedef struct {
+  MLCAny _mlc_header;
+  int64_t size;
+  void *root;
+} MLCPersistentList;
+
+typedef struct {
+  MLCAny _mlc_header;
+  int64_t size;
+  void *root;
+} MLCPersistentDict;
+
+typedef struct {
+  MLCAny _mlc_header;
+  int64_t capacity;
+  int64_t size;
+  int8_t frozen;
+  int8_t perfect_hash;
+  void *data;
+  int64_t num_deleted;
 } MLCDict;
 
 typedef struct {
@@ -291,6 +318,18 @@ MLC_API int32_t MLCErrorCreate(const char *kind, int64_t num_bytes, const char *
 MLC_API int32_t MLCErrorGetInfo(MLCAny error, int32_t *num_strs, const char ***strs);
 MLC_API int32_t MLCExtObjCreate(int32_t num_bytes, int32_t type_index, MLCAny *ret);
 MLC_API void MLCExtObjDelete(void *objptr);
+MLC_API int32_t MLCStrIntern(const char *str, int64_t length, MLCStr **ret);
+MLC_API void *MLCPoolAlloc(int64_t num_bytes);
+MLC_API void MLCPoolFree(void *ptr);
+MLC_API void *MLCArenaPush();
+MLC_API int64_t MLCArenaPop(void *arena);
+MLC_API int64_t MLCArenaNumLive(void *arena);
+MLC_API void *MLCArenaAlloc(int64_t num_bytes);
+MLC_API void MLCArenaFree(void *ptr);
+MLC_API void MLCObjDelete(MLCAny *obj);
+MLC_API int32_t *MLCAllocStatsFlag();
+MLC_API void MLCAllocStatsOnAlloc(int32_t type_index, int64_t num_bytes, const void *ptr);
+MLC_API void MLCAllocStatsOnFree(int32_t type_index, const void *ptr);
 #ifdef __cplusplus
 } // MLC_EXTERN_C
 #endif
@@ -1,19 +1,25 @@
 #ifndef MLC_CORE_ALL_H_
 #define MLC_CORE_ALL_H_
-#include "./dict.h"         // IWYU pragma: export
-#include "./error.h"        // IWYU pragma: export
-#include "./func.h"         // IWYU pragma: export
-#include "./func_details.h" // IWYU pragma: export
-#include "./list.h"         // IWYU pragma: export
-#include "./object.h"       // IWYU pragma: export
-#include "./object_path.h"  // IWYU pragma: export
-#include "./opaque.h"       // IWYU pragma: export
-#include "./reflection.h"   // IWYU pragma: export
-#include "./str.h"          // IWYU pragma: export
-#include "./tensor.h"       // IWYU pragma: export
-#include "./typing.h"       // IWYU pragma: export
-#include "./utils.h"        // IWYU pragma: export
-#include "./visitor.h"      // IWYU pragma: export
+#include "./dict.h"                    // IWYU pragma: export
+#include "./error.h"                   // IWYU pragma: export
+#include "./func.h"                    // IWYU pragma: export
+#include "./func_details.h"            // IWYU pragma: export
+#include "./list.h"                    // IWYU pragma: export
+#include "./object.h"                  // IWYU pragma: export
+#include "./object_path.h"             // IWYU pragma: export
+#include "./opaque.h"                  // IWYU pragma: export
+#include "./persistent_dict.h"         // IWYU pragma: export
+#include "./persistent_list.h"         // IWYU pragma: export
+#include "./reflection.h"              // IWYU pragma: export
+#include "./sink.h"                    // IWYU pragma: export
+#include "./str.h"                     // IWYU pragma: export
+#include "./structural_hash_cache.h"   // IWYU pragma: export
+#include "./structural_intern_table.h" // IWYU pragma: export
+#include "./tensor.h"                  // IWYU pragma: export
+#include "./typed_list.h"              // IWYU pragma: export
+#include "./typing.h"                  // IWYU pragma: export
+#include "./utils.h"                   // IWYU pragma: export
+#include "./visitor.h"                 // IWYU pragma: export
 #include <iomanip>
 
 namespace mlc {
@@ -53,7 +59,7 @@ template <typename K, typename V> MLC_INLINE_NO_MSVC void NestedTypeCheck<Dict<K
   }
   if constexpr (!std::is_same_v<K, Any> || !std::is_same_v<V, Any>) {
     DictBase *dict = reinterpret_cast<DictBase *>(any.v.v_obj);
-    dict->IterateAll([](uint8_t *, MLCAny *key, MLCAny *value) {
+    dict->IterateAll([](MLCAny *key, MLCAny *value) {
       if constexpr (!std::is_same_v<K, Any>) {
         try {
           NestedTypeCheck<K>::Run(*key);
@@ -105,6 +111,7 @@ MLC_INLINE void DeleteExternObject(Object *objptr) {
       MLC_INLINE void operator()(MLCTypeField *, const char **) {}
     };
     VisitFields(objptr, info, ExternObjDeleter{});
+    ::mlc::base::AllocStatsOnFree(type_index, objptr);
     std::free(objptr);
   } else {
     MLC_THROW(InternalError) << "Cannot find type info for type index: " << type_index;
@@ -1,6 +1,7 @@
 #ifndef MLC_CORE_DICT_H_
 #define MLC_CORE_DICT_H_
 #include "./dict_base.h"
+#include "./list.h"
 #include "./object.h"
 #include "./utils.h"
 #include <initializer_list>
@@ -10,6 +11,8 @@ namespace mlc {
 struct UDictObj : protected ::mlc::core::DictBase {
   template <typename> friend struct ::mlc::core::DictBase::Accessor;
   using Acc = ::mlc::core::DictBase::Accessor<UDictObj>;
+  using Allocator = ::mlc::core::DictBase::Allocator<UDictObj>;
+  using InlineTag = ::mlc::core::DictBase::InlineTag;
   using TKey = Any;
   using TValue = Any;
   using MLCDict::_mlc_header;
@@ -17,9 +20,13 @@ struct UDictObj : protected ::mlc::core::DictBase {
   MLC_INLINE ~UDictObj() = default;
   MLC_INLINE UDictObj(int64_t capacity) : DictBase(capacity) {}
   MLC_INLINE UDictObj() : DictBase() {}
+  MLC_INLINE explicit UDictObj(InlineTag tag) : DictBase(tag) {}
   template <typename Iter> MLC_INLINE UDictObj(Iter begin, Iter end) : DictBase(std::distance(begin, end) * 2) {
     Acc::InsertRange(this, begin, end);
   }
+  template <typename Iter> MLC_INLINE UDictObj(InlineTag tag, Iter begin, Iter end) : DictBase(tag) {
+    Acc::InsertRange(this, begin, end);
+  }
   MLC_INLINE Any &at(const Any &key) { return Acc::At(this, key); }
   MLC_INLINE const Any &at(const Any &key) const { return Acc::At(this, key); }
   MLC_INLINE Any &operator[](const Any &key) { return Acc::Bracket(this, key); }
@@ -28,6 +35,7 @@ struct UDictObj : protected ::mlc::core::DictBase {
   MLC_INLINE bool empty() const { return this->MLCDict::size == 0; }
   MLC_INLINE int64_t count(const Any &key) const { return Acc::Lookup(this, key).IsNone() ? 0 : 1; }
   MLC_INLINE void clear() { this->Clear(); }
+  MLC_INLINE void freeze() { Acc::Freeze(this); }
 
   template <typename State, typename Value> struct Iter {
     friend struct UDictObj;
@@ -82,7 +90,7 @@ struct UDictObj : protected ::mlc::core::DictBase {
     std::ostringstream os;
     bool is_first = true;
     os << '{';
-    this->IterateAll([&](uint8_t *, MLCAny *key, MLCAny *value) {
+    this->IterateAll([&](MLCAny *key, MLCAny *value) {
       if (is_first) {
         is_first = false;
       } else {
@@ -131,6 +139,7 @@ struct UDict : public ObjectRef {
   MLC_INLINE bool empty() const { return get()->empty(); }
   MLC_INLINE int64_t count(const Any &key) const { return get()->count(key); }
   MLC_INLINE void clear() { get()->clear(); }
+  MLC_INLINE void freeze() { get()->freeze(); }
   MLC_INLINE iterator begin() { return get()->begin(); }
   MLC_INLINE iterator end() { return get()->end(); }
   MLC_INLINE reverse_iterator rbegin() { return get()->rbegin(); }
@@ -147,15 +156,27 @@ struct UDict : public ObjectRef {
       .Field("size", &MLCDict::size, /*frozen=*/true)
       .Field("_frozen", &MLCDict::frozen, /*frozen=*/false)
       .Field("data", &MLCDict::data, /*frozen=*/true)
+      .Field("num_deleted", &MLCDict::num_deleted, /*frozen=*/true)
       .StaticFn("__init__", FromAnyTuple)
       .MemFn("_clear", &UDictObj::clear)
+      .MemFn("_freeze", &UDictObj::freeze)
       .MemFn("__str__", &UDictObj::__str__)
       .MemFn("__getitem__", ::mlc::core::DictBase::Accessor<UDictObj>::GetItem)
       .MemFn("__setitem__", ::mlc::core::DictBase::Accessor<UDictObj>::SetItem)
       .MemFn("__delitem__", ::mlc::core::DictBase::Accessor<UDictObj>::Erase)
       .MemFn("__iter_get_key__", ::mlc::core::DictBase::Accessor<UDictObj>::GetKey)
       .MemFn("__iter_get_value__", ::mlc::core::DictBase::Accessor<UDictObj>::GetValue)
-      .MemFn("__iter_advance__", ::mlc::core::DictBase::Accessor<UDictObj>::Advance);
+      .MemFn("__iter_advance__", ::mlc::core::DictBase::Accessor<UDictObj>::Advance)
+      .MemFn("_items", [](UDictObj *self) {
+        // Keys and values interleaved, so that a whole dict crosses the FFI boundary in one call
+        UList ret;
+        ret.reserve(self->size() * 2);
+        for (auto &kv : *self) {
+          ret.push_back(kv.first);
+          ret.push_back(kv.second);
+        }
+        return ret;
+      });
 };
 
 template <typename K, typename V> struct DictObj : protected UDictObj {
@@ -163,6 +184,7 @@ template <typename K, typename V> struct DictObj : protected UDictObj {
   static_assert(::mlc::base::IsContainerElement<V>);
   template <typename, typename> friend struct ::mlc::base::TypeTraits;
   using Acc = ::mlc::core::DictBase::Accessor<UDictObj>;
+  using Allocator = ::mlc::core::DictBase::Allocator<DictObj<K, V>>;
   using TKey = K;
   using TValue = V;
   using UDictObj::_mlc_header;
@@ -177,6 +199,7 @@ template <typename K, typename V> struct DictObj : protected UDictObj {
   using UDictObj::capacity;
   using UDictObj::clear;
   using UDictObj::empty;
+  using UDictObj::freeze;
   using UDictObj::size;
 
   template <bool is_const> struct Iter {
@@ -221,16 +244,27 @@ template <typename K, typename V> struct DictObj : protected UDictObj {
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
   MLC_INLINE DictObj() : UDictObj() {}
+  MLC_INLINE explicit DictObj(InlineTag tag) : UDictObj(tag) {}
   MLC_INLINE DictObj(std::initializer_list<std::pair<K, V>> init) : UDictObj(init.size() * 2) {
     for (const auto &pair : init) {
       UDictObj::operator[](pair.first) = pair.second;
     }
   }
+  MLC_INLINE DictObj(InlineTag tag, std::initializer_list<std::pair<K, V>> init) : UDictObj(tag) {
+    for (const auto &pair : init) {
+      UDictObj::operator[](pair.first) = pair.second;
+    }
+  }
   template <typename Iter> MLC_INLINE DictObj(Iter begin, Iter end) : UDictObj(begin, end) {
     using IterD = typename std::iterator_traits<Iter>::value_type;
     static_assert(std::is_convertible_v<typename std::tuple_element_t<0, IterD>, K>);
     static_assert(std::is_convertible_v<typename std::tuple_element_t<1, IterD>, V>);
   }
+  template <typename Iter> MLC_INLINE DictObj(InlineTag tag, Iter begin, Iter end) : UDictObj(tag, begin, end) {
+    using IterD = typename std::iterator_traits<Iter>::value_type;
+    static_assert(std::is_convertible_v<typename std::tuple_element_t<0, IterD>, K>);
+    static_assert(std::is_convertible_v<typename std::tuple_element_t<1, IterD>, V>);
+  }
   MLC_INLINE const V at(const K &key) const { return UDictObj::at(key); }
   MLC_INLINE const V operator[](const K &key) const { return UDictObj::operator[](key); }
   MLC_INLINE int64_t count(const K &key) const { return UDictObj::count(key); }
@@ -276,6 +310,7 @@ template <typename K, typename V> struct Dict : protected UDict {
   MLC_INLINE int64_t size() const { return get()->size(); }
   MLC_INLINE bool empty() const { return get()->empty(); }
   MLC_INLINE void clear() { get()->clear(); }
+  MLC_INLINE void freeze() { get()->freeze(); }
   MLC_INLINE int64_t capacity() const { return get()->capacity(); }
   MLC_INLINE const V at(const K &key) const { return get()->at(key); }
   MLC_INLINE const V operator[](const K &key) const { return get()->operator[](key); }
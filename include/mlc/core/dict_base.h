@@ -1,8 +1,24 @@
 #ifndef MLC_CORE_DICT_BASE_H_
 #define MLC_CORE_DICT_BASE_H_
+#include <algorithm>
+#include <initializer_list>
 #include <iterator>
 #include <mlc/base/all.h>
 #include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLC_DICT_USE_SSE2 1
+#define MLC_DICT_USE_NEON 0
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MLC_DICT_USE_SSE2 0
+#define MLC_DICT_USE_NEON 1
+#else
+#define MLC_DICT_USE_SSE2 0
+#define MLC_DICT_USE_NEON 0
+#endif
 
 namespace mlc {
 namespace core {
@@ -10,25 +26,46 @@ namespace core {
 struct DictBase : public MLCDict {
   using KVPair = std::pair<MLCAny, MLCAny>;
   using ProxyKVPair = std::pair<const Any, Any>;
-  struct BlockIter;
-  struct Block;
+  struct EntryIter;
+  struct Group;
+  struct GroupMask;
+  struct ProbeSeq;
+  struct IndexTable;
+  struct PerfectHash;
+  template <typename TDictObj> struct Allocator;
+  // Tag of the constructor that places the entries in the object's own allocation, see `Allocator`
+  struct InlineTag {};
   inline DictBase() : MLCDict() {}
   inline explicit DictBase(int64_t capacity);
+  inline explicit DictBase(InlineTag);
   inline ~DictBase() {
-    ::mlc::base::PODArrayFinally finally{this->MLCDict::data};
+    ::mlc::base::PODArrayFinally finally{this->IsSmall() ? nullptr : this->MLCDict::data};
     this->Clear();
   }
   inline void Clear();
-  inline BlockIter Probe(BlockIter cur, uint8_t *result) const;
   template <typename Pred> inline void IterateAll(Pred pred) const;
-  MLC_INLINE BlockIter Head(uint64_t hash) const;
   MLC_INLINE uint64_t Cap() const { return static_cast<uint64_t>(this->MLCDict::capacity); }
   MLC_INLINE uint64_t Size() const { return this->MLCDict::size; }
-  MLC_INLINE Block *Blocks() const { return static_cast<Block *>(this->data); }
+  MLC_INLINE KVPair *Entries() const { return static_cast<KVPair *>(this->data); }
+  // Number of entries in use, including the holes left by erasure
+  MLC_INLINE int64_t NumUsed() const { return this->MLCDict::size + this->MLCDict::num_deleted; }
+  MLC_INLINE static int64_t EntryCapOf(int64_t capacity) { return capacity - capacity / kMaxLoadDen; }
+  MLC_INLINE static int32_t IndexWidthOf(int64_t capacity) { return capacity <= 256 ? 1 : capacity <= 65536 ? 2 : 4; }
+  MLC_INLINE static bool IsHole(const KVPair &kv) { return kv.first.type_index == kHoleTypeIndex; }
+  // Kept apart from `frozen`, which is reflected to Python and may be overwritten there
+  MLC_INLINE bool IsPerfectHash() const { return this->MLCDict::perfect_hash != 0; }
+  // The hashed layout has at least one block, so a smaller capacity means the small layout (or no storage)
+  MLC_INLINE bool IsSmall() const { return this->Cap() < kBlockCapacity && !this->IsPerfectHash(); }
+  MLC_INLINE static uint64_t LoadIndex(const uint8_t *ptr, int64_t width);
+  MLC_INLINE static void StoreIndex(uint8_t *ptr, int64_t width, uint64_t index);
+  // Swaps the storage, but not the object headers, as the two may be allocated differently
   MLC_INLINE void Swap(DictBase *other) {
-    MLCDict tmp = *static_cast<MLCDict *>(other);
-    *static_cast<MLCDict *>(other) = *static_cast<MLCDict *>(this);
-    *static_cast<MLCDict *>(this) = tmp;
+    std::swap(this->MLCDict::capacity, other->MLCDict::capacity);
+    std::swap(this->MLCDict::size, other->MLCDict::size);
+    std::swap(this->MLCDict::frozen, other->MLCDict::frozen);
+    std::swap(this->MLCDict::perfect_hash, other->MLCDict::perfect_hash);
+    std::swap(this->MLCDict::data, other->MLCDict::data);
+    std::swap(this->MLCDict::num_deleted, other->MLCDict::num_deleted);
   }
 
   template <typename TDictObj> struct Accessor {
@@ -47,9 +84,11 @@ struct DictBase : public MLCDict {
       return static_cast<Any &>(TSelf::InsertOrLookup(self, key)->second);
     }
     inline static const Any &Bracket(const TDictObj *self, const Any &key) { return At(self, key); }
-    inline static BlockIter Lookup(const TDictObj *self, const MLCAny &key);
+    inline static EntryIter Lookup(const TDictObj *self, const MLCAny &key);
+    inline static EntryIter LookupFrozen(const TDictObj *self, const MLCAny &key);
+    inline static EntryIter LookupSmall(const TDictObj *self, const MLCAny &key);
+    inline static void Freeze(TDictObj *self);
     inline static int64_t Find(const TDictObj *self, const MLCAny &key);
-    inline static BlockIter Prev(const TDictObj *self, BlockIter iter);
     inline static void New(int32_t num_args, const AnyView *args, Any *any_ret);
     inline static Any GetItem(TDictObj *self, Any key) { return self->at(key); }
     inline static void SetItem(TDictObj *self, Any key, Any value) { (*self)[key] = value; }
@@ -81,63 +120,223 @@ struct DictBase : public MLCDict {
   // clang-format on
 
   static constexpr int32_t kBlockCapacity = 16;
+  // Number of entries stored inline by the small layout
+  static constexpr int64_t kSmallCapacity = 8;
   static constexpr uint8_t kEmptySlot = uint8_t(0b11111111);
-  static constexpr uint8_t kProtectedSlot = uint8_t(0b11111110);
-  static constexpr uint8_t kNewHead = 0b00000000;
-  static constexpr uint8_t kNewTail = 0b10000000;
+  static constexpr uint8_t kDeletedSlot = uint8_t(0b11111110);
+  // Type index of the key of an erased entry
+  static constexpr int32_t kHoleTypeIndex = -1;
+  // Max load factor, counting deleted slots, is `kMaxLoadNum / kMaxLoadDen`
+  static constexpr int64_t kMaxLoadNum = 7;
+  static constexpr int64_t kMaxLoadDen = 8;
   /**
-   * Each block has a 8-byte key (MLCAny), 8-byte value (MLCAny), and a 1-byte metadata.
+   * The dictionary is stored compactly, in the style of CPython, as a single allocation in `data`:
+   * - Entries: `EntryCapOf(capacity)` key-value pairs, appended in insertion order. `Erase` leaves
+   *   a hole (key type index `kHoleTypeIndex`), and `num_deleted` counts the holes, so the first
+   *   `size + num_deleted` entries are in use. Iteration indices are entry indices, with
+   *   `capacity` as the end.
+   * - Index table: `capacity` slots in blocks of 16. A block has 16 metadata bytes followed by 16
+   *   entry indices of `IndexWidthOf(capacity)` bytes each.
+   *
+   * All 16 metadata bytes of a block are matched at once (with SSE2 or NEON when available), and
+   * probing moves from block to block quadratically. Metadata can be one of the following:
+   * - 1) Empty: 0xFF (0b11111111)_2. A lookup that reaches a block with any empty slot stops there.
+   * - 2) Deleted: 0xFE (0b11111110)_2. The slot pointed to an erased entry; lookups continue past it.
+   *   It is reclaimed only by rehashing, so there is exactly one for each hole in the entries.
+   * - 3) Full: (0b0YYYYYYY)_2. The lower 7 bits `YYYYYYY` are a fragment of the key's hash, so that
+   *   a lookup only compares keys whose fragment matches.
    *
-   * Metadata can be one of the following three cases:
-   * - 1) Empty: 0xFF (0b11111111)_2. The slot is available and can be written in.
-   * - 2) Protected: 0xFE (0b11111110)_2. The slot is empty but not allowed to be written. It is
-   *   only used during insertion when relocating certain elements.
-   * - 3) Normal: (0bXYYYYYYY)_2. The highest bit `X` indicates if it is the head of a linked
-   *   list, where `0` means head, and `1` means not head. The next 7 bits `YYYYYYY` are used as
-   *   the "next pointer" (i.e. pointer to the next element),  where `kNextProbeLocation[YYYYYYY]`
-   *   is the offset to the next element. And if `YYYYYYY == 0`, it means the end of the linked
-   *   list.
+   * `Freeze` replaces the index table with a minimal perfect hash (see `PerfectHash`), so that a
+   * lookup compares exactly one key. Entries keep their insertion order, and any modification
+   * through C++ turns the dict back into the hashed layout.
+   *
+   * Most dicts are tiny, so the ones made by `Allocator` with few entries start in the small layout:
+   * `capacity = kSmallCapacity` entries right after the object itself, in the same allocation, and
+   * no index table. Lookups compare keys linearly without hashing, erasure shifts the later entries
+   * down so there are no holes, and inserting into a full small dict moves it to the hashed layout.
    */
-  struct Block {
-    uint8_t meta[kBlockCapacity];
-    KVPair data[kBlockCapacity];
-  };
 };
 
-struct DictBase::BlockIter {
-  /* clang-format off */
-  static inline const constexpr uint64_t kNextProbeLocation[] = {
-      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
-      /* triangle numbers for quadratic probing */ 21, 28, 36, 45, 55, 66, 78, 91, 105, 120, 136, 153, 171, 190, 210, 231, 253, 276, 300, 325, 351, 378, 406, 435, 465, 496, 528, 561, 595, 630, 666, 703, 741, 780, 820, 861, 903, 946, 990, 1035, 1081, 1128, 1176, 1225, 1275, 1326, 1378, 1431, 1485, 1540, 1596, 1653, 1711, 1770, 1830, 1891, 1953, 2016, 2080, 2145, 2211, 2278, 2346, 2415, 2485, 2556, 2628,
-      /* larger triangle numbers */ 8515, 19110, 42778, 96141, 216153, 486591, 1092981, 2458653, 5532801, 12442566, 27993903, 62983476, 141717030, 318844378, 717352503, 1614057336, 3631522476, 8170957530, 18384510628, 41364789378, 93070452520, 209408356380, 471168559170, 1060128894105, 2385289465695, 5366898840628, 12075518705635, 27169915244790, 61132312065111, 137547689707000, 309482283181501, 696335127828753, 1566753995631385, 3525196511162271, 7931691992677701, 17846306936293605, 40154190677507445, 90346928918121501, 203280589587557251, 457381325854679626, 1029107982097042876, 2315492959180353330, 5209859154120846435,
-  };
-  /* clang-format on */
-
-  MLC_INLINE static BlockIter None() { return BlockIter(0, nullptr); }
-  MLC_INLINE static BlockIter FromIndex(const MLCDict *self, uint64_t i) {
-    return BlockIter(i, static_cast<Block *>(self->data) + (i / DictBase::kBlockCapacity));
-  }
-  MLC_INLINE static BlockIter FromHash(const MLCDict *self, uint64_t h) {
-    return BlockIter::FromIndex(self,
-                                (11400714819323198485ull * h) >> (::mlc::base::CountLeadingZeros(self->capacity) + 1));
-  }
-  MLC_INLINE auto &Data() const { return cur->data[i % DictBase::kBlockCapacity]; }
-  MLC_INLINE uint8_t &Meta() const { return cur->meta[i % DictBase::kBlockCapacity]; }
-  MLC_INLINE uint64_t Offset() const { return kNextProbeLocation[Meta() & 0b01111111]; }
-  MLC_INLINE bool IsHead() const { return (Meta() & 0b10000000) == 0b00000000; }
-  MLC_INLINE void SetNext(uint8_t jump) const { (Meta() &= 0b10000000) |= jump; }
-  MLC_INLINE void Advance(const MLCDict *self) { *this = WithOffset(self, Offset()); }
-  MLC_INLINE bool IsNone() const { return cur == nullptr; }
-  MLC_INLINE BlockIter WithOffset(const MLCDict *self, uint64_t offset) const {
-    return offset == 0 ? BlockIter::None() : BlockIter::FromIndex(self, (i + offset) & (self->capacity - 1));
-  }
-  MLC_INLINE BlockIter() = default;
-  MLC_INLINE explicit BlockIter(uint64_t i, Block *cur) : i(i), cur(cur) {}
-
-  uint64_t i;
-  Block *cur;
+// A bit mask over the slots of a block, with `1 << kShift` bits per slot.
+struct DictBase::GroupMask {
+#if MLC_DICT_USE_NEON
+  static constexpr int32_t kShift = 2;
+#else
+  static constexpr int32_t kShift = 0;
+#endif
+  MLC_INLINE explicit operator bool() const { return bits != 0; }
+  MLC_INLINE int32_t Lowest() const { return ::mlc::base::CountTrailingZeros(bits) >> kShift; }
+  MLC_INLINE int32_t Highest() const { return (63 - ::mlc::base::CountLeadingZeros(bits)) >> kShift; }
+  MLC_INLINE void ClearLowest() { bits &= bits - 1; }
+  // Keeps slots `[j, kBlockCapacity)`
+  MLC_INLINE GroupMask From(int32_t j) const { return GroupMask{bits & (~0ull << (j << kShift))}; }
+  // Keeps slots `[0, j]`
+  MLC_INLINE GroupMask UpTo(int32_t j) const { return GroupMask{bits & (~0ull >> (64 - ((j + 1) << kShift)))}; }
+
+  uint64_t bits;
+};
+
+// Metadata of a block, loaded once and matched against in parallel.
+struct DictBase::Group {
+#if MLC_DICT_USE_SSE2
+  MLC_INLINE explicit Group(const uint8_t *meta) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(meta))) {}
+  MLC_INLINE GroupMask Match(uint8_t h2) const { return ToMask(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl)); }
+  MLC_INLINE GroupMask MatchEmpty() const { return ToMask(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(kEmptySlot)), ctrl)); }
+  MLC_INLINE GroupMask MatchEmptyOrDeleted() const { return ToMask(ctrl); }
+  MLC_INLINE GroupMask MatchFull() const { return GroupMask{ToMask(ctrl).bits ^ 0xFFFFull}; }
+  MLC_INLINE static GroupMask ToMask(__m128i x) { return GroupMask{static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(x)))}; }
+  __m128i ctrl;
+#elif MLC_DICT_USE_NEON
+  MLC_INLINE explicit Group(const uint8_t *meta) : ctrl(vld1q_u8(meta)) {}
+  MLC_INLINE GroupMask Match(uint8_t h2) const { return ToMask(vceqq_u8(ctrl, vdupq_n_u8(h2))); }
+  MLC_INLINE GroupMask MatchEmpty() const { return ToMask(vceqq_u8(ctrl, vdupq_n_u8(kEmptySlot))); }
+  MLC_INLINE GroupMask MatchEmptyOrDeleted() const { return ToMask(vcltq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0))); }
+  MLC_INLINE GroupMask MatchFull() const { return ToMask(vcgeq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0))); }
+  // Narrows each 0x00/0xFF byte to a nibble, and keeps one bit per nibble
+  MLC_INLINE static GroupMask ToMask(uint8x16_t x) {
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(x), 4);
+    return GroupMask{vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull};
+  }
+  uint8x16_t ctrl;
+#else
+  MLC_INLINE explicit Group(const uint8_t *meta) : meta(meta) {}
+  MLC_INLINE GroupMask Match(uint8_t h2) const {
+    uint64_t bits = 0;
+    for (int32_t j = 0; j < kBlockCapacity; ++j) {
+      bits |= static_cast<uint64_t>(meta[j] == h2) << j;
+    }
+    return GroupMask{bits};
+  }
+  MLC_INLINE GroupMask MatchEmpty() const { return Match(kEmptySlot); }
+  MLC_INLINE GroupMask MatchEmptyOrDeleted() const {
+    uint64_t bits = 0;
+    for (int32_t j = 0; j < kBlockCapacity; ++j) {
+      bits |= static_cast<uint64_t>(meta[j] >> 7) << j;
+    }
+    return GroupMask{bits};
+  }
+  MLC_INLINE GroupMask MatchFull() const { return GroupMask{MatchEmptyOrDeleted().bits ^ 0xFFFFull}; }
+  const uint8_t *meta;
+#endif
+};
+
+// Quadratic probing over blocks, which visits every block once as the number of blocks is a power of 2.
+struct DictBase::ProbeSeq {
+  MLC_INLINE explicit ProbeSeq(const MLCDict *self, uint64_t hash) {
+    uint64_t h = 11400714819323198485ull * hash;
+    uint64_t num_blocks = static_cast<uint64_t>(self->capacity) / kBlockCapacity;
+    this->mask = num_blocks - 1;
+    this->block = num_blocks == 1 ? 0 : h >> (::mlc::base::CountLeadingZeros(num_blocks) + 1);
+    this->h2 = static_cast<uint8_t>((h >> 32) & 0b01111111);
+  }
+  MLC_INLINE void Next() { block = (block + (++step)) & mask; }
+
+  uint64_t block;
+  uint64_t mask;
+  uint64_t step = 0;
+  uint8_t h2;
+};
+
+struct DictBase::IndexTable {
+  MLC_INLINE explicit IndexTable(const DictBase *self)
+      : base(reinterpret_cast<uint8_t *>(self->Entries() + EntryCapOf(self->MLCDict::capacity))),
+        width(IndexWidthOf(self->MLCDict::capacity)), stride(kBlockCapacity * (1 + width)) {}
+  MLC_INLINE uint8_t *Meta(uint64_t block) const { return base + block * stride; }
+  MLC_INLINE uint64_t Get(uint64_t block, int32_t j) const {
+    return LoadIndex(Meta(block) + kBlockCapacity + j * width, width);
+  }
+  MLC_INLINE void Set(uint64_t block, int32_t j, uint64_t index) const {
+    StoreIndex(Meta(block) + kBlockCapacity + j * width, width, index);
+  }
+  MLC_INLINE static int64_t NumBytes(int64_t capacity) {
+    return EntryCapOf(capacity) * static_cast<int64_t>(sizeof(KVPair)) + capacity * (1 + IndexWidthOf(capacity));
+  }
+
+  uint8_t *base;
+  int64_t width;
+  int64_t stride;
+};
+
+/**
+ * The frozen layout of `n = capacity` entries, as a single allocation in `data`:
+ * - Entries: `n` key-value pairs in insertion order, without holes.
+ * - Pilots: one `uint32_t` per bucket. Keys are distributed into `NumBuckets(n)` buckets, and the
+ *   pilot of a bucket is chosen to send all of its keys to distinct free slots in `[0, n)`. A bucket
+ *   with a single key points to its slot directly, marked by `kDirect`.
+ * - Slots: `n` entry indices of `IndexWidthOf(n)` bytes each.
+ */
+struct DictBase::PerfectHash {
+  static constexpr uint32_t kDirect = uint32_t(1) << 31;
+  static constexpr uint32_t kMaxPilot = uint32_t(1) << 16;
+  MLC_INLINE explicit PerfectHash(const DictBase *self)
+      : n(self->MLCDict::capacity), num_buckets(NumBuckets(n)),
+        pilots(reinterpret_cast<uint32_t *>(self->Entries() + n)),
+        slots(reinterpret_cast<uint8_t *>(pilots + num_buckets)), width(IndexWidthOf(n)) {}
+  MLC_INLINE static int64_t NumBuckets(int64_t n) { return n / 2 + 1; }
+  MLC_INLINE static int64_t NumBytes(int64_t n) {
+    return n * static_cast<int64_t>(sizeof(KVPair)) + NumBuckets(n) * static_cast<int64_t>(sizeof(uint32_t)) +
+           n * IndexWidthOf(n);
+  }
+  // Maps `x` to `[0, n)` with the high half of `x * n`
+  MLC_INLINE static uint64_t Range(uint64_t x, uint64_t n) {
+    ::mlc::base::HashMultiply(&x, &n);
+    return n;
+  }
+  MLC_INLINE static uint64_t Mix(uint64_t hash) { return ::mlc::base::HashMix(hash, ::mlc::base::kHashSecret[0]); }
+  MLC_INLINE static uint64_t Bucket(uint64_t mixed, int64_t num_buckets) { return Range(mixed, num_buckets); }
+  MLC_INLINE static uint64_t Position(uint64_t mixed, uint32_t pilot, int64_t n) {
+    return Range(::mlc::base::HashMix(mixed ^ ::mlc::base::kHashSecret[1], ::mlc::base::kHashSecret[2] + pilot), n);
+  }
+  MLC_INLINE uint64_t Slot(uint64_t mixed) const {
+    uint32_t pilot = pilots[Bucket(mixed, num_buckets)];
+    return (pilot & kDirect) ? (pilot ^ kDirect) : Position(mixed, pilot, n);
+  }
+  MLC_INLINE uint64_t Get(uint64_t slot) const { return LoadIndex(slots + slot * width, width); }
+
+  int64_t n;
+  int64_t num_buckets;
+  uint32_t *pilots;
+  uint8_t *slots;
+  int64_t width;
+};
+
+struct DictBase::EntryIter {
+  MLC_INLINE static EntryIter None() { return EntryIter(0, nullptr); }
+  MLC_INLINE static EntryIter FromIndex(const DictBase *self, int64_t i) { return EntryIter(i, self->Entries() + i); }
+  MLC_INLINE KVPair &Data() const { return *entry; }
+  MLC_INLINE bool IsNone() const { return entry == nullptr; }
+  MLC_INLINE EntryIter() = default;
+  MLC_INLINE explicit EntryIter(int64_t i, KVPair *entry) : i(i), entry(entry) {}
+
+  int64_t i;
+  KVPair *entry;
 };
 
+MLC_INLINE uint64_t DictBase::LoadIndex(const uint8_t *ptr, int64_t width) {
+  if (width == 1) {
+    return *ptr;
+  } else if (width == 2) {
+    uint16_t ret;
+    std::memcpy(&ret, ptr, sizeof(ret));
+    return ret;
+  }
+  uint32_t ret;
+  std::memcpy(&ret, ptr, sizeof(ret));
+  return ret;
+}
+
+MLC_INLINE void DictBase::StoreIndex(uint8_t *ptr, int64_t width, uint64_t index) {
+  if (width == 1) {
+    *ptr = static_cast<uint8_t>(index);
+  } else if (width == 2) {
+    uint16_t v = static_cast<uint16_t>(index);
+    std::memcpy(ptr, &v, sizeof(v));
+  } else {
+    uint32_t v = static_cast<uint32_t>(index);
+    std::memcpy(ptr, &v, sizeof(v));
+  }
+}
+
 inline DictBase::DictBase(int64_t capacity) : MLCDict() {
   if (capacity == 0) {
     return;
@@ -145,61 +344,86 @@ inline DictBase::DictBase(int64_t capacity) : MLCDict() {
   capacity = (capacity + DictBase::kBlockCapacity - 1) & ~(DictBase::kBlockCapacity - 1);
   capacity = std::max<int64_t>(capacity, DictBase::kBlockCapacity);
   capacity = ::mlc::base::BitCeil(capacity);
-  if ((capacity & (capacity - 1)) != 0 || capacity % DictBase::kBlockCapacity != 0) {
+  if ((capacity & (capacity - 1)) != 0 || capacity % DictBase::kBlockCapacity != 0 || (capacity >> 32) != 0) {
     MLC_THROW(InternalError) << "Invalid capacity: " << capacity;
   }
-  int64_t num_blocks = capacity / DictBase::kBlockCapacity;
   this->MLCDict::capacity = capacity;
   this->MLCDict::size = 0;
   this->MLCDict::frozen = 0;
-  this->MLCDict::data = ::mlc::base::PODArrayCreate<Block>(num_blocks).release();
-  Block *blocks = this->Blocks();
-  for (int64_t i = 0; i < num_blocks; ++i) {
-    std::memset(blocks[i].meta, DictBase::kEmptySlot, sizeof(blocks[i].meta));
+  this->MLCDict::perfect_hash = 0;
+  this->MLCDict::data = ::mlc::base::PODArrayCreate<uint8_t>(IndexTable::NumBytes(capacity)).release();
+  this->MLCDict::num_deleted = 0;
+  IndexTable table(this);
+  for (int64_t i = 0, num_blocks = capacity / DictBase::kBlockCapacity; i < num_blocks; ++i) {
+    std::memset(table.Meta(i), DictBase::kEmptySlot, DictBase::kBlockCapacity);
   }
 }
 
-MLC_INLINE DictBase::BlockIter DictBase::Head(uint64_t hash) const {
-  BlockIter iter = BlockIter::FromHash(this, hash);
-  return iter.IsHead() ? iter : BlockIter::None();
+inline DictBase::DictBase(InlineTag) : MLCDict() {
+  this->MLCDict::capacity = DictBase::kSmallCapacity;
+  this->MLCDict::size = 0;
+  this->MLCDict::frozen = 0;
+  this->MLCDict::perfect_hash = 0;
+  this->MLCDict::data = reinterpret_cast<KVPair *>(this + 1);
+  this->MLCDict::num_deleted = 0;
 }
 
-inline DictBase::BlockIter DictBase::Probe(BlockIter cur, uint8_t *result) const {
-  static constexpr uint8_t kNumProbe = std::size(BlockIter::kNextProbeLocation);
-  static_assert(kNumProbe == 126, "Check assumption");
-  for (uint8_t i = 1; i < kNumProbe && BlockIter::kNextProbeLocation[i] < this->Size(); ++i) {
-    BlockIter next = cur.WithOffset(this, BlockIter::kNextProbeLocation[i]);
-    if (next.Meta() == DictBase::kEmptySlot) {
-      *result = i;
-      return next;
+// Allocates dicts that are expected to stay small in the small layout, and the others as usual.
+// `TDictObj` must add no fields to `DictBase`, so that the inline entries start right after it.
+template <typename TDictObj> struct DictBase::Allocator {
+  using Default = ::mlc::DefaultObjectAllocator<TDictObj>;
+  MLC_INLINE static TDictObj *New() {
+    static_assert(sizeof(TDictObj) == sizeof(DictBase), "The small layout requires no extra fields");
+    return Default::template NewWithPad<KVPair>(DictBase::kSmallCapacity, InlineTag{});
+  }
+  MLC_INLINE static TDictObj *New(int64_t capacity) { return Default::New(capacity); }
+  template <typename Iter> MLC_INLINE static TDictObj *New(Iter begin, Iter end) {
+    if (std::distance(begin, end) <= DictBase::kSmallCapacity) {
+      return Default::template NewWithPad<KVPair>(DictBase::kSmallCapacity, InlineTag{}, begin, end);
     }
+    return Default::New(begin, end);
   }
-  *result = 0;
-  return BlockIter::None();
-}
+  template <typename T> MLC_INLINE static TDictObj *New(std::initializer_list<T> init) {
+    if (static_cast<int64_t>(init.size()) <= DictBase::kSmallCapacity) {
+      return Default::template NewWithPad<KVPair>(DictBase::kSmallCapacity, InlineTag{}, init);
+    }
+    return Default::New(init);
+  }
+};
 
 template <typename Pred> //
 inline void DictBase::IterateAll(Pred pred) const {
-  Block *blocks_ = this->Blocks();
-  int64_t num_blocks = this->MLCDict::capacity / DictBase::kBlockCapacity;
-  for (int64_t i = 0; i < num_blocks; ++i) {
-    for (int j = 0; j < DictBase::kBlockCapacity; ++j) {
-      uint8_t &meta = blocks_[i].meta[j];
-      auto &kv = blocks_[i].data[j];
-      if (meta != DictBase::kEmptySlot && meta != DictBase::kProtectedSlot) {
-        pred(&meta, &kv.first, &kv.second);
-      }
+  KVPair *entries = this->Entries();
+  for (int64_t i = 0, num_used = this->NumUsed(); i < num_used; ++i) {
+    if (!IsHole(entries[i])) {
+      pred(&entries[i].first, &entries[i].second);
     }
   }
 }
 
 inline void DictBase::Clear() {
-  this->IterateAll([](uint8_t *meta, MLCAny *key, MLCAny *value) {
+  if (this->MLCDict::capacity == 0) {
+    return;
+  }
+  this->IterateAll([](MLCAny *key, MLCAny *value) {
     static_cast<Any *>(key)->Reset();
     static_cast<Any *>(value)->Reset();
-    *meta = DictBase::kEmptySlot;
   });
+  if (this->IsPerfectHash()) {
+    // Lookups check `size` first, so the layout stays valid until the next insertion rebuilds it
+    this->MLCDict::size = 0;
+    return;
+  }
+  if (this->IsSmall()) {
+    this->MLCDict::size = 0;
+    return;
+  }
+  IndexTable table(this);
+  for (int64_t i = 0, num_blocks = this->MLCDict::capacity / DictBase::kBlockCapacity; i < num_blocks; ++i) {
+    std::memset(table.Meta(i), DictBase::kEmptySlot, DictBase::kBlockCapacity);
+  }
   this->MLCDict::size = 0;
+  this->MLCDict::num_deleted = 0;
 }
 
 template <typename TDictObj>
@@ -215,18 +439,28 @@ inline void DictBase::Accessor<TDictObj>::InsertRange(TDictObj *self, Iter begin
 template <typename TDictObj> //
 inline void DictBase::Accessor<TDictObj>::WithCapacity(TDictObj *self, int64_t new_cap) {
   Ref<TDictObj> dict = Ref<TDictObj>::New(new_cap);
-  self->IterateAll([dict_ptr = dict.get()](uint8_t *, MLCAny *key, MLCAny *value) {
+  self->IterateAll([dict_ptr = dict.get()](MLCAny *key, MLCAny *value) {
     KVPair *ret = TSelf::InsertOrLookup(dict_ptr, *static_cast<Any *>(key));
     static_cast<Any &>(ret->second) = *static_cast<Any *>(value);
   });
   self->Swap(dict.get());
+  self->MLCDict::frozen = dict->MLCDict::frozen;
 }
 
 template <typename TDictObj> //
 inline DictBase::KVPair *DictBase::Accessor<TDictObj>::InsertOrLookup(TDictObj *self, Any key) {
   KVPair *ret;
   while (!(ret = TSelf::TryInsertOrLookup(self, &key))) {
-    int64_t new_cap = self->MLCDict::capacity == 0 ? DictBase::kBlockCapacity : self->MLCDict::capacity * 2;
+    int64_t cap = self->MLCDict::capacity;
+    int64_t new_cap = cap * 2;
+    if (cap == 0) {
+      new_cap = DictBase::kBlockCapacity;
+    } else if (self->IsPerfectHash()) {
+      new_cap = (self->MLCDict::size + 1) * 2;
+    } else if ((self->MLCDict::size + 1) * 2 <= cap) {
+      // Mostly holes: rehash at the same capacity to reclaim them
+      new_cap = cap;
+    }
     WithCapacity(self, new_cap);
   }
   return ret;
@@ -235,66 +469,50 @@ inline DictBase::KVPair *DictBase::Accessor<TDictObj>::InsertOrLookup(TDictObj *
 template <typename TDictObj> //
 inline DictBase::KVPair *DictBase::Accessor<TDictObj>::TryInsertOrLookup(TDictObj *self, MLCAny *key) {
   DictBase *self_base = static_cast<DictBase *>(self);
-  if (self_base->Cap() == self_base->Size() || self_base->Size() + 1 > self_base->Cap() * 0.99) {
-    return nullptr;
+  if (self_base->IsPerfectHash()) {
+    EntryIter iter = TSelf::LookupFrozen(self, *key);
+    return iter.IsNone() ? nullptr : &iter.Data();
   }
-  // `iter` starts from the head of the linked list
-  BlockIter iter = BlockIter::FromHash(self_base, Hash(*key));
-  uint8_t new_meta = DictBase::kNewHead;
-  // There are three cases over all:
-  // 1) available - `iter` points to an empty slot that we could directly write in;
-  // 2) hit - `iter` points to the head of the linked list which we want to iterate through
-  // 3) relocate - `iter` points to the body of a different linked list, and in this case, we
-  // will have to relocate the elements to make space for the new element
-  if (iter.Meta() == DictBase::kEmptySlot) { // (Case 1) available
-    // Do nothing
-  } else if (iter.IsHead()) { // (Case 2) hit
-    // Point `iter` to the last element of the linked list
-    for (BlockIter prev = iter;; prev = iter) {
-      if (Equal(*key, iter.Data().first)) {
-        return &iter.Data();
-      }
-      iter.Advance(self_base);
-      if (iter.IsNone()) {
-        iter = prev;
-        break;
-      }
+  if (self_base->Cap() < DictBase::kBlockCapacity) {
+    // Small layout: append to the entries if the key is not there and there is room
+    if (EntryIter iter = TSelf::LookupSmall(self, *key); !iter.IsNone()) {
+      return &iter.Data();
     }
-    // Prob at the end of the linked list for the next empty slot
-    BlockIter prev = iter;
-    uint8_t jump;
-    iter = self_base->Probe(iter, &jump);
-    if (jump == 0) {
+    int64_t n = self_base->MLCDict::size;
+    if (n == self_base->MLCDict::capacity) {
       return nullptr;
     }
-    prev.SetNext(jump);
-    new_meta = DictBase::kNewTail;
-  } else {
-    // (Case 3) relocate: Chop the list starting from `iter`, and move it to other locations.
-    BlockIter next = iter, prev = TSelf::Prev(self, iter);
-    // Loop invariant:
-    // - `next` points to the first element of the list we are going to relocate.
-    // - `prev` points to the last element of the list that we are relocating to.
-    for (uint8_t next_meta = DictBase::kProtectedSlot; !next.IsNone(); next_meta = DictBase::kEmptySlot) {
-      // Step 1. Prob for the next empty slot `new_next` after `prev`
-      uint8_t jump;
-      BlockIter new_next = self_base->Probe(prev, &jump);
-      if (jump == 0) {
-        return nullptr;
+    self_base->MLCDict::size += 1;
+    auto &kv = self_base->Entries()[n] = {*key, MLCAny()};
+    key->type_index = 0;
+    key->v.v_int64 = 0;
+    return &kv;
+  }
+  KVPair *entries = self_base->Entries();
+  IndexTable table(self_base);
+  ProbeSeq seq(self_base, Hash(*key));
+  for (;; seq.Next()) {
+    Group group(table.Meta(seq.block));
+    for (GroupMask mask = group.Match(seq.h2); mask; mask.ClearLowest()) {
+      KVPair &kv = entries[table.Get(seq.block, mask.Lowest())];
+      if (Equal(*key, kv.first)) {
+        return &kv;
       }
-      // Step 2. Relocate `next` to `new_next`
-      new_next.Meta() = DictBase::kNewTail;
-      new_next.Data() = {next.Data().first, next.Data().second};
-      std::swap(next_meta, next.Meta());
-      prev.SetNext(jump);
-      // Step 3. Update `prev` -> `new_next`, `next` -> `Advance(next)`
-      prev = new_next;
-      next = next.WithOffset(self_base, BlockIter::kNextProbeLocation[next_meta & 0b01111111]);
+    }
+    if (group.MatchEmpty()) {
+      break;
     }
   }
+  // Not found: append an entry, and point the first empty slot of the last probed block to it
+  int64_t index = self_base->NumUsed();
+  if (index >= EntryCapOf(self_base->MLCDict::capacity)) {
+    return nullptr;
+  }
+  int32_t j = Group(table.Meta(seq.block)).MatchEmpty().Lowest();
+  table.Meta(seq.block)[j] = seq.h2;
+  table.Set(seq.block, j, static_cast<uint64_t>(index));
   self_base->MLCDict::size += 1;
-  iter.Meta() = new_meta;
-  auto &kv = iter.Data() = {*key, MLCAny()};
+  auto &kv = entries[index] = {*key, MLCAny()};
   key->type_index = 0;
   key->v.v_int64 = 0;
   return &kv;
@@ -302,7 +520,7 @@ inline DictBase::KVPair *DictBase::Accessor<TDictObj>::TryInsertOrLookup(TDictOb
 
 template <typename TDictObj> //
 inline Any DictBase::Accessor<TDictObj>::Erase(TDictObj *self, const Any &key) {
-  BlockIter iter = TSelf::Lookup(self, key);
+  EntryIter iter = TSelf::Lookup(self, key);
   if (!iter.IsNone()) {
     Any ret = static_cast<Any &>(iter.Data().second);
     TSelf::_Erase(self, iter.i);
@@ -315,35 +533,41 @@ inline Any DictBase::Accessor<TDictObj>::Erase(TDictObj *self, const Any &key) {
 template <typename TDictObj> //
 inline void DictBase::Accessor<TDictObj>::_Erase(TDictObj *self, int64_t index) {
   DictBase *self_base = static_cast<DictBase *>(self);
-  BlockIter iter = BlockIter::FromIndex(self_base, index);
-  if (uint64_t offset = iter.Offset(); offset != 0) {
-    BlockIter prev = iter;
-    BlockIter next = iter.WithOffset(self_base, offset);
-    while ((offset = next.Offset()) != 0) {
-      prev = next;
-      next = next.WithOffset(self_base, offset);
-    }
-    auto &kv = iter.Data();
+  if (self_base->IsPerfectHash()) {
+    // Rehashing keeps entry indices, as the frozen layout has no holes
+    WithCapacity(self, self_base->MLCDict::size * 2);
+  }
+  KVPair &kv = self_base->Entries()[index];
+  if (self_base->IsSmall()) {
     static_cast<Any &>(kv.first).Reset();
     static_cast<Any &>(kv.second).Reset();
-    kv = next.Data();
-    next.Meta() = DictBase::kEmptySlot;
-    prev.SetNext(0);
-  } else {
-    if (!iter.IsHead()) {
-      TSelf::Prev(self, iter).SetNext(0);
+    std::memmove(static_cast<void *>(&kv), &kv + 1, (self_base->MLCDict::size - index - 1) * sizeof(KVPair));
+    self_base->MLCDict::size -= 1;
+    return;
+  }
+  // Find the slot pointing to the entry, which is on the probe sequence of its key
+  IndexTable table(self_base);
+  bool found = false;
+  for (ProbeSeq seq(self_base, Hash(kv.first)); !found; seq.Next()) {
+    for (GroupMask mask = Group(table.Meta(seq.block)).Match(seq.h2); mask; mask.ClearLowest()) {
+      int32_t j = mask.Lowest();
+      if (table.Get(seq.block, j) == static_cast<uint64_t>(index)) {
+        table.Meta(seq.block)[j] = DictBase::kDeletedSlot;
+        found = true;
+        break;
+      }
     }
-    iter.Meta() = DictBase::kEmptySlot;
-    auto &kv = iter.Data();
-    static_cast<Any &>(kv.first).Reset();
-    static_cast<Any &>(kv.second).Reset();
   }
+  static_cast<Any &>(kv.first).Reset();
+  static_cast<Any &>(kv.second).Reset();
+  kv.first.type_index = DictBase::kHoleTypeIndex;
   self_base->MLCDict::size -= 1;
+  self_base->MLCDict::num_deleted += 1;
 }
 
 template <typename TDictObj> //
 inline Any &DictBase::Accessor<TDictObj>::At(TDictObj *self, const Any &key) {
-  BlockIter iter = TSelf::Lookup(self, key);
+  EntryIter iter = TSelf::Lookup(self, key);
   if (iter.IsNone()) {
     MLC_THROW(KeyError) << key;
   }
@@ -352,7 +576,7 @@ inline Any &DictBase::Accessor<TDictObj>::At(TDictObj *self, const Any &key) {
 
 template <typename TDictObj> //
 inline const Any &DictBase::Accessor<TDictObj>::At(const TDictObj *self, const Any &key) {
-  BlockIter iter = TSelf::Lookup(self, key);
+  EntryIter iter = TSelf::Lookup(self, key);
   if (iter.IsNone()) {
     MLC_THROW(KeyError) << key;
   }
@@ -360,41 +584,177 @@ inline const Any &DictBase::Accessor<TDictObj>::At(const TDictObj *self, const A
 }
 
 template <typename TDictObj>
-inline DictBase::BlockIter DictBase::Accessor<TDictObj>::Lookup(const TDictObj *self, const MLCAny &key) {
+inline DictBase::EntryIter DictBase::Accessor<TDictObj>::Lookup(const TDictObj *self, const MLCAny &key) {
   const DictBase *self_base = static_cast<const DictBase *>(self);
-  if (self_base->Cap() == 0) { // TODO: add a unittest for this case
-    return BlockIter::None();
+  if (self_base->IsPerfectHash()) {
+    return LookupFrozen(self, key);
+  }
+  if (self_base->Cap() < DictBase::kBlockCapacity) {
+    return LookupSmall(self, key);
   }
-  uint64_t hash = Hash(key);
-  for (BlockIter iter = self_base->Head(hash); !iter.IsNone(); iter.Advance(self_base)) {
-    if (Equal(key, iter.Data().first)) {
-      return iter;
+  KVPair *entries = self_base->Entries();
+  IndexTable table(self_base);
+  for (ProbeSeq seq(self_base, Hash(key));; seq.Next()) {
+    Group group(table.Meta(seq.block));
+    for (GroupMask mask = group.Match(seq.h2); mask; mask.ClearLowest()) {
+      int64_t index = static_cast<int64_t>(table.Get(seq.block, mask.Lowest()));
+      if (Equal(key, entries[index].first)) {
+        return EntryIter(index, entries + index);
+      }
+    }
+    if (group.MatchEmpty()) {
+      return EntryIter::None();
     }
   }
-  return BlockIter::None();
 }
 
 template <typename TDictObj>
-inline int64_t DictBase::Accessor<TDictObj>::Find(const TDictObj *self, const MLCAny &key) {
+inline DictBase::EntryIter DictBase::Accessor<TDictObj>::LookupFrozen(const TDictObj *self, const MLCAny &key) {
   const DictBase *self_base = static_cast<const DictBase *>(self);
-  BlockIter iter = Lookup(self, key);
-  return iter.IsNone() ? self_base->MLCDict::capacity : static_cast<int64_t>(iter.i);
+  if (self_base->MLCDict::size == 0) {
+    return EntryIter::None();
+  }
+  PerfectHash table(self_base);
+  int64_t index = static_cast<int64_t>(table.Get(table.Slot(PerfectHash::Mix(Hash(key)))));
+  KVPair *kv = self_base->Entries() + index;
+  return Equal(key, kv->first) ? EntryIter(index, kv) : EntryIter::None();
 }
 
 template <typename TDictObj>
-inline DictBase::BlockIter DictBase::Accessor<TDictObj>::Prev(const TDictObj *self, BlockIter iter) {
+inline DictBase::EntryIter DictBase::Accessor<TDictObj>::LookupSmall(const TDictObj *self, const MLCAny &key) {
   const DictBase *self_base = static_cast<const DictBase *>(self);
-  BlockIter prev = self_base->Head(Hash(iter.Data().first));
-  BlockIter next = prev;
-  for (next.Advance(self_base); next.i != iter.i; prev = next, next.Advance(self_base)) {
+  KVPair *entries = self_base->Entries();
+  int64_t n = self_base->MLCDict::size;
+  // Keys are most often looked up with the very object inserted, e.g. the same `Str`, so a cheap
+  // pass for identical keys saves comparing contents with all the entries before it
+  for (int64_t i = 0; i < n; ++i) {
+    if (key.type_index == entries[i].first.type_index && key.v.v_int64 == entries[i].first.v.v_int64) {
+      return EntryIter(i, entries + i);
+    }
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    if (Equal(key, entries[i].first)) {
+      return EntryIter(i, entries + i);
+    }
   }
-  return prev;
+  return EntryIter::None();
+}
+
+template <typename TDictObj> //
+inline void DictBase::Accessor<TDictObj>::Freeze(TDictObj *self) {
+  using PerfectHash = DictBase::PerfectHash;
+  DictBase *self_base = static_cast<DictBase *>(self);
+  self_base->MLCDict::frozen = 1;
+  if (self_base->IsPerfectHash()) {
+    return;
+  }
+  int64_t n = self_base->MLCDict::size;
+  if (n == 0 || n >= static_cast<int64_t>(PerfectHash::kDirect) || self_base->IsSmall()) {
+    // A linear scan of the small layout is already as fast
+    return;
+  }
+  // Step 1. Sort the entries by bucket, with larger buckets first
+  int64_t num_buckets = PerfectHash::NumBuckets(n);
+  std::vector<KVPair *> entries;
+  std::vector<uint64_t> mixed;
+  std::vector<int64_t> bucket_begin(num_buckets + 1, 0);
+  entries.reserve(n);
+  mixed.reserve(n);
+  for (int64_t i = 0, num_used = self_base->NumUsed(); i < num_used; ++i) {
+    KVPair *kv = self_base->Entries() + i;
+    if (!DictBase::IsHole(*kv)) {
+      entries.push_back(kv);
+      mixed.push_back(PerfectHash::Mix(Hash(kv->first)));
+      bucket_begin[PerfectHash::Bucket(mixed.back(), num_buckets) + 1] += 1;
+    }
+  }
+  for (int64_t b = 0; b < num_buckets; ++b) {
+    bucket_begin[b + 1] += bucket_begin[b];
+  }
+  std::vector<int64_t> members(n);
+  {
+    std::vector<int64_t> cursor(bucket_begin.begin(), bucket_begin.end() - 1);
+    for (int64_t i = 0; i < n; ++i) {
+      members[cursor[PerfectHash::Bucket(mixed[i], num_buckets)]++] = i;
+    }
+  }
+  std::vector<int64_t> buckets(num_buckets);
+  for (int64_t b = 0; b < num_buckets; ++b) {
+    buckets[b] = b;
+  }
+  std::stable_sort(buckets.begin(), buckets.end(), [&](int64_t a, int64_t b) {
+    return bucket_begin[a + 1] - bucket_begin[a] > bucket_begin[b + 1] - bucket_begin[b];
+  });
+  // Step 2. Search for a pilot for each bucket, and fill the remaining slots with singleton buckets
+  std::vector<uint32_t> pilots(num_buckets, 0);
+  std::vector<int64_t> slot_to_entry(n, -1);
+  std::vector<uint64_t> positions;
+  int64_t next_free = 0;
+  for (int64_t b : buckets) {
+    const int64_t *begin = members.data() + bucket_begin[b];
+    const int64_t *end = members.data() + bucket_begin[b + 1];
+    if (end - begin == 0) {
+      break;
+    }
+    if (end - begin == 1) {
+      while (slot_to_entry[next_free] != -1) {
+        ++next_free;
+      }
+      slot_to_entry[next_free] = *begin;
+      pilots[b] = PerfectHash::kDirect | static_cast<uint32_t>(next_free);
+      continue;
+    }
+    for (uint32_t pilot = 0;; ++pilot) {
+      if (pilot == PerfectHash::kMaxPilot) {
+        return; // E.g. distinct keys with equal hashes: keep the hashed layout
+      }
+      positions.clear();
+      for (const int64_t *i = begin; i != end; ++i) {
+        uint64_t pos = PerfectHash::Position(mixed[*i], pilot, n);
+        if (slot_to_entry[pos] != -1 || std::find(positions.begin(), positions.end(), pos) != positions.end()) {
+          break;
+        }
+        positions.push_back(pos);
+      }
+      if (static_cast<int64_t>(positions.size()) == end - begin) {
+        for (int64_t k = 0; k < end - begin; ++k) {
+          slot_to_entry[positions[k]] = begin[k];
+        }
+        pilots[b] = pilot;
+        break;
+      }
+    }
+  }
+  // Step 3. Move the entries into the new layout, which takes over their ownership
+  void *data = ::mlc::base::PODArrayCreate<uint8_t>(PerfectHash::NumBytes(n)).release();
+  KVPair *new_entries = static_cast<KVPair *>(data);
+  for (int64_t i = 0; i < n; ++i) {
+    std::memcpy(static_cast<void *>(new_entries + i), entries[i], sizeof(KVPair));
+  }
+  std::free(self_base->MLCDict::data);
+  self_base->MLCDict::data = data;
+  self_base->MLCDict::capacity = n;
+  self_base->MLCDict::num_deleted = 0;
+  self_base->MLCDict::perfect_hash = 1;
+  PerfectHash table(self_base);
+  std::memcpy(table.pilots, pilots.data(), num_buckets * sizeof(uint32_t));
+  for (int64_t slot = 0; slot < n; ++slot) {
+    DictBase::StoreIndex(table.slots + slot * table.width, table.width, static_cast<uint64_t>(slot_to_entry[slot]));
+  }
+}
+
+template <typename TDictObj>
+inline int64_t DictBase::Accessor<TDictObj>::Find(const TDictObj *self, const MLCAny &key) {
+  const DictBase *self_base = static_cast<const DictBase *>(self);
+  EntryIter iter = Lookup(self, key);
+  return iter.IsNone() ? self_base->MLCDict::capacity : iter.i;
 }
 
 template <typename TDictObj>
 inline void DictBase::Accessor<TDictObj>::New(int32_t num_args, const AnyView *args, Any *any_ret) {
   using TSelf = DictBase::Accessor<TDictObj>;
-  Ref<TDictObj> ret = Ref<TDictObj>::New(num_args * 2);
+  Ref<TDictObj> ret =
+      num_args / 2 <= DictBase::kSmallCapacity ? Ref<TDictObj>::New() : Ref<TDictObj>::New(num_args * 2);
   TDictObj *dict_ptr = ret.get();
   for (int32_t i = 0; i < num_args; i += 2) {
     const AnyView *k = args + i;
@@ -407,21 +767,21 @@ inline void DictBase::Accessor<TDictObj>::New(int32_t num_args, const AnyView *a
 
 template <bool is_const> //
 inline DictBase::IterState<is_const> DictBase::IterState<is_const>::Add() const {
-  int64_t cap = self->Cap();
-  int64_t new_i = this->i;
-  while (++new_i < cap) {
-    if (DictBase::BlockIter::FromIndex(self, new_i).Meta() != DictBase::kEmptySlot) {
+  const KVPair *entries = self->Entries();
+  int64_t num_used = self->NumUsed();
+  for (int64_t new_i = this->i + 1; new_i < num_used; ++new_i) {
+    if (!DictBase::IsHole(entries[new_i])) {
       return TSelf{self, new_i};
     }
   }
-  return TSelf{self, cap};
+  return TSelf{self, self->MLCDict::capacity};
 }
 
 template <bool is_const> //
 inline DictBase::IterState<is_const> DictBase::IterState<is_const>::Sub() const {
-  int64_t new_i = this->i;
-  while (--new_i >= 0) {
-    if (DictBase::BlockIter::FromIndex(self, new_i).Meta() != DictBase::kEmptySlot) {
+  const KVPair *entries = self->Entries();
+  for (int64_t new_i = std::min(this->i, self->NumUsed()) - 1; new_i >= 0; --new_i) {
+    if (!DictBase::IsHole(entries[new_i])) {
       return TSelf{self, new_i};
     }
   }
@@ -430,19 +790,17 @@ inline DictBase::IterState<is_const> DictBase::IterState<is_const>::Sub() const
 
 template <bool is_const> //
 inline typename DictBase::IterState<is_const>::TValue DictBase::IterState<is_const>::At() const {
-  return reinterpret_cast<TValue>(DictBase::BlockIter::FromIndex(self, this->i).Data());
+  return reinterpret_cast<TValue>(DictBase::EntryIter::FromIndex(self, this->i).Data());
 }
 
 template <bool is_const> //
 inline typename DictBase::IterState<is_const>::TValuePtr DictBase::IterState<is_const>::Ptr() const {
-  auto &ret = DictBase::BlockIter::FromIndex(self, this->i).Data();
+  auto &ret = DictBase::EntryIter::FromIndex(self, this->i).Data();
   return reinterpret_cast<TValuePtr>(&ret);
 }
 
-static_assert(sizeof(DictBase::Block) == DictBase::kBlockCapacity * (1 + sizeof(MLCAny) * 2), "ABI check");
-static_assert(std::is_aggregate_v<DictBase::Block>, "ABI check");
-static_assert(std::is_trivially_destructible_v<DictBase::Block>, "ABI check");
-static_assert(std::is_standard_layout_v<DictBase::Block>, "ABI check");
+static_assert(sizeof(DictBase::KVPair) == sizeof(MLCAny) * 2, "ABI check");
+static_assert(std::is_standard_layout_v<MLCAny>, "ABI check");
 
 } // namespace core
 } // namespace mlc
@@ -166,7 +166,7 @@ public:
 #define MLC_DEF_OBJ_REF_COW_()                                                                                         \
   inline TObj *CopyOnWrite() {                                                                                         \
     ::mlc::base::PtrBase *obj_ref = this;                                                                              \
-    if (::mlc::base::RefCount(obj_ref->ptr) > 1) {                                                                     \
+    if (int32_t ref_cnt = ::mlc::base::RefCount(obj_ref->ptr); ref_cnt > 1 || ref_cnt < 0) {                           \
       Ref<TObj>::New(*reinterpret_cast<TObj *>(obj_ref->ptr)).Swap(*obj_ref);                                          \
     }                                                                                                                  \
     return reinterpret_cast<TObj *>(obj_ref->ptr);                                                                     \
@@ -0,0 +1,72 @@
+#ifndef MLC_CORE_PERSISTENT_BASE_H_
+#define MLC_CORE_PERSISTENT_BASE_H_
+
+#include <mlc/base/all.h>
+#include <utility>
+
+namespace mlc {
+namespace core {
+
+// Tree nodes of the persistent containers. They are plain reference-counted C++ objects rather than MLC objects:
+// they never escape into `Any`, and an update only copies the nodes on one root-to-leaf path while every other
+// node is shared between the old and the new version. Nodes are immutable once they are reachable from a container.
+struct PersistentNode {
+  PersistentNode() = default;
+  PersistentNode(const PersistentNode &) : ref_cnt(0) {}
+  PersistentNode &operator=(const PersistentNode &) = delete;
+  virtual ~PersistentNode() = default;
+  int32_t ref_cnt = 0;
+};
+
+template <typename TNode> struct PersistentNodeRef {
+  MLC_INLINE PersistentNodeRef() = default;
+  MLC_INLINE PersistentNodeRef(std::nullptr_t) {}
+  MLC_INLINE explicit PersistentNodeRef(TNode *node) : node(node) { IncRef(node); }
+  MLC_INLINE PersistentNodeRef(const PersistentNodeRef &other) : node(other.node) { IncRef(node); }
+  MLC_INLINE PersistentNodeRef(PersistentNodeRef &&other) : node(other.node) { other.node = nullptr; }
+  MLC_INLINE ~PersistentNodeRef() { DecRef(node); }
+  MLC_INLINE PersistentNodeRef &operator=(PersistentNodeRef other) {
+    std::swap(node, other.node);
+    return *this;
+  }
+  template <typename... Args> MLC_INLINE static PersistentNodeRef New(Args &&...args) {
+    return PersistentNodeRef(new TNode(std::forward<Args>(args)...));
+  }
+  // Transfers the ownership to a raw pointer, which is how `MLCPersistentList` and `MLCPersistentDict` hold roots
+  MLC_INLINE TNode *Release() { return std::exchange(node, nullptr); }
+  MLC_INLINE static PersistentNodeRef Borrow(void *raw) { return PersistentNodeRef(static_cast<TNode *>(raw)); }
+  MLC_INLINE TNode *get() const { return node; }
+  MLC_INLINE TNode *operator->() const { return node; }
+  MLC_INLINE TNode &operator*() const { return *node; }
+  MLC_INLINE explicit operator bool() const { return node != nullptr; }
+  MLC_INLINE bool operator==(const PersistentNodeRef &other) const { return node == other.node; }
+  MLC_INLINE bool operator!=(const PersistentNodeRef &other) const { return node != other.node; }
+
+  MLC_INLINE static void IncRef(PersistentNode *node) {
+    if (node != nullptr) {
+#ifdef _MSC_VER
+      _InterlockedIncrement(reinterpret_cast<volatile long *>(&node->ref_cnt));
+#else
+      __atomic_fetch_add(&node->ref_cnt, 1, __ATOMIC_RELAXED);
+#endif
+    }
+  }
+  MLC_INLINE static void DecRef(PersistentNode *node) {
+    if (node != nullptr) {
+#ifdef _MSC_VER
+      if (_InterlockedDecrement(reinterpret_cast<volatile long *>(&node->ref_cnt)) == 0) {
+#else
+      if (__atomic_fetch_sub(&node->ref_cnt, 1, __ATOMIC_ACQ_REL) == 1) {
+#endif
+        delete node;
+      }
+    }
+  }
+
+  TNode *node = nullptr;
+};
+
+} // namespace core
+} // namespace mlc
+
+#endif // MLC_CORE_PERSISTENT_BASE_H_
@@ -0,0 +1,354 @@
+#ifndef MLC_CORE_PERSISTENT_DICT_H_
+#define MLC_CORE_PERSISTENT_DICT_H_
+
+#include "./list.h"
+#include "./object.h"
+#include "./persistent_base.h"
+#include <vector>
+
+namespace mlc {
+namespace core {
+
+// A persistent dict is a hash array mapped trie (HAMT). Each node consumes `kBits` bits of the key's hash and
+// keeps only its occupied slots, compacted by a 32-bit `bitmap`; a slot holds either one key-value pair or a
+// child node. Keys whose 64-bit hashes fully collide end up in a `collision` node that is scanned linearly.
+// Keys are hashed and compared the same way as in `UDict`.
+struct PersistentDictNode : public PersistentNode {
+  struct Slot {
+    uint64_t hash = 0;
+    Any key;
+    Any value;
+    PersistentNodeRef<PersistentDictNode> child;
+  };
+  uint32_t bitmap = 0;
+  bool collision = false;
+  std::vector<Slot> slots;
+};
+
+struct PersistentDictBase {
+  using Node = PersistentDictNode;
+  using Slot = PersistentDictNode::Slot;
+  using NodeRef = PersistentNodeRef<PersistentDictNode>;
+  static constexpr int32_t kBits = 5;
+
+  // `AnyHash` is the identity on integers and pointers, whose low bits are poorly distributed, so mix it first
+  static uint64_t Hash(const MLCAny &key) {
+    uint64_t h = ::mlc::base::AnyHash(key);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+  MLC_INLINE static uint32_t Bit(uint64_t hash, int32_t shift) { return 1u << ((hash >> shift) & 31); }
+  MLC_INLINE static int32_t Index(const Node *node, uint32_t bit) {
+    return ::mlc::base::PopCount(node->bitmap & (bit - 1));
+  }
+  MLC_INLINE static bool Match(const Slot &slot, uint64_t hash, const MLCAny &key) {
+    return !slot.child && slot.hash == hash && ::mlc::base::AnyEqual(slot.key, key);
+  }
+
+  static const Slot *Find(const Node *node, uint64_t hash, const MLCAny &key) {
+    for (int32_t shift = 0; node != nullptr; shift += kBits) {
+      if (node->collision) {
+        for (const Slot &slot : node->slots) {
+          if (Match(slot, hash, key)) {
+            return &slot;
+          }
+        }
+        return nullptr;
+      }
+      uint32_t bit = Bit(hash, shift);
+      if (!(node->bitmap & bit)) {
+        return nullptr;
+      }
+      const Slot &slot = node->slots[Index(node, bit)];
+      if (!slot.child) {
+        return Match(slot, hash, key) ? &slot : nullptr;
+      }
+      node = slot.child.get();
+    }
+    return nullptr;
+  }
+
+  // Returns a node holding both `a` and `b`, which share the hash bits consumed above `shift`
+  static NodeRef Merge(int32_t shift, Slot a, Slot b) {
+    Node *ret = new Node();
+    NodeRef ref(ret);
+    if (shift >= 64) {
+      ret->collision = true;
+      ret->slots.push_back(std::move(a));
+      ret->slots.push_back(std::move(b));
+      return ref;
+    }
+    uint32_t bit_a = Bit(a.hash, shift);
+    uint32_t bit_b = Bit(b.hash, shift);
+    if (bit_a == bit_b) {
+      ret->bitmap = bit_a;
+      ret->slots.emplace_back();
+      ret->slots.back().child = Merge(shift + kBits, std::move(a), std::move(b));
+    } else {
+      ret->bitmap = bit_a | bit_b;
+      if (bit_b < bit_a) {
+        std::swap(a, b);
+      }
+      ret->slots.push_back(std::move(a));
+      ret->slots.push_back(std::move(b));
+    }
+    return ref;
+  }
+
+  // Returns a copy of `node` with `key` mapped to `value`, setting `*added` if `key` was absent
+  static NodeRef Set(const Node *node, int32_t shift, uint64_t hash, Any key, Any value, bool *added) {
+    if (node == nullptr) {
+      Node *ret = new Node();
+      NodeRef ref(ret);
+      ret->bitmap = Bit(hash, shift);
+      ret->slots.push_back(Slot{hash, std::move(key), std::move(value), NodeRef()});
+      *added = true;
+      return ref;
+    }
+    Node *ret = new Node(*node);
+    NodeRef ref(ret);
+    if (ret->collision) {
+      for (Slot &slot : ret->slots) {
+        if (Match(slot, hash, key)) {
+          slot.value = std::move(value);
+          return ref;
+        }
+      }
+      ret->slots.push_back(Slot{hash, std::move(key), std::move(value), NodeRef()});
+      *added = true;
+      return ref;
+    }
+    uint32_t bit = Bit(hash, shift);
+    int32_t idx = Index(ret, bit);
+    if (!(ret->bitmap & bit)) {
+      ret->bitmap |= bit;
+      ret->slots.insert(ret->slots.begin() + idx, Slot{hash, std::move(key), std::move(value), NodeRef()});
+      *added = true;
+      return ref;
+    }
+    Slot &slot = ret->slots[idx];
+    if (slot.child) {
+      slot.child = Set(slot.child.get(), shift + kBits, hash, std::move(key), std::move(value), added);
+    } else if (Match(slot, hash, key)) {
+      slot.value = std::move(value);
+    } else {
+      Slot existing = std::move(slot);
+      slot = Slot();
+      slot.child = Merge(shift + kBits, std::move(existing), Slot{hash, std::move(key), std::move(value), NodeRef()});
+      *added = true;
+    }
+    return ref;
+  }
+
+  // Returns a copy of `node` without `key`, nullptr if that leaves it empty, or `node` itself if `key` is absent
+  static NodeRef Erase(const Node *node, int32_t shift, uint64_t hash, const MLCAny &key) {
+    NodeRef self(const_cast<Node *>(node));
+    int32_t idx = -1;
+    uint32_t bit = 0;
+    if (node->collision) {
+      for (size_t i = 0; i < node->slots.size(); ++i) {
+        if (Match(node->slots[i], hash, key)) {
+          idx = static_cast<int32_t>(i);
+        }
+      }
+      if (idx == -1) {
+        return self;
+      }
+    } else {
+      bit = Bit(hash, shift);
+      if (!(node->bitmap & bit)) {
+        return self;
+      }
+      idx = Index(node, bit);
+      const Slot &slot = node->slots[idx];
+      if (slot.child) {
+        NodeRef child = Erase(slot.child.get(), shift + kBits, hash, key);
+        if (child == slot.child) {
+          return self;
+        }
+        Node *ret = new Node(*node);
+        NodeRef ref(ret);
+        if (child && !child->collision && child->slots.size() == 1 && !child->slots[0].child) {
+          // Pull a lone pair up into this node, so that tries do not keep chains of single-slot nodes
+          ret->slots[idx] = child->slots[0];
+        } else if (child) {
+          ret->slots[idx].child = std::move(child);
+        } else {
+          ret->bitmap &= ~bit;
+          ret->slots.erase(ret->slots.begin() + idx);
+        }
+        return ref;
+      } else if (!Match(slot, hash, key)) {
+        return self;
+      }
+    }
+    if (node->slots.size() == 1) {
+      return NodeRef();
+    }
+    Node *ret = new Node(*node);
+    NodeRef ref(ret);
+    ret->bitmap &= ~bit;
+    ret->slots.erase(ret->slots.begin() + idx);
+    return ref;
+  }
+
+  template <typename Callback> static void ForEach(const Node *node, Callback &&callback) {
+    if (node == nullptr) {
+      return;
+    }
+    for (const Slot &slot : node->slots) {
+      if (slot.child) {
+        ForEach(slot.child.get(), callback);
+      } else {
+        callback(slot.key, slot.value);
+      }
+    }
+  }
+};
+
+} // namespace core
+
+// `PersistentDictObj` is an immutable dict whose `set` and `erase` return a new dict in O(log n) that shares all
+// untouched nodes with this one. Iteration follows the hash order of the keys rather than the insertion order.
+struct PersistentDictObj : public MLCPersistentDict {
+  using Base = ::mlc::core::PersistentDictBase;
+  using NodeRef = Base::NodeRef;
+
+  PersistentDictObj() : MLCPersistentDict() {
+    this->MLCPersistentDict::size = 0;
+    this->MLCPersistentDict::root = nullptr;
+  }
+  explicit PersistentDictObj(NodeRef root, int64_t size) : PersistentDictObj() {
+    this->MLCPersistentDict::size = size;
+    this->MLCPersistentDict::root = root.Release();
+  }
+  template <typename Iter> PersistentDictObj(Iter first, Iter last) : PersistentDictObj() {
+    NodeRef root;
+    int64_t size = 0;
+    for (; first != last; ++first) {
+      Any key = first->first;
+      bool added = false;
+      uint64_t hash = Base::Hash(key);
+      root = Base::Set(root.get(), 0, hash, std::move(key), Any(first->second), &added);
+      size += added;
+    }
+    this->MLCPersistentDict::size = size;
+    this->MLCPersistentDict::root = root.Release();
+  }
+  PersistentDictObj(const PersistentDictObj &other)
+      : PersistentDictObj(NodeRef::Borrow(other.MLCPersistentDict::root), other.size()) {}
+  ~PersistentDictObj() { NodeRef::DecRef(static_cast<Base::Node *>(this->MLCPersistentDict::root)); }
+
+  MLC_INLINE int64_t size() const { return this->MLCPersistentDict::size; }
+  MLC_INLINE bool empty() const { return this->MLCPersistentDict::size == 0; }
+  // Returns the value mapped to `key`, or nullptr if there is none
+  const Any *find(const Any &key) const {
+    const Base::Slot *slot = Base::Find(this->RootPtr(), Base::Hash(key), key);
+    return slot ? &slot->value : nullptr;
+  }
+  MLC_INLINE int64_t count(const Any &key) const { return this->find(key) != nullptr; }
+  const Any &at(const Any &key) const {
+    if (const Any *value = this->find(key)) {
+      return *value;
+    }
+    MLC_THROW(KeyError) << key;
+    MLC_UNREACHABLE();
+  }
+  MLC_INLINE const Any &operator[](const Any &key) const { return this->at(key); }
+  Ref<PersistentDictObj> set(Any key, Any value) const {
+    bool added = false;
+    uint64_t hash = Base::Hash(key);
+    NodeRef root = Base::Set(this->RootPtr(), 0, hash, std::move(key), std::move(value), &added);
+    return Ref<PersistentDictObj>::New(std::move(root), this->size() + added);
+  }
+  Ref<PersistentDictObj> erase(const Any &key) const {
+    if (this->empty()) {
+      return Ref<PersistentDictObj>::New(*this);
+    }
+    NodeRef root = Base::Erase(this->RootPtr(), 0, Base::Hash(key), key);
+    bool removed = root.get() != this->RootPtr();
+    return Ref<PersistentDictObj>::New(std::move(root), this->size() - removed);
+  }
+  template <typename Callback> MLC_INLINE void ForEach(Callback &&callback) const {
+    Base::ForEach(this->RootPtr(), std::forward<Callback>(callback));
+  }
+
+  std::string __str__() const {
+    std::ostringstream os;
+    bool is_first = true;
+    os << '{';
+    this->ForEach([&](const Any &key, const Any &value) {
+      os << (is_first ? "" : ", ") << key << ": " << value;
+      is_first = false;
+    });
+    os << '}';
+    return os.str();
+  }
+
+  MLC_DEF_STATIC_TYPE(MLC_EXPORTS, PersistentDictObj, Object, MLCTypeIndex::kMLCPersistentDict,
+                      "object.PersistentDict");
+
+private:
+  MLC_INLINE const Base::Node *RootPtr() const {
+    return static_cast<const Base::Node *>(this->MLCPersistentDict::root);
+  }
+};
+
+struct PersistentDict : public ObjectRef {
+  friend std::ostream &operator<<(std::ostream &os, const PersistentDict &self) {
+    os << AnyView(self);
+    return os;
+  }
+  MLC_INLINE PersistentDict() : PersistentDict(PersistentDict::New()) {}
+  MLC_INLINE PersistentDict(std::initializer_list<std::pair<Any, Any>> init)
+      : PersistentDict(PersistentDict::New(init.begin(), init.end())) {}
+  template <typename Iter>
+  MLC_INLINE PersistentDict(Iter first, Iter last) : PersistentDict(PersistentDict::New(first, last)) {}
+  MLC_INLINE int64_t size() const { return get()->size(); }
+  MLC_INLINE bool empty() const { return get()->empty(); }
+  MLC_INLINE const Any *find(const Any &key) const { return get()->find(key); }
+  MLC_INLINE int64_t count(const Any &key) const { return get()->count(key); }
+  MLC_INLINE const Any &at(const Any &key) const { return get()->at(key); }
+  MLC_INLINE const Any &operator[](const Any &key) const { return get()->at(key); }
+  MLC_INLINE PersistentDict set(Any key, Any value) const { return get()->set(std::move(key), std::move(value)); }
+  MLC_INLINE PersistentDict erase(const Any &key) const { return get()->erase(key); }
+  template <typename Callback> MLC_INLINE void ForEach(Callback &&callback) const {
+    get()->ForEach(std::forward<Callback>(callback));
+  }
+  MLC_INLINE static void FromAnyTuple(int32_t num_args, const AnyView *args, Any *ret) {
+    if (num_args % 2 != 0) {
+      MLC_THROW(ValueError) << "Odd number of arguments: " << num_args;
+    }
+    std::vector<std::pair<Any, Any>> items;
+    items.reserve(num_args / 2);
+    for (int32_t i = 0; i < num_args; i += 2) {
+      items.emplace_back(args[i], args[i + 1]);
+    }
+    *ret = Ref<PersistentDictObj>::New(items.begin(), items.end());
+  }
+  MLC_DEF_OBJ_REF(MLC_EXPORTS, PersistentDict, PersistentDictObj, ObjectRef)
+      .Field("size", &MLCPersistentDict::size, /*frozen=*/true)
+      .StaticFn("__init__", FromAnyTuple)
+      .MemFn("__str__", &PersistentDictObj::__str__)
+      .MemFn("__getitem__", [](PersistentDictObj *self, Any key) -> Any { return self->at(key); })
+      .MemFn("__contains__", [](PersistentDictObj *self, Any key) -> bool { return self->count(key); })
+      .MemFn("_set", &PersistentDictObj::set)
+      .MemFn("_erase", [](PersistentDictObj *self, Any key) { return self->erase(key); })
+      .MemFn("_items", [](PersistentDictObj *self) {
+        UList ret;
+        ret.reserve(self->size() * 2);
+        self->ForEach([&ret](const Any &key, const Any &value) {
+          ret.push_back(key);
+          ret.push_back(value);
+        });
+        return ret;
+      });
+};
+
+} // namespace mlc
+
+#endif // MLC_CORE_PERSISTENT_DICT_H_
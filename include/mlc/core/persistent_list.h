@@ -0,0 +1,358 @@
+#ifndef MLC_CORE_PERSISTENT_LIST_H_
+#define MLC_CORE_PERSISTENT_LIST_H_
+
+#include "./list.h"
+#include "./object.h"
+#include "./persistent_base.h"
+#include <vector>
+
+namespace mlc {
+namespace core {
+
+// A persistent list is a B+ tree of chunks: leaves hold up to `kChunk` elements, inner nodes hold up to `kChunk`
+// children, and every node caches the number of elements below it so that indexing descends in O(log n).
+// `Insert` splits full nodes on the way back up; `Erase` drops emptied nodes but never merges underfull ones,
+// so the height is bounded by the largest size the list has ever had.
+struct PersistentListNode : public PersistentNode {
+  static constexpr int32_t kChunk = 32;
+  explicit PersistentListNode(bool is_leaf) : is_leaf(is_leaf) {}
+  bool is_leaf;
+  int32_t count = 0;
+  int64_t size = 0;
+};
+
+struct PersistentListLeaf : public PersistentListNode {
+  PersistentListLeaf() : PersistentListNode(true) {}
+  Any elems[kChunk];
+};
+
+struct PersistentListInner : public PersistentListNode {
+  PersistentListInner() : PersistentListNode(false) {}
+  PersistentNodeRef<PersistentListNode> children[kChunk];
+};
+
+struct PersistentListBase {
+  using Node = PersistentListNode;
+  using Leaf = PersistentListLeaf;
+  using Inner = PersistentListInner;
+  using NodeRef = PersistentNodeRef<PersistentListNode>;
+  static constexpr int32_t kChunk = Node::kChunk;
+
+  // Returns the child of `inner` containing the `*i`-th element, and rebases `*i` onto that child.
+  // `*i == inner->size` is allowed and selects the end of the last child.
+  static int32_t FindChild(const Inner *inner, int64_t *i) {
+    int32_t last = inner->count - 1;
+    for (int32_t c = 0; c < last; ++c) {
+      int64_t size = inner->children[c]->size;
+      if (*i < size) {
+        return c;
+      }
+      *i -= size;
+    }
+    return last;
+  }
+
+  static NodeRef MakeInner(const NodeRef *children, int32_t count) {
+    Inner *ret = new Inner();
+    NodeRef ref(ret);
+    for (int32_t c = 0; c < count; ++c) {
+      ret->children[c] = children[c];
+      ret->size += children[c]->size;
+    }
+    ret->count = count;
+    return ref;
+  }
+
+  static NodeRef Build(Any *first, int64_t numel) {
+    if (numel == 0) {
+      return NodeRef();
+    }
+    std::vector<NodeRef> level;
+    level.reserve((numel + kChunk - 1) / kChunk);
+    for (int64_t begin = 0; begin < numel; begin += kChunk) {
+      Leaf *leaf = new Leaf();
+      level.emplace_back(leaf);
+      int32_t count = static_cast<int32_t>(std::min<int64_t>(kChunk, numel - begin));
+      for (int32_t j = 0; j < count; ++j) {
+        leaf->elems[j] = std::move(first[begin + j]);
+      }
+      leaf->count = count;
+      leaf->size = count;
+    }
+    while (level.size() > 1) {
+      std::vector<NodeRef> next;
+      next.reserve((level.size() + kChunk - 1) / kChunk);
+      for (size_t begin = 0; begin < level.size(); begin += kChunk) {
+        int32_t count = static_cast<int32_t>(std::min<size_t>(kChunk, level.size() - begin));
+        next.push_back(MakeInner(level.data() + begin, count));
+      }
+      level.swap(next);
+    }
+    return level[0];
+  }
+
+  static const Any &At(const Node *node, int64_t i) {
+    while (!node->is_leaf) {
+      const Inner *inner = static_cast<const Inner *>(node);
+      node = inner->children[FindChild(inner, &i)].get();
+    }
+    return static_cast<const Leaf *>(node)->elems[i];
+  }
+
+  static NodeRef Set(const Node *node, int64_t i, Any value) {
+    if (node->is_leaf) {
+      Leaf *ret = new Leaf(*static_cast<const Leaf *>(node));
+      NodeRef ref(ret);
+      ret->elems[i] = std::move(value);
+      return ref;
+    }
+    Inner *ret = new Inner(*static_cast<const Inner *>(node));
+    NodeRef ref(ret);
+    int32_t c = FindChild(ret, &i);
+    ret->children[c] = Set(ret->children[c].get(), i, std::move(value));
+    return ref;
+  }
+
+  // Inserts `value` before the `i`-th element. If `node` is full, it is split in halves: the left half is returned
+  // and the right half is written to `*split`.
+  static NodeRef Insert(const Node *node, int64_t i, Any value, NodeRef *split) {
+    if (node->is_leaf) {
+      const Leaf *leaf = static_cast<const Leaf *>(node);
+      Any elems[kChunk + 1];
+      for (int32_t j = 0; j < i; ++j) {
+        elems[j] = leaf->elems[j];
+      }
+      elems[i] = std::move(value);
+      for (int32_t j = static_cast<int32_t>(i); j < leaf->count; ++j) {
+        elems[j + 1] = leaf->elems[j];
+      }
+      int32_t count = leaf->count + 1;
+      int32_t lhs_count = count <= kChunk ? count : count / 2;
+      Leaf *lhs = new Leaf();
+      NodeRef ret(lhs);
+      for (int32_t j = 0; j < lhs_count; ++j) {
+        lhs->elems[j] = std::move(elems[j]);
+      }
+      lhs->count = lhs_count;
+      lhs->size = lhs_count;
+      if (lhs_count < count) {
+        Leaf *rhs = new Leaf();
+        *split = NodeRef(rhs);
+        for (int32_t j = lhs_count; j < count; ++j) {
+          rhs->elems[j - lhs_count] = std::move(elems[j]);
+        }
+        rhs->count = count - lhs_count;
+        rhs->size = count - lhs_count;
+      }
+      return ret;
+    }
+    const Inner *inner = static_cast<const Inner *>(node);
+    int32_t c = FindChild(inner, &i);
+    NodeRef child_split;
+    NodeRef child = Insert(inner->children[c].get(), i, std::move(value), &child_split);
+    if (!child_split) {
+      Inner *ret = new Inner(*inner);
+      NodeRef ref(ret);
+      ret->children[c] = std::move(child);
+      ret->size += 1;
+      return ref;
+    }
+    NodeRef children[kChunk + 1];
+    int32_t count = 0;
+    for (int32_t j = 0; j < inner->count; ++j) {
+      if (j == c) {
+        children[count++] = std::move(child);
+        children[count++] = std::move(child_split);
+      } else {
+        children[count++] = inner->children[j];
+      }
+    }
+    if (count <= kChunk) {
+      return MakeInner(children, count);
+    }
+    int32_t lhs_count = count / 2;
+    *split = MakeInner(children + lhs_count, count - lhs_count);
+    return MakeInner(children, lhs_count);
+  }
+
+  // Erases the `i`-th element. Returns nullptr if the subtree becomes empty.
+  static NodeRef Erase(const Node *node, int64_t i) {
+    if (node->count == 1 && node->size == 1) {
+      return NodeRef();
+    }
+    if (node->is_leaf) {
+      const Leaf *leaf = static_cast<const Leaf *>(node);
+      Leaf *ret = new Leaf();
+      NodeRef ref(ret);
+      for (int32_t j = 0, k = 0; j < leaf->count; ++j) {
+        if (j != i) {
+          ret->elems[k++] = leaf->elems[j];
+        }
+      }
+      ret->count = leaf->count - 1;
+      ret->size = leaf->size - 1;
+      return ref;
+    }
+    Inner *ret = new Inner(*static_cast<const Inner *>(node));
+    NodeRef ref(ret);
+    int32_t c = FindChild(ret, &i);
+    NodeRef child = Erase(ret->children[c].get(), i);
+    if (child) {
+      ret->children[c] = std::move(child);
+    } else {
+      for (int32_t j = c + 1; j < ret->count; ++j) {
+        ret->children[j - 1] = std::move(ret->children[j]);
+      }
+      ret->count -= 1;
+    }
+    ret->size -= 1;
+    return ref;
+  }
+
+  template <typename Callback> static void ForEach(const Node *node, Callback &&callback) {
+    if (node == nullptr) {
+      return;
+    } else if (node->is_leaf) {
+      const Leaf *leaf = static_cast<const Leaf *>(node);
+      for (int32_t j = 0; j < leaf->count; ++j) {
+        callback(leaf->elems[j]);
+      }
+    } else {
+      const Inner *inner = static_cast<const Inner *>(node);
+      for (int32_t c = 0; c < inner->count; ++c) {
+        ForEach(inner->children[c].get(), callback);
+      }
+    }
+  }
+};
+
+} // namespace core
+
+// `PersistentListObj` is an immutable list whose `set`, `insert`, `erase` and `push_back` return a new list in
+// O(log n) that shares all untouched chunks with this one, making "copy with one element changed" cheap in
+// functional rewriting.
+struct PersistentListObj : public MLCPersistentList {
+  using Base = ::mlc::core::PersistentListBase;
+  using NodeRef = Base::NodeRef;
+
+  PersistentListObj() : MLCPersistentList() {
+    this->MLCPersistentList::size = 0;
+    this->MLCPersistentList::root = nullptr;
+  }
+  explicit PersistentListObj(NodeRef root) : PersistentListObj() {
+    this->MLCPersistentList::size = root ? root->size : 0;
+    this->MLCPersistentList::root = root.Release();
+  }
+  template <typename Iter>
+  PersistentListObj(Iter first, Iter last) : PersistentListObj([first, last]() {
+      std::vector<Any> elems(first, last);
+      return Base::Build(elems.data(), static_cast<int64_t>(elems.size()));
+    }()) {}
+  PersistentListObj(const PersistentListObj &other) : PersistentListObj(other.Root()) {}
+  ~PersistentListObj() { NodeRef::DecRef(static_cast<Base::Node *>(this->MLCPersistentList::root)); }
+
+  MLC_INLINE int64_t size() const { return this->MLCPersistentList::size; }
+  MLC_INLINE bool empty() const { return this->MLCPersistentList::size == 0; }
+  const Any &at(int64_t i) const {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->size());
+    return Base::At(this->RootPtr(), i);
+  }
+  MLC_INLINE const Any &operator[](int64_t i) const { return this->at(i); }
+  Ref<PersistentListObj> set(int64_t i, Any value) const {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->size());
+    return Ref<PersistentListObj>::New(Base::Set(this->RootPtr(), i, std::move(value)));
+  }
+  Ref<PersistentListObj> insert(int64_t i, Any value) const {
+    ::mlc::core::ListBase::ListRangeCheck(i, i, this->size());
+    if (this->empty()) {
+      return Ref<PersistentListObj>::New(Base::Build(&value, 1));
+    }
+    NodeRef split;
+    NodeRef root = Base::Insert(this->RootPtr(), i, std::move(value), &split);
+    if (split) {
+      NodeRef children[2] = {std::move(root), std::move(split)};
+      root = Base::MakeInner(children, 2);
+    }
+    return Ref<PersistentListObj>::New(std::move(root));
+  }
+  Ref<PersistentListObj> erase(int64_t i) const {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->size());
+    NodeRef root = Base::Erase(this->RootPtr(), i);
+    while (root && !root->is_leaf && root->count == 1) {
+      root = NodeRef(static_cast<Base::Inner *>(root.get())->children[0]);
+    }
+    return Ref<PersistentListObj>::New(std::move(root));
+  }
+  MLC_INLINE Ref<PersistentListObj> push_back(Any value) const { return this->insert(this->size(), std::move(value)); }
+  MLC_INLINE Ref<PersistentListObj> pop_back() const { return this->erase(this->size() - 1); }
+  template <typename Callback> MLC_INLINE void ForEach(Callback &&callback) const {
+    Base::ForEach(this->RootPtr(), std::forward<Callback>(callback));
+  }
+
+  std::string __str__() const {
+    std::ostringstream os;
+    bool is_first = true;
+    os << '[';
+    this->ForEach([&](const Any &elem) {
+      os << (is_first ? "" : ", ") << elem;
+      is_first = false;
+    });
+    os << ']';
+    return os.str();
+  }
+
+  MLC_DEF_STATIC_TYPE(MLC_EXPORTS, PersistentListObj, Object, MLCTypeIndex::kMLCPersistentList,
+                      "object.PersistentList");
+
+private:
+  MLC_INLINE const Base::Node *RootPtr() const {
+    return static_cast<const Base::Node *>(this->MLCPersistentList::root);
+  }
+  MLC_INLINE NodeRef Root() const { return NodeRef::Borrow(this->MLCPersistentList::root); }
+};
+
+struct PersistentList : public ObjectRef {
+  friend std::ostream &operator<<(std::ostream &os, const PersistentList &self) {
+    os << AnyView(self);
+    return os;
+  }
+  MLC_INLINE PersistentList() : PersistentList(PersistentList::New()) {}
+  MLC_INLINE PersistentList(std::initializer_list<Any> init)
+      : PersistentList(PersistentList::New(init.begin(), init.end())) {}
+  template <typename Iter>
+  MLC_INLINE PersistentList(Iter first, Iter last) : PersistentList(PersistentList::New(first, last)) {}
+  MLC_INLINE int64_t size() const { return get()->size(); }
+  MLC_INLINE bool empty() const { return get()->empty(); }
+  MLC_INLINE const Any &at(int64_t i) const { return get()->at(i); }
+  MLC_INLINE const Any &operator[](int64_t i) const { return get()->at(i); }
+  MLC_INLINE PersistentList set(int64_t i, Any value) const { return get()->set(i, std::move(value)); }
+  MLC_INLINE PersistentList insert(int64_t i, Any value) const { return get()->insert(i, std::move(value)); }
+  MLC_INLINE PersistentList erase(int64_t i) const { return get()->erase(i); }
+  MLC_INLINE PersistentList push_back(Any value) const { return get()->push_back(std::move(value)); }
+  MLC_INLINE PersistentList pop_back() const { return get()->pop_back(); }
+  template <typename Callback> MLC_INLINE void ForEach(Callback &&callback) const {
+    get()->ForEach(std::forward<Callback>(callback));
+  }
+  MLC_INLINE static void FromAnyTuple(int32_t num_args, const AnyView *args, Any *ret) {
+    *ret = Ref<PersistentListObj>::New(args, args + num_args);
+  }
+  MLC_DEF_OBJ_REF(MLC_EXPORTS, PersistentList, PersistentListObj, ObjectRef)
+      .Field("size", &MLCPersistentList::size, /*frozen=*/true)
+      .StaticFn("__init__", FromAnyTuple)
+      .MemFn("__str__", &PersistentListObj::__str__)
+      .MemFn("__iter_at__", [](PersistentListObj *self, int64_t i) -> Any { return self->at(i); })
+      .MemFn("_set", &PersistentListObj::set)
+      .MemFn("_insert", &PersistentListObj::insert)
+      .MemFn("_erase", &PersistentListObj::erase)
+      .MemFn("_append", &PersistentListObj::push_back)
+      .MemFn("_to_list", [](PersistentListObj *self) {
+        UList ret;
+        ret.reserve(self->size());
+        self->ForEach([&ret](const Any &elem) { ret.push_back(elem); });
+        return ret;
+      });
+};
+
+} // namespace mlc
+
+#endif // MLC_CORE_PERSISTENT_LIST_H_
@@ -0,0 +1,95 @@
+#ifndef MLC_CORE_SINK_H_
+#define MLC_CORE_SINK_H_
+
+#include "./func.h"
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#ifdef _MSC_VER
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace mlc {
+namespace core {
+
+// Destination of streamed serialization. `JSONSerializeTo` and `BinarySerializeTo` hand their output to a sink while
+// the graph is being visited, in chunks of exactly `kChunkSize` bytes except for the last one, so that the whole
+// document is never held in memory. `Flush` is called once after the last chunk.
+struct Sink {
+  static constexpr int64_t kChunkSize = 1 << 16;
+  virtual ~Sink() = default;
+  virtual void Write(const char *data, int64_t size) = 0;
+  virtual void Flush() {}
+};
+
+// Writes to a file descriptor owned by the caller, which is not closed
+struct FDSink : public Sink {
+  explicit FDSink(int fd) : fd(fd) {}
+  void Write(const char *data, int64_t size) override {
+    while (size > 0) {
+#ifdef _MSC_VER
+      int64_t n = ::_write(fd, data, static_cast<unsigned int>(size < INT_MAX ? size : INT_MAX));
+#else
+      int64_t n = ::write(fd, data, static_cast<size_t>(size));
+#endif
+      if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (n < 0) {
+        MLC_THROW(ValueError) << "Failed to write to file descriptor " << fd << ": " << std::strerror(errno);
+      }
+      data += n;
+      size -= n;
+    }
+  }
+  int fd;
+};
+
+// Writes to a file created at `path`, buffered by `std::FILE`
+struct FileSink : public Sink {
+  explicit FileSink(const char *path) : file(std::fopen(path, "wb")) {
+    if (file == nullptr) {
+      MLC_THROW(ValueError) << "Cannot open file for writing: " << path << ": " << std::strerror(errno);
+    }
+  }
+  FileSink(const FileSink &) = delete;
+  FileSink &operator=(const FileSink &) = delete;
+  ~FileSink() { std::fclose(file); }
+  void Write(const char *data, int64_t size) override {
+    if (std::fwrite(data, 1, static_cast<size_t>(size), file) != static_cast<size_t>(size)) {
+      MLC_THROW(ValueError) << "Failed to write to file: " << std::strerror(errno);
+    }
+  }
+  void Flush() override {
+    if (std::fflush(file) != 0) {
+      MLC_THROW(ValueError) << "Failed to flush file: " << std::strerror(errno);
+    }
+  }
+  std::FILE *file;
+};
+
+// Calls `callback(data: void *, size: int)` on each chunk. `data` is valid only during the call.
+struct CallbackSink : public Sink {
+  explicit CallbackSink(Func callback) : callback(std::move(callback)) {}
+  void Write(const char *data, int64_t size) override {
+    callback(static_cast<void *>(const_cast<char *>(data)), size);
+  }
+  Func callback;
+};
+
+inline void JSONSerializeTo(AnyView source, Sink *sink, FuncObj *fn_opaque_serialize = nullptr) {
+  static FuncObj *func = ::mlc::Lib::FuncGetGlobal("mlc.core.JSONSerializeTo");
+  (*func)(source, static_cast<void *>(sink), fn_opaque_serialize);
+}
+
+inline void BinarySerializeTo(AnyView source, Sink *sink, FuncObj *fn_opaque_serialize = nullptr) {
+  static FuncObj *func = ::mlc::Lib::FuncGetGlobal("mlc.core.BinarySerializeTo");
+  (*func)(source, static_cast<void *>(sink), fn_opaque_serialize);
+}
+
+} // namespace core
+} // namespace mlc
+
+#endif // MLC_CORE_SINK_H_
@@ -51,13 +51,14 @@ struct StrObj : public MLCStr {
   MLC_INLINE const char *end() const { return this->data() + this->length(); }
   MLC_INLINE char *begin() { return this->data(); }
   MLC_INLINE char *end() { return this->data() + this->length(); }
-  MLC_INLINE char &back() { return this->data()[this->length() - 1]; }
-  MLC_INLINE char &front() { return this->data()[0]; }
+  MLC_INLINE char &back() { return this->MutableData()[this->length() - 1]; }
+  MLC_INLINE char &front() { return this->MutableData()[0]; }
   MLC_INLINE const char &back() const { return this->data()[this->length() - 1]; }
   MLC_INLINE const char &front() const { return this->data()[0]; }
   MLC_INLINE void pop_back() {
+    char *data = this->MutableData();
     if (this->length() > 0) {
-      this->back() = '\0';
+      data[this->length() - 1] = '\0';
       this->MLCStr::length -= 1;
     }
   }
@@ -74,7 +75,7 @@ struct StrObj : public MLCStr {
     return ::mlc::base::StrCompare(this->MLCStr::data, rhs_str, this->MLCStr::length, rhs_len);
   }
   MLC_INLINE int32_t Compare(const StrObj *other) const {
-    return this->Compare(other->c_str(), other->MLCStr::length); //
+    return this == other ? 0 : this->Compare(other->c_str(), other->MLCStr::length);
   }
   MLC_INLINE int32_t Compare(const std::string &other) const {
     return this->Compare(other.data(), static_cast<int64_t>(other.length()));
@@ -83,7 +84,17 @@ struct StrObj : public MLCStr {
     return this->Compare(other, static_cast<int64_t>(std::strlen(other)));
   }
   MLC_INLINE uint64_t Hash() const {
-    return ::mlc::base::StrHash(this->MLCStr::data, this->MLCStr::length); //
+    uint64_t hash = this->MLCStr::hash;
+    return hash != 0 ? hash : ::mlc::base::StrHash(this->MLCStr::data, this->MLCStr::length);
+  }
+  MLC_INLINE bool IsInterned() const { return this->MLCStr::hash != 0; }
+  // Interned strings are shared and keyed by their content in the intern table, so writing through them would
+  // make later lookups of the same text miss and break the pointer-equality shortcut.
+  MLC_INLINE char *MutableData() {
+    if (this->IsInterned()) {
+      MLC_THROW(ValueError) << "Cannot modify an interned string: " << this->data();
+    }
+    return this->MLCStr::data;
   }
   inline std::vector<std::string_view> Split(char delim) const {
     std::vector<std::string_view> ret;
@@ -164,6 +175,12 @@ struct Str : public ObjectRef {
   template <size_t N>
   MLC_INLINE Str(const ::mlc::base::CharArray<N> &str) : ObjectRef(StrObj::Allocator::New<N>(str)) {}
   MLC_INLINE Str FromEscaped(int64_t N, const char *str);
+  // Returns the unique immortal copy of `str`, whose hash is computed once and cached
+  MLC_INLINE static Str Intern(const char *str, int64_t length);
+  MLC_INLINE static Str Intern(const char *str) { return Intern(str, static_cast<int64_t>(std::strlen(str))); }
+  MLC_INLINE static Str Intern(const std::string &str) {
+    return Intern(str.data(), static_cast<int64_t>(str.length()));
+  }
   MLC_INLINE const char *c_str() const { return this->get()->c_str(); }
   MLC_INLINE const char *data() const { return this->get()->data(); }
   MLC_INLINE int64_t length() const { return this->get()->length(); }
@@ -365,6 +382,12 @@ inline void StrObj::PrintEscape(std::ostream &oss) const {
   oss << '"';
 }
 
+inline Str Str::Intern(const char *str, int64_t length) {
+  MLCStr *ret = nullptr;
+  MLC_CHECK_ERR(::MLCStrIntern(str, length, &ret));
+  return Str(static_cast<StrObj *>(ret));
+}
+
 inline Str Str::FromEscaped(int64_t N, const char *str) {
   std::ostringstream oss;
   if (N < 2 || str[0] != '\"' || str[N - 1] != '\"') {
@@ -0,0 +1,67 @@
+#ifndef MLC_CORE_STRUCTURAL_HASH_CACHE_H_
+#define MLC_CORE_STRUCTURAL_HASH_CACHE_H_
+
+#include "./dict.h"
+#include "./func.h"
+#include "./object.h"
+
+namespace mlc {
+
+// An opt-in memo of structural hashes, so that re-hashing a graph only visits subtrees not hashed before, i.e.
+// Merkle-style. The hash of a subtree is cached only if it is
+// - immutable: every object in it is a frozen `List`/`Dict`, a persistent container, or an object whose fields are
+//   all frozen - or any object at all if the cache is created with `assume_immutable`, which is the caller's promise
+//   that objects are never mutated after construction; and
+// - context-free: it contains no variable or binding node, and no dict keyed by objects, as their hashes depend on
+//   where they appear in the whole graph.
+// Hashes produced with a cache are identical to `StructuralHash`. A cached subtree is not visited, so the objects in
+// it are not bound, and a graph with a dict keyed by such an object is rehashed without reusing the cache. The cache
+// keeps every cached object alive until it is invalidated or cleared. A mutated object, and all of its cached
+// ancestors, must be invalidated by the caller.
+struct StructuralHashCacheObj : public Object {
+  bool assume_immutable;
+  UDict table; // dict[Object, int]
+  int64_t num_hits = 0;
+  int64_t num_misses = 0;
+
+  explicit StructuralHashCacheObj(bool assume_immutable) : assume_immutable(assume_immutable), table() {}
+
+  int64_t Hash(AnyView root) {
+    static FuncObj *func = ::mlc::Lib::FuncGetGlobal("mlc.core.StructuralHashCached");
+    return (*func)(root, this);
+  }
+  void Invalidate(const ObjectRef &obj) {
+    if (auto it = table->find(obj); it != table->end()) {
+      table->erase(it);
+    }
+  }
+  void Clear() {
+    table->clear();
+    num_hits = num_misses = 0;
+  }
+  MLC_DEF_DYN_TYPE(MLC_EXPORTS, StructuralHashCacheObj, Object, "mlc.core.StructuralHashCache");
+};
+
+struct StructuralHashCache : public ObjectRef {
+  MLC_DEF_OBJ_REF(MLC_EXPORTS, StructuralHashCache, StructuralHashCacheObj, ObjectRef)
+      .Field("assume_immutable", &StructuralHashCacheObj::assume_immutable, /*frozen=*/true)
+      .Field("num_hits", &StructuralHashCacheObj::num_hits, /*frozen=*/true)
+      .Field("num_misses", &StructuralHashCacheObj::num_misses, /*frozen=*/true)
+      .StaticFn("__init__", InitOf<StructuralHashCacheObj, bool>)
+      .MemFn("__len__", [](StructuralHashCacheObj *self) -> int64_t { return self->table->size(); })
+      .MemFn("hash", &StructuralHashCacheObj::Hash)
+      .MemFn("invalidate", &StructuralHashCacheObj::Invalidate)
+      .MemFn("clear", &StructuralHashCacheObj::Clear);
+  explicit StructuralHashCache(bool assume_immutable)
+      : StructuralHashCache(StructuralHashCache::New(assume_immutable)) {}
+};
+
+// Drop-in replacement of `StructuralHash` for hash maps whose keys are hashed repeatedly
+struct StructuralHashCached {
+  mutable StructuralHashCache cache;
+  std::size_t operator()(const ObjectRef &obj) const { return cache->Hash(obj); }
+};
+
+} // namespace mlc
+
+#endif // MLC_CORE_STRUCTURAL_HASH_CACHE_H_
@@ -0,0 +1,68 @@
+#ifndef MLC_CORE_STRUCTURAL_INTERN_TABLE_H_
+#define MLC_CORE_STRUCTURAL_INTERN_TABLE_H_
+
+#include "./func.h"
+#include "./object.h"
+#include <unordered_map>
+#include <vector>
+
+namespace mlc {
+
+// Hash-consing of object graphs: maps each object to a canonical representative, so that structurally identical
+// subgraphs are stored once and can be compared by pointer. Two objects share a representative if they are of the
+// same type and all their reflected fields are equal, with children compared by identity, which `InternGraph` makes
+// canonical bottom-up. Thus, unlike `StructuralEqual`, variables are never merged, and expressions are merged only if
+// they refer to the same variables. Strings and typed lists are compared by content. Lists, dicts and types that
+// define a structure are interned; other objects, e.g. tensors, functions and opaque objects, are kept as they are.
+//
+// Interning assumes that objects are not mutated afterwards, as merged objects are shared by all their users.
+struct StructuralInternTableObj : public Object {
+  int64_t num_lookups = 0;
+  int64_t num_merged = 0;
+  int64_t bytes_saved = 0;
+  std::unordered_map<uint64_t, std::vector<ObjectRef>> buckets;
+
+  StructuralInternTableObj() = default;
+
+  // Returns the representative of `obj`, inserting `obj` if it has none. Children are compared by identity, so intern
+  // them first, e.g. when building a graph bottom-up
+  Any Intern(AnyView obj) {
+    static FuncObj *func = ::mlc::Lib::FuncGetGlobal("mlc.core.StructuralIntern");
+    return (*func)(this, obj);
+  }
+  // Interns every object reachable from `root` bottom-up, rewriting fields in place to point to representatives, and
+  // returns the representative of `root`
+  Any InternGraph(AnyView root) {
+    static FuncObj *func = ::mlc::Lib::FuncGetGlobal("mlc.core.StructuralInternGraph");
+    return (*func)(this, root);
+  }
+  int64_t Size() const {
+    int64_t size = 0;
+    for (const auto &kv : buckets) {
+      size += static_cast<int64_t>(kv.second.size());
+    }
+    return size;
+  }
+  void Clear() {
+    buckets.clear();
+    num_lookups = num_merged = bytes_saved = 0;
+  }
+  MLC_DEF_DYN_TYPE(MLC_EXPORTS, StructuralInternTableObj, Object, "mlc.core.StructuralInternTable");
+};
+
+struct StructuralInternTable : public ObjectRef {
+  MLC_DEF_OBJ_REF(MLC_EXPORTS, StructuralInternTable, StructuralInternTableObj, ObjectRef)
+      .Field("num_lookups", &StructuralInternTableObj::num_lookups, /*frozen=*/true)
+      .Field("num_merged", &StructuralInternTableObj::num_merged, /*frozen=*/true)
+      .Field("bytes_saved", &StructuralInternTableObj::bytes_saved, /*frozen=*/true)
+      .StaticFn("__init__", InitOf<StructuralInternTableObj>)
+      .MemFn("__len__", &StructuralInternTableObj::Size)
+      .MemFn("intern", &StructuralInternTableObj::Intern)
+      .MemFn("intern_graph", &StructuralInternTableObj::InternGraph)
+      .MemFn("clear", &StructuralInternTableObj::Clear);
+  StructuralInternTable() : StructuralInternTable(StructuralInternTable::New()) {}
+};
+
+} // namespace mlc
+
+#endif // MLC_CORE_STRUCTURAL_INTERN_TABLE_H_
@@ -136,12 +136,12 @@ private:
 
 struct TensorObj::Allocator {
   MLC_INLINE static TensorObj *New(DLManagedTensor *ext) {
-    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::New(ext);
+    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::NewNoArena(ext);
     ret->_mlc_header.v.deleter = TensorObj::Allocator::Deleter_DLManagedTensor;
     return ret;
   }
   MLC_INLINE static TensorObj *New(DLManagedTensorVersioned *ext) {
-    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::New(ext);
+    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::NewNoArena(ext);
     ret->_mlc_header.v.deleter = TensorObj::Allocator::Deleter_DLManagedTensorVersioned;
     return ret;
   }
@@ -0,0 +1,364 @@
+#ifndef MLC_CORE_TYPED_LIST_H_
+#define MLC_CORE_TYPED_LIST_H_
+
+#include "./list.h"
+#include "./object.h"
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace mlc {
+namespace core {
+
+// `TypedListElem<T>::type_index` is the element type index a `TypedList` uses to store raw `T`s.
+template <typename T> struct TypedListElem;
+template <> struct TypedListElem<bool> {
+  static constexpr int32_t type_index = static_cast<int32_t>(MLCTypeIndex::kMLCBool);
+};
+template <> struct TypedListElem<int64_t> {
+  static constexpr int32_t type_index = static_cast<int32_t>(MLCTypeIndex::kMLCInt);
+};
+template <> struct TypedListElem<double> {
+  static constexpr int32_t type_index = static_cast<int32_t>(MLCTypeIndex::kMLCFloat);
+};
+template <> struct TypedListElem<DLDataType> {
+  static constexpr int32_t type_index = static_cast<int32_t>(MLCTypeIndex::kMLCDataType);
+};
+
+inline int64_t TypedListElemSize(int32_t elem_type_index) {
+  switch (elem_type_index) {
+  case kMLCBool:
+    return sizeof(bool);
+  case kMLCInt:
+    return sizeof(int64_t);
+  case kMLCFloat:
+    return sizeof(double);
+  case kMLCDataType:
+    return sizeof(DLDataType);
+  default:
+    MLC_THROW(TypeError) << "Unsupported element type of `TypedList`: " << Lib::GetTypeKey(elem_type_index)
+                         << ". Expected one of: bool, int, float, dtype";
+  }
+  MLC_UNREACHABLE();
+}
+
+} // namespace core
+
+// `TypedListObj` stores a homogeneous list of `bool`, `int64_t`, `double` or `DLDataType` as raw contiguous
+// values rather than as `MLCAny` cells. It answers the same methods as `UListObj` through the vtable, boxing
+// each element on access, and the packed buffer can be handed to other frameworks without a copy via `DLPack()`.
+struct TypedListObj : public MLCTypedList {
+  explicit TypedListObj(int32_t elem_type_index) : MLCTypedList() {
+    this->MLCTypedList::capacity = 0;
+    this->MLCTypedList::size = 0;
+    this->MLCTypedList::frozen = 0;
+    this->MLCTypedList::data = nullptr;
+    this->MLCTypedList::elem_type_index = elem_type_index;
+    ::mlc::core::TypedListElemSize(elem_type_index);
+  }
+  template <typename Iter>
+  TypedListObj(int32_t elem_type_index, Iter first, Iter last) : TypedListObj(elem_type_index) {
+    this->insert(0, first, last);
+  }
+  TypedListObj(const TypedListObj &other) : TypedListObj(other.elem_type_index()) {
+    if (other.size() == 0) {
+      return;
+    }
+    this->reserve(other.size());
+    std::memcpy(this->MLCTypedList::data, other.MLCTypedList::data, other.size() * other.elem_size());
+    this->MLCTypedList::size = other.size();
+  }
+  ~TypedListObj() { ::mlc::base::PODArrayFinally finally{this->MLCTypedList::data}; }
+
+  MLC_INLINE int64_t size() const { return this->MLCTypedList::size; }
+  MLC_INLINE int64_t capacity() const { return this->MLCTypedList::capacity; }
+  MLC_INLINE bool empty() const { return this->MLCTypedList::size == 0; }
+  MLC_INLINE int32_t elem_type_index() const { return this->MLCTypedList::elem_type_index; }
+  MLC_INLINE int64_t elem_size() const { return ::mlc::core::TypedListElemSize(this->elem_type_index()); }
+  MLC_INLINE void *data() { return this->MLCTypedList::data; }
+  MLC_INLINE const void *data() const { return this->MLCTypedList::data; }
+  template <typename T> MLC_INLINE T *data_as() { return static_cast<T *>(this->MLCTypedList::data); }
+  template <typename T> MLC_INLINE const T *data_as() const {
+    return static_cast<const T *>(this->MLCTypedList::data);
+  }
+
+  void reserve(int64_t cap) {
+    if (cap <= this->MLCTypedList::capacity) {
+      return;
+    }
+    int64_t new_capacity = static_cast<int64_t>(::mlc::base::BitCeil(static_cast<uint64_t>(cap)));
+    int64_t elem_size = this->elem_size();
+    ::mlc::base::PODArray new_data = ::mlc::base::PODArrayCreate<uint8_t>(new_capacity * elem_size);
+    if (this->MLCTypedList::size > 0) {
+      std::memcpy(new_data.get(), this->MLCTypedList::data, this->MLCTypedList::size * elem_size);
+    }
+    ::mlc::base::PODArraySwapOut(&new_data, &this->MLCTypedList::data);
+    this->MLCTypedList::capacity = new_capacity;
+  }
+  void resize(int64_t new_size) {
+    if (new_size > this->MLCTypedList::size) {
+      int64_t elem_size = this->elem_size();
+      this->reserve(new_size);
+      std::memset(this->At(this->MLCTypedList::size), 0, (new_size - this->MLCTypedList::size) * elem_size);
+    }
+    this->MLCTypedList::size = new_size;
+  }
+  MLC_INLINE void clear() { this->MLCTypedList::size = 0; }
+  MLC_INLINE void push_back(AnyView value) { this->insert(this->MLCTypedList::size, value); }
+  void insert(int64_t i, AnyView value) { this->insert(i, &value, &value + 1); }
+  template <typename Iter> void insert(int64_t i, Iter first, Iter last) {
+    int64_t size = this->MLCTypedList::size;
+    ::mlc::core::ListBase::ListRangeCheck(i, i, size + 1);
+    int64_t numel = static_cast<int64_t>(std::distance(first, last));
+    if (numel == 0) {
+      return;
+    }
+    // Convert all the values before touching the buffer, so that a failed conversion leaves the list unchanged
+    int64_t elem_size = this->elem_size();
+    alignas(8) uint8_t one[8];
+    ::mlc::base::PODArray many(nullptr, std::free);
+    uint8_t *packed = one;
+    if (numel > 1) {
+      many = ::mlc::base::PODArrayCreate<uint8_t>(numel * elem_size);
+      packed = static_cast<uint8_t *>(many.get());
+    }
+    for (uint8_t *dst = packed; first != last; ++first, dst += elem_size) {
+      this->Pack(AnyView(*first), dst);
+    }
+    this->reserve(size + numel);
+    std::memmove(this->At(i + numel), this->At(i), (size - i) * elem_size);
+    std::memcpy(this->At(i), packed, numel * elem_size);
+    this->MLCTypedList::size += numel;
+  }
+  void erase(int64_t i) {
+    int64_t size = this->MLCTypedList::size;
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, size);
+    std::memmove(this->At(i), this->At(i + 1), (size - i - 1) * this->elem_size());
+    this->MLCTypedList::size -= 1;
+  }
+  MLC_INLINE void pop_back() { this->erase(this->MLCTypedList::size - 1); }
+  Any at(int64_t i) const {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->MLCTypedList::size);
+    return this->Unpack(this->At(i));
+  }
+  void Set(int64_t i, AnyView value) {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->MLCTypedList::size);
+    this->Pack(value, this->At(i));
+  }
+
+  // Returns a boxed copy of this list as a `UList`.
+  UList ToList() const {
+    UList ret;
+    ret.reserve(this->MLCTypedList::size);
+    for (int64_t i = 0; i < this->MLCTypedList::size; ++i) {
+      ret.push_back(this->Unpack(this->At(i)));
+    }
+    return ret;
+  }
+
+  // Exports the packed buffer as a 1-D CPU tensor without copying. The list is kept alive until the deleter of
+  // the returned tensor is called, but any operation that grows the list reallocates the buffer and invalidates it.
+  DLManagedTensor *DLPack() {
+    struct DLManagedTensorWithShape {
+      DLManagedTensor managed;
+      int64_t shape;
+    };
+    DLDataType dtype;
+    switch (this->elem_type_index()) {
+    case kMLCBool:
+      dtype = DLDataType{kDLBool, 8, 1};
+      break;
+    case kMLCInt:
+      dtype = DLDataType{kDLInt, 64, 1};
+      break;
+    case kMLCFloat:
+      dtype = DLDataType{kDLFloat, 64, 1};
+      break;
+    default:
+      MLC_THROW(TypeError) << "Cannot export `TypedList` of element type `" << Lib::GetTypeKey(this->elem_type_index())
+                           << "` to DLPack";
+    }
+    ::mlc::base::IncRef(&this->_mlc_header);
+    // N.B. This leaks memory if the resulting DLManagedTensor's deleter is not called.
+    DLManagedTensorWithShape *ret = new DLManagedTensorWithShape();
+    ret->shape = this->MLCTypedList::size;
+    ret->managed.dl_tensor.data = this->MLCTypedList::data;
+    ret->managed.dl_tensor.device = DLDevice{kDLCPU, 0};
+    ret->managed.dl_tensor.ndim = 1;
+    ret->managed.dl_tensor.dtype = dtype;
+    ret->managed.dl_tensor.shape = &ret->shape;
+    ret->managed.dl_tensor.strides = nullptr;
+    ret->managed.dl_tensor.byte_offset = 0;
+    ret->managed.manager_ctx = this;
+    ret->managed.deleter = +[](DLManagedTensor *dl) {
+      TypedListObj *self = static_cast<TypedListObj *>(dl->manager_ctx);
+      ::mlc::base::DecRef(&self->_mlc_header);
+      delete reinterpret_cast<DLManagedTensorWithShape *>(dl);
+    };
+    return &ret->managed;
+  }
+
+  std::string __str__() const {
+    std::ostringstream os;
+    os << '[';
+    for (int64_t i = 0; i < this->MLCTypedList::size; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+      os << this->Unpack(this->At(i));
+    }
+    os << ']';
+    return os.str();
+  }
+
+  MLC_DEF_STATIC_TYPE(MLC_EXPORTS, TypedListObj, Object, MLCTypeIndex::kMLCTypedList, "object.TypedList");
+
+private:
+  MLC_INLINE void *At(int64_t i) const {
+    return static_cast<uint8_t *>(this->MLCTypedList::data) + i * this->elem_size();
+  }
+  void Pack(AnyView value, void *dst) const {
+    switch (this->elem_type_index()) {
+    case kMLCBool:
+      *static_cast<bool *>(dst) = value.operator bool();
+      break;
+    case kMLCInt:
+      *static_cast<int64_t *>(dst) = value.operator int64_t();
+      break;
+    case kMLCFloat:
+      *static_cast<double *>(dst) = value.operator double();
+      break;
+    case kMLCDataType:
+      *static_cast<DLDataType *>(dst) = value.operator DLDataType();
+      break;
+    }
+  }
+  Any Unpack(const void *src) const {
+    switch (this->elem_type_index()) {
+    case kMLCBool:
+      return Any(*static_cast<const bool *>(src));
+    case kMLCInt:
+      return Any(*static_cast<const int64_t *>(src));
+    case kMLCFloat:
+      return Any(*static_cast<const double *>(src));
+    case kMLCDataType:
+      return Any(*static_cast<const DLDataType *>(src));
+    }
+    MLC_UNREACHABLE();
+  }
+};
+
+struct UTypedList : public ObjectRef {
+  friend std::ostream &operator<<(std::ostream &os, const UTypedList &self) {
+    os << AnyView(self);
+    return os;
+  }
+  explicit UTypedList(int32_t elem_type_index) : UTypedList(UTypedList::New(elem_type_index)) {}
+  template <typename Iter>
+  UTypedList(int32_t elem_type_index, Iter first, Iter last)
+      : UTypedList(UTypedList::New(elem_type_index, first, last)) {}
+  MLC_INLINE int64_t size() const { return get()->size(); }
+  MLC_INLINE int64_t capacity() const { return get()->capacity(); }
+  MLC_INLINE bool empty() const { return get()->empty(); }
+  MLC_INLINE int32_t elem_type_index() const { return get()->elem_type_index(); }
+  MLC_INLINE void reserve(int64_t capacity) { get()->reserve(capacity); }
+  MLC_INLINE void resize(int64_t new_size) { get()->resize(new_size); }
+  MLC_INLINE void clear() { get()->clear(); }
+  MLC_INLINE void push_back(AnyView value) { get()->push_back(value); }
+  MLC_INLINE void insert(int64_t i, AnyView value) { get()->insert(i, value); }
+  template <typename Iter> MLC_INLINE void insert(int64_t i, Iter first, Iter last) { get()->insert(i, first, last); }
+  MLC_INLINE void erase(int64_t i) { get()->erase(i); }
+  MLC_INLINE void pop_back() { get()->pop_back(); }
+  MLC_INLINE Any at(int64_t i) const { return get()->at(i); }
+  MLC_INLINE Any operator[](int64_t i) const { return get()->at(i); }
+  MLC_INLINE void Set(int64_t i, AnyView value) { get()->Set(i, value); }
+  MLC_INLINE UList ToList() const { return get()->ToList(); }
+  MLC_INLINE static void FromAnyTuple(int32_t num_args, const AnyView *args, Any *ret) {
+    if (num_args < 1) {
+      MLC_THROW(TypeError) << "`TypedList.__init__` expects the element type index as its first argument";
+    }
+    *ret = Ref<TypedListObj>::New(args[0].operator int32_t(), args + 1, args + num_args);
+  }
+  MLC_DEF_OBJ_REF(MLC_EXPORTS, UTypedList, TypedListObj, ObjectRef)
+      .Field("capacity", &MLCTypedList::capacity, /*frozen=*/true)
+      .Field("size", &MLCTypedList::size, /*frozen=*/true)
+      .Field("_frozen", &MLCTypedList::frozen, /*frozen=*/false)
+      .Field("data", &MLCTypedList::data, /*frozen=*/true)
+      .Field("elem_type_index", &MLCTypedList::elem_type_index, /*frozen=*/true)
+      .StaticFn("__init__", FromAnyTuple)
+      .MemFn("__str__", &TypedListObj::__str__)
+      .MemFn("__iter_at__", &TypedListObj::at)
+      .MemFn("__setitem__", [](TypedListObj *self, int64_t i, Any value) { self->Set(i, value); })
+      .MemFn("_append", [](TypedListObj *self, Any value) { self->push_back(value); })
+      .MemFn("_insert", [](TypedListObj *self, int64_t i, Any value) { self->insert(i, value); })
+      .MemFn("_extend",
+             [](int32_t num_args, const AnyView *args, Any *) {
+               if (!args[0].IsInstance<TypedListObj>()) {
+                 MLC_THROW(TypeError) << "First argument must be a typed list";
+               }
+               TypedListObj *self = args[0];
+               self->insert(self->size(), args + 1, args + num_args);
+             })
+      .MemFn("_pop",
+             [](TypedListObj *self, int64_t i) {
+               Any ret = self->at(i);
+               self->erase(i);
+               return ret;
+             })
+      .MemFn("_clear", &TypedListObj::clear)
+      .MemFn("_to_list", &TypedListObj::ToList);
+};
+
+template <typename T> struct TypedList : public UTypedList {
+  using TElem = T;
+  static constexpr int32_t kElemTypeIndex = ::mlc::core::TypedListElem<T>::type_index;
+  friend std::ostream &operator<<(std::ostream &os, const TypedList &self) {
+    os << AnyView(self);
+    return os;
+  }
+  TypedList() : UTypedList(kElemTypeIndex) {}
+  TypedList(std::initializer_list<T> init) : TypedList() { this->insert(0, init.begin(), init.end()); }
+  template <typename Iter> TypedList(Iter first, Iter last) : TypedList() { this->insert(0, first, last); }
+  explicit TypedList(const UTypedList &source) : UTypedList(source) {
+    if (source->elem_type_index() != kElemTypeIndex) {
+      MLC_THROW(TypeError) << "Cannot convert from `TypedList` of element type `"
+                           << Lib::GetTypeKey(source->elem_type_index()) << "` to `TypedList` of element type `"
+                           << Lib::GetTypeKey(kElemTypeIndex) << "`";
+    }
+  }
+  MLC_INLINE T *data() { return get()->template data_as<T>(); }
+  MLC_INLINE const T *data() const { return get()->template data_as<T>(); }
+  MLC_INLINE T operator[](int64_t i) const {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->size());
+    return data()[i];
+  }
+  MLC_INLINE void Set(int64_t i, T value) {
+    ::mlc::core::ListBase::ListRangeCheck(i, i + 1, this->size());
+    data()[i] = value;
+  }
+  MLC_INLINE void push_back(T value) {
+    int64_t size = this->size();
+    get()->resize(size + 1);
+    data()[size] = value;
+  }
+  template <typename Iter> MLC_INLINE void insert(int64_t i, Iter first, Iter last) {
+    static_assert(std::is_convertible_v<typename std::iterator_traits<Iter>::value_type, T>);
+    int64_t size = this->size();
+    ::mlc::core::ListBase::ListRangeCheck(i, i, size + 1);
+    int64_t numel = static_cast<int64_t>(std::distance(first, last));
+    get()->resize(size + numel);
+    T *base = data();
+    std::memmove(base + i + numel, base + i, (size - i) * sizeof(T));
+    for (T *dst = base + i; first != last; ++first, ++dst) {
+      *dst = static_cast<T>(*first);
+    }
+  }
+  MLC_INLINE T *begin() { return data(); }
+  MLC_INLINE T *end() { return data() + size(); }
+  MLC_INLINE const T *begin() const { return data(); }
+  MLC_INLINE const T *end() const { return data() + size(); }
+};
+
+} // namespace mlc
+
+#endif // MLC_CORE_TYPED_LIST_H_
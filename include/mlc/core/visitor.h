@@ -4,6 +4,8 @@
 #include "./dict.h"
 #include "./list.h"
 #include "./object.h"
+#include "./persistent_dict.h"
+#include "./persistent_list.h"
 #include "mlc/c_api.h"
 #include <functional>
 #include <mlc/base/all.h>
@@ -272,6 +274,13 @@ inline void TopoVisit(Object *root, std::function<void(Object *object, MLCTypeIn
         FieldExtractor{&state, current}(nullptr, &kv.first);
         FieldExtractor{&state, current}(nullptr, &kv.second);
       }
+    } else if (PersistentListObj *list = current->obj->as<PersistentListObj>()) {
+      list->ForEach([&](const Any &elem) { FieldExtractor{&state, current}(nullptr, &elem); });
+    } else if (PersistentDictObj *dict = current->obj->as<PersistentDictObj>()) {
+      dict->ForEach([&](const Any &key, const Any &value) {
+        FieldExtractor{&state, current}(nullptr, &key);
+        FieldExtractor{&state, current}(nullptr, &value);
+      });
     } else {
       int32_t type_index = current->type_info->type_index;
       if (type_index == kMLCStr || type_index == kMLCFunc || type_index == kMLCError || type_index == kMLCOpaque ||
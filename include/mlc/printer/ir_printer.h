@@ -202,26 +202,32 @@ struct IRPrinter : public ObjectRef {
 }; // struct IRPrinter
 
 inline Str ToPython(const ObjectRef &obj, const PrinterConfig &cfg) {
-  IRPrinter printer(cfg);
-  DefaultFrame frame;
-  printer->FramePush(frame);
-  Node ret = ::mlc::Lib::IRPrint(obj, printer, ObjectPath::Root());
-  printer->FramePop();
-  if (frame->stmts->empty()) {
-    return ret->ToPython(cfg);
-  }
-  if (const auto *block = ret.as<StmtBlockObj>()) {
-    // TODO: support List::insert by iterator
-    frame->stmts->insert(frame->stmts.size(), block->stmts->begin(), block->stmts->end());
-  } else if (const auto *expr = ret.as<ExprObj>()) {
-    frame->stmts->push_back(ExprStmt(mlc::List<ObjectPath>{}, Optional<Str>{}, Expr(expr)));
-  } else if (const auto *stmt = ret.as<StmtObj>()) {
-    frame->stmts->push_back(Stmt(stmt));
-  } else {
-    MLC_THROW(ValueError) << "Unsupported type: " << ret;
+  std::string ret;
+  {
+    // Docs are scratch objects dropped right after printing, so allocate them from an arena. The
+    // printed text is copied out of the scope, otherwise it would keep the arena alive.
+    ArenaScope arena;
+    IRPrinter printer(cfg);
+    DefaultFrame frame;
+    printer->FramePush(frame);
+    Node node = ::mlc::Lib::IRPrint(obj, printer, ObjectPath::Root());
+    printer->FramePop();
+    if (!frame->stmts->empty()) {
+      if (const auto *block = node.as<StmtBlockObj>()) {
+        // TODO: support List::insert by iterator
+        frame->stmts->insert(frame->stmts.size(), block->stmts->begin(), block->stmts->end());
+      } else if (const auto *expr = node.as<ExprObj>()) {
+        frame->stmts->push_back(ExprStmt(mlc::List<ObjectPath>{}, Optional<Str>{}, Expr(expr)));
+      } else if (const auto *stmt = node.as<StmtObj>()) {
+        frame->stmts->push_back(Stmt(stmt));
+      } else {
+        MLC_THROW(ValueError) << "Unsupported type: " << node;
+      }
+      node = StmtBlock(mlc::List<ObjectPath>{}, Optional<Str>{}, frame->stmts);
+    }
+    ret = node->ToPython(cfg)->__str__();
   }
-  ret = StmtBlock(mlc::List<ObjectPath>{}, Optional<Str>{}, frame->stmts);
-  return ret->ToPython(cfg);
+  return Str(std::move(ret));
 }
 
 } // namespace printer
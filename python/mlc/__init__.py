@@ -10,19 +10,29 @@ from .core import (
     Object,
     ObjectPath,
     Opaque,
+    PersistentDict,
+    PersistentList,
     Tensor,
+    TypedList,
+    binary_dump,
+    binary_dumps,
+    binary_load,
+    binary_loads,
     build_info,
     dep_graph,
     eq_ptr,
     eq_s,
     eq_s_fail_reason,
     hash_s,
+    json_dump,
     json_dumps,
     json_loads,
     json_parse,
     typing,
 )
 from .core.dep_graph import DepGraph, DepNode
+from .core.structural_hash_cache import StructuralHashCache
+from .core.structural_intern_table import StructuralInternTable
 from .dataclasses import c_class, py_class
 
 try:
@@ -27,6 +27,7 @@ from .base import (
 )
 from .core import (  # type: ignore[import-not-found]
     container_to_py,
+    container_to_py_bulk,
     cxx_stacktrace_enabled,
     device_as_pair,
     dtype_as_triple,
@@ -37,6 +38,8 @@ from .core import (  # type: ignore[import-not-found]
     func_get,
     func_init,
     func_register,
+    list_extend_many,
+    list_from_many,
     make_mlc_init,
     opaque_init,
     register_opauqe_type,
@@ -52,6 +55,7 @@ from .core import (  # type: ignore[import-not-found]
     tensor_strides,
     tensor_to_dlpack,
     toggle_cxx_stacktrace,
+    typed_list_to_dlpack,
     type_add_method,
     type_cast,
     type_create,
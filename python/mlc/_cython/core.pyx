@@ -3,10 +3,11 @@ import ctypes
 import itertools
 import os
 from libcpp.vector cimport vector
-from libc.stdint cimport int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t
+from libc.stdint cimport int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, INT64_MAX
 from libc.stdlib cimport malloc, free
 from numbers import Integral, Number
 from . import base
+from cpython.buffer cimport PyObject_CheckBuffer, PyObject_GetBuffer, PyBuffer_Release, PyBUF_C_CONTIGUOUS, PyBUF_FORMAT
 from cpython.pycapsule cimport (
     PyCapsule_IsValid,
     PyCapsule_GetPointer,
@@ -87,6 +88,9 @@ cdef extern from "mlc/c_api.h" nogil:
         kMLCStr = 1005
         kMLCTensor = 1006
         kMLCOpaque = 1007
+        kMLCTypedList = 1008
+        kMLCPersistentList = 1009
+        kMLCPersistentDict = 1010
         kMLCCoreEnd = 1100
         # }
         # kMLCTyping [1100: 1200) {
@@ -138,6 +142,7 @@ cdef extern from "mlc/c_api.h" nogil:
         MLCAny _mlc_header
         int64_t length
         char *data
+        uint64_t hash
 
     ctypedef struct MLCFunc:
         MLCAny _mlc_header
@@ -151,12 +156,32 @@ cdef extern from "mlc/c_api.h" nogil:
         int8_t frozen
         void* data
 
+    ctypedef struct MLCTypedList:
+        MLCAny _mlc_header
+        int64_t capacity
+        int64_t size
+        int8_t frozen
+        void* data
+        int32_t elem_type_index
+
+    ctypedef struct MLCPersistentList:
+        MLCAny _mlc_header
+        int64_t size
+        void* root
+
+    ctypedef struct MLCPersistentDict:
+        MLCAny _mlc_header
+        int64_t size
+        void* root
+
     ctypedef struct MLCDict:
         MLCAny _mlc_header
         int64_t capacity
         int64_t size
         int8_t frozen
+        int8_t perfect_hash
         void* data
+        int64_t num_deleted
 
     ctypedef struct MLCTensor:
         MLCAny _mlc_header
@@ -380,17 +405,54 @@ cdef class PyAny:
     def _mlc_from_json(mlc_json, fn_opaque_deserialize):
         return func_call(_DESERIALIZE, (mlc_json, fn_opaque_deserialize))
 
+    def _mlc_binary(self, fn_opaque_serialize) -> bytes:
+        # The result may contain zeros and is not UTF-8, so it is copied into `bytes` instead of `str`
+        cdef MLCAny c_ret = _MLCAnyNone()
+        cdef MLCStr* c_str = NULL
+        _func_call_impl(<MLCFunc*>(_BINARY_SERIALIZE._mlc_any.v.v_obj), (self, fn_opaque_serialize), &c_ret)
+        try:
+            c_str = <MLCStr*>(c_ret.v.v_obj)
+            return c_str.data[:c_str.length]
+        finally:
+            _check_error(_C_AnyDecRef(&c_ret))
+
+    @staticmethod
+    def _mlc_binary_load(str path, bint lazy, fn_opaque_deserialize):
+        return func_call(_BINARY_LOAD, (path, lazy, fn_opaque_deserialize))
+
+    @staticmethod
+    def _mlc_serialize_to(PyAny source, bint binary, sink, fn_opaque_serialize):
+        func_call(_BINARY_SERIALIZE_TO if binary else _JSON_SERIALIZE_TO, (source, sink, fn_opaque_serialize))
+
     @staticmethod
-    def _mlc_eq_s(PyAny lhs, PyAny rhs, bint bind_free_vars, bint assert_mode) -> bool:
-        return bool(func_call(_STRUCUTRAL_EQUAL, (lhs, rhs, bind_free_vars, assert_mode)))
+    def _mlc_from_binary(bytes data, fn_opaque_deserialize):
+        cdef list temporary_storage = []
+        cdef const char* c_data = data
+        cdef MLCAny c_args[3]
+        cdef MLCAny c_ret = _MLCAnyNone()
+        c_args[0] = _MLCAnyPtr(<uint64_t>(<void*>c_data))
+        c_args[1] = _MLCAnyInt(len(data))
+        c_args[2] = _any_py2c(fn_opaque_deserialize, temporary_storage)
+        _func_call_impl_with_c_args(<MLCFunc*>(_BINARY_DESERIALIZE._mlc_any.v.v_obj), 3, c_args, &c_ret)
+        return _any_c2py_no_inc_ref(c_ret)
+
+    @staticmethod
+    def _mlc_eq_s(PyAny lhs, PyAny rhs, bint bind_free_vars, bint assert_mode, int num_threads = 1) -> bool:
+        if num_threads == 1:
+            return bool(func_call(_STRUCUTRAL_EQUAL, (lhs, rhs, bind_free_vars, assert_mode)))
+        return bool(func_call(_STRUCUTRAL_EQUAL_PARALLEL, (lhs, rhs, bind_free_vars, assert_mode, num_threads)))
 
     @staticmethod
     def _mlc_eq_s_fail_reason(PyAny lhs, PyAny rhs, bint bind_free_vars):
         return func_call(_STRUCUTRAL_EQUAL_FAIL_REASON, (lhs, rhs, bind_free_vars))
 
     @staticmethod
-    def _mlc_hash_s(PyAny x) -> object:
-        cdef object ret = func_call(_STRUCUTRAL_HASH, (x,))
+    def _mlc_hash_s(PyAny x, int num_threads = 1) -> object:
+        cdef object ret
+        if num_threads == 1:
+            ret = func_call(_STRUCUTRAL_HASH, (x,))
+        else:
+            ret = func_call(_STRUCUTRAL_HASH_PARALLEL, (x, num_threads))
         if ret < 0:
             ret += 2 ** 63
         return ret
@@ -1456,6 +1518,8 @@ cpdef object container_to_py(object self):
     from mlc.core.list import List as mlc_list
     from mlc.core.dict import Dict as mlc_dict
 
+    if isinstance(self, PyAny) and (<PyAny>self)._mlc_any.type_index in (kMLCList, kMLCDict, kMLCTypedList):
+        return _container_c2py((<PyAny>self)._mlc_any, -1)
     if isinstance(self, mlc_list):
         return [container_to_py(v) for v in self]
     if isinstance(self, mlc_dict):
@@ -1464,6 +1528,148 @@ cpdef object container_to_py(object self):
         return str(self)
     return self
 
+# Bulk conversion of `mlc.List` and `mlc.Dict`. Elements are read directly from the `MLCAny` array of a list,
+# and a dict or `mlc.TypedList` is first turned into such a list by a single call to `_items` or `_to_list`, so
+# that converting a container of N elements costs at most one FFI crossing per dict or typed list rather than N.
+# `depth` is the number of nested container levels to convert, where -1 means all of them.
+
+cdef inline object _container_c2py(const MLCAny x, int32_t depth):
+    cdef int32_t type_index = x.type_index
+    cdef MLCStr* mlc_str = NULL
+    if depth != 0:
+        if type_index == kMLCList:
+            return _list_c2py(<MLCList*>(x.v.v_obj), depth - 1)
+        elif type_index == kMLCDict:
+            return _dict_c2py(x, depth - 1)
+        elif type_index == kMLCTypedList:
+            return _typed_list_c2py(x, depth - 1)
+        elif type_index == kMLCStr:
+            mlc_str = <MLCStr*>(x.v.v_obj)
+            return str_c2py(mlc_str.data[:mlc_str.length])
+    return _any_c2py_inc_ref(x)
+
+cdef inline list _list_c2py(MLCList* c_list, int32_t depth):
+    cdef int64_t size = c_list.size
+    cdef MLCAny* data = <MLCAny*>(c_list.data)
+    cdef list ret = [None] * size
+    cdef int64_t i
+    for i in range(size):
+        ret[i] = _container_c2py(data[i], depth)
+    return ret
+
+cdef inline dict _dict_c2py(MLCAny c_dict, int32_t depth):
+    cdef MLCAny c_items = _MLCAnyNone()
+    cdef PyAny items
+    cdef MLCList* c_list
+    cdef MLCAny* data
+    cdef dict ret = {}
+    cdef int64_t i
+    _func_call_impl_with_c_args(_DICT_ITEMS, 1, &c_dict, &c_items)
+    items = _pyany_no_inc_ref(c_items)  # owns `c_items`
+    c_list = <MLCList*>(c_items.v.v_obj)
+    data = <MLCAny*>(c_list.data)
+    for i in range(0, c_list.size, 2):
+        ret[_container_c2py(data[i], depth)] = _container_c2py(data[i + 1], depth)
+    return ret
+
+cdef inline list _typed_list_c2py(MLCAny c_typed_list, int32_t depth):
+    cdef MLCAny c_list = _MLCAnyNone()
+    cdef PyAny owner
+    _func_call_impl_with_c_args(_TYPED_LIST_TO_LIST, 1, &c_typed_list, &c_list)
+    owner = _pyany_no_inc_ref(c_list)  # owns `c_list`
+    return _list_c2py(<MLCList*>(c_list.v.v_obj), depth)
+
+# Returns False without consuming anything if `buffer` is not a C-contiguous buffer of a supported format, or holds
+# unsigned 64-bit values that do not fit in `int64_t`, in which case the caller falls back to iterating over it.
+cdef bint _buffer_to_c_args(object buffer, vector[MLCAny]* c_args) except -1:
+    cdef Py_buffer view
+    cdef char* data
+    cdef Py_ssize_t i, n, itemsize
+    cdef bytes fmt
+    try:
+        PyObject_GetBuffer(buffer, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)
+    except BufferError:
+        return False
+    try:
+        fmt = b"B"
+        if view.format != NULL:
+            fmt = (<bytes>view.format).lstrip(b"@=")
+        itemsize = view.itemsize
+        n = view.len // itemsize
+        data = <char*>(view.buf)
+        c_args.reserve(c_args.size() + n)
+        if fmt == b"?":
+            for i in range(n):
+                c_args.push_back(_MLCAnyBool((<uint8_t*>data)[i] != 0))
+        elif fmt == b"d":
+            for i in range(n):
+                c_args.push_back(_MLCAnyFloat((<double*>data)[i]))
+        elif fmt == b"f":
+            for i in range(n):
+                c_args.push_back(_MLCAnyFloat((<float*>data)[i]))
+        elif fmt in (b"b", b"h", b"i", b"l", b"q", b"n") and itemsize == 8:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<int64_t*>data)[i]))
+        elif fmt in (b"b", b"h", b"i", b"l", b"q", b"n") and itemsize == 4:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<int32_t*>data)[i]))
+        elif fmt in (b"b", b"h", b"i", b"l", b"q", b"n") and itemsize == 2:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<int16_t*>data)[i]))
+        elif fmt in (b"b", b"h", b"i", b"l", b"q", b"n") and itemsize == 1:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<int8_t*>data)[i]))
+        elif fmt in (b"B", b"H", b"I", b"L", b"Q", b"N") and itemsize == 8:
+            for i in range(n):
+                if (<uint64_t*>data)[i] > <uint64_t>INT64_MAX:
+                    return False
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt(<int64_t>((<uint64_t*>data)[i])))
+        elif fmt in (b"B", b"H", b"I", b"L", b"Q", b"N") and itemsize == 4:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<uint32_t*>data)[i]))
+        elif fmt in (b"B", b"H", b"I", b"L", b"Q", b"N") and itemsize == 2:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<uint16_t*>data)[i]))
+        elif fmt in (b"B", b"H", b"I", b"L", b"Q", b"N") and itemsize == 1:
+            for i in range(n):
+                c_args.push_back(_MLCAnyInt((<uint8_t*>data)[i]))
+        else:
+            return False
+    finally:
+        PyBuffer_Release(&view)
+    return True
+
+cdef inline void _many_to_c_args(object source, vector[MLCAny]* c_args, list temporary_storage) except *:
+    if PyObject_CheckBuffer(source) and _buffer_to_c_args(source, c_args):
+        return
+    for item in source:
+        c_args.push_back(_any_py2c(item, temporary_storage))
+
+cpdef object container_to_py_bulk(PyAny self, int32_t depth):
+    if self._mlc_any.type_index not in (kMLCList, kMLCDict):
+        raise TypeError(f"Expected `mlc.List` or `mlc.Dict`, but got: {type(self)}")
+    if depth == 0:
+        return self
+    return _container_c2py(self._mlc_any, depth)
+
+cpdef object list_from_many(object source):
+    cdef vector[MLCAny] c_args
+    cdef list temporary_storage = []
+    cdef MLCAny c_ret = _MLCAnyNone()
+    _many_to_c_args(source, &c_args, temporary_storage)
+    _func_call_impl_with_c_args(_LIST_INIT, <int32_t>c_args.size(), c_args.data(), &c_ret)
+    return _any_c2py_no_inc_ref(c_ret)
+
+cpdef void list_extend_many(PyAny self, object source):
+    cdef vector[MLCAny] c_args
+    cdef list temporary_storage = []
+    cdef MLCAny c_ret = _MLCAnyNone()
+    cdef MLCFunc* func = _vtable_get_func_ptr(_VTABLE_EXTEND, self._mlc_any.type_index, True)
+    c_args.push_back(self._mlc_any)
+    _many_to_c_args(source, &c_args, temporary_storage)
+    _func_call_impl_with_c_args(func, <int32_t>c_args.size(), c_args.data(), &c_ret)
+
 cpdef object tensor_data(PyAny self):
     cdef DLTensor* tensor = _pyany_to_dl_tensor(self)
     cdef void* data = tensor[0].data
@@ -1525,6 +1731,11 @@ cpdef object tensor_to_dlpack(PyAny self):
     cdef DLManagedTensor* dl_managed_tensor = <DLManagedTensor*><uint64_t>(func_call(_TENSOR_TO_DLPACK, (self,)).value)
     return PyCapsule_New(dl_managed_tensor, _DLPACK_CAPSULE_NAME, pycapsule_deleter)
 
+cpdef object typed_list_to_dlpack(PyAny self):
+    cdef uint64_t address = func_call(_TYPED_LIST_TO_DLPACK, (self,)).value
+    cdef DLManagedTensor* dl_managed_tensor = <DLManagedTensor*>address
+    return PyCapsule_New(dl_managed_tensor, _DLPACK_CAPSULE_NAME, pycapsule_deleter)
+
 cpdef void func_register(str name, bint allow_override, object func):
     cdef PyAny mlc_func = _pyany_from_func(func)
     _check_error(_C_FuncSetGlobal(NULL, str_py2c(name), mlc_func._mlc_any, allow_override))
@@ -1733,13 +1944,21 @@ cdef const char* _DLPACK_CAPSULE_NAME_VER_USED = "used_dltensor_versioned"
 cdef list TYPE_INDEX_TO_INFO = [None]  # mapping: (type_index: int) ==> (type_info: base.TypeInfo)
 cdef PyAny _SERIALIZE = func_get_untyped("mlc.core.JSONSerialize")  # Any -> str
 cdef PyAny _DESERIALIZE = func_get_untyped("mlc.core.JSONDeserialize")  # str -> Any
+cdef PyAny _BINARY_SERIALIZE = func_get_untyped("mlc.core.BinarySerialize")  # Any -> bytes
+cdef PyAny _BINARY_DESERIALIZE = func_get_untyped("mlc.core.BinaryDeserialize")  # bytes -> Any
+cdef PyAny _BINARY_LOAD = func_get_untyped("mlc.core.BinaryLoad")  # path -> Any
+cdef PyAny _JSON_SERIALIZE_TO = func_get_untyped("mlc.core.JSONSerializeTo")  # Any, sink -> None
+cdef PyAny _BINARY_SERIALIZE_TO = func_get_untyped("mlc.core.BinarySerializeTo")  # Any, sink -> None
 cdef PyAny _STRUCUTRAL_EQUAL = func_get_untyped("mlc.core.StructuralEqual")
 cdef PyAny _STRUCUTRAL_HASH = func_get_untyped("mlc.core.StructuralHash")
 cdef PyAny _STRUCUTRAL_EQUAL_FAIL_REASON = func_get_untyped("mlc.core.StructuralEqualFailReason")
+cdef PyAny _STRUCUTRAL_EQUAL_PARALLEL = func_get_untyped("mlc.core.StructuralEqualParallel")
+cdef PyAny _STRUCUTRAL_HASH_PARALLEL = func_get_untyped("mlc.core.StructuralHashParallel")
 cdef PyAny _COPY_SHALLOW = func_get_untyped("mlc.core.CopyShallow")
 cdef PyAny _COPY_DEEP = func_get_untyped("mlc.core.CopyDeep")
 cdef PyAny _COPY_REPLACE = func_get_untyped("mlc.core.CopyReplace")
 cdef PyAny _TENSOR_TO_DLPACK = func_get_untyped("mlc.core.TensorToDLPack")
+cdef PyAny _TYPED_LIST_TO_DLPACK = func_get_untyped("mlc.core.TypedListToDLPack")
 
 cdef MLCVTableHandle _VTABLE_STR = _vtable_get_global(b"__str__")
 cdef MLCVTableHandle _VTABLE_ANY_TO_REF = _vtable_get_global(b"__any_to_ref__")
@@ -1757,6 +1976,9 @@ cdef MLCFunc* _DTYPE_INIT = _vtable_get_func_ptr(_VTABLE_INIT, kMLCDataType, Fal
 cdef MLCFunc* _DEVICE_INIT = _vtable_get_func_ptr(_VTABLE_INIT, kMLCDevice, False)
 cdef MLCFunc* _LIST_INIT = _vtable_get_func_ptr(_VTABLE_INIT, kMLCList, False)
 cdef MLCFunc* _DICT_INIT = _vtable_get_func_ptr(_VTABLE_INIT, kMLCDict, False)
+cdef MLCFunc* _DICT_ITEMS = _vtable_get_func_ptr(_vtable_get_global(b"_items"), kMLCDict, False)
+cdef MLCFunc* _TYPED_LIST_TO_LIST = _vtable_get_func_ptr(_vtable_get_global(b"_to_list"), kMLCTypedList, False)
+cdef MLCVTableHandle _VTABLE_EXTEND = _vtable_get_global(b"_extend")
 cdef MLCFunc* _OPAQUE_INIT = _vtable_get_func_ptr(_VTABLE_INIT, kMLCOpaque, False)
 cdef MLCFunc* _TENSOR_INIT = _vtable_get_func_ptr(_vtable_get_global(b"__init_DLManagedTensor"), kMLCTensor, False)
 cdef MLCFunc* _TENSOR_INIT_VER = _vtable_get_func_ptr(_vtable_get_global(b"__init_DLManagedTensorVersioned"), kMLCTensor, False)  # no-cython-lint
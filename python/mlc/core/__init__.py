@@ -5,7 +5,22 @@ from .dtype import DataType
 from .error import Error
 from .func import Func, build_info, json_parse
 from .list import List
-from .object import Object, eq_ptr, eq_s, eq_s_fail_reason, hash_s, json_dumps, json_loads
+from .object import (
+    Object,
+    binary_dump,
+    binary_dumps,
+    binary_load,
+    binary_loads,
+    eq_ptr,
+    eq_s,
+    eq_s_fail_reason,
+    hash_s,
+    json_dump,
+    json_dumps,
+    json_loads,
+)
 from .object_path import ObjectPath
 from .opaque import Opaque
+from .persistent import PersistentDict, PersistentList
 from .tensor import Tensor
+from .typed_list import TypedList
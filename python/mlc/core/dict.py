@@ -5,7 +5,7 @@ from abc import ABCMeta
 from collections.abc import ItemsView, Iterable, Iterator, KeysView, Mapping, ValuesView
 from typing import Any, TypeVar, overload
 
-from mlc._cython import MetaNoSlots, Ptr, c_class_core, container_to_py
+from mlc._cython import MetaNoSlots, Ptr, c_class_core, container_to_py, container_to_py_bulk
 
 from .object import Object
 
@@ -29,6 +29,7 @@ class Dict(Object, Mapping[K, V], metaclass=DictMeta):
     size: int
     _frozen: int
     data: Ptr
+    num_deleted: int
 
     def __init__(
         self,
@@ -54,22 +55,20 @@ class Dict(Object, Mapping[K, V], metaclass=DictMeta):
         return self._keys_iterator()
 
     def _keys_iterator(self) -> Iterator[K]:
-        cap = self.capacity
-        i = -1
-        while (i := Dict._C(b"__iter_advance__", self, i)) < cap:
-            yield Dict._C(b"__iter_get_key__", self, i)
+        flat = self._items_flat()
+        return iter(flat[0::2])
 
     def _values_iterator(self) -> Iterator[V]:
-        cap = self.capacity
-        i = -1
-        while (i := Dict._C(b"__iter_advance__", self, i)) < cap:
-            yield Dict._C(b"__iter_get_value__", self, i)
+        flat = self._items_flat()
+        return iter(flat[1::2])
 
     def _items_iterator(self) -> Iterator[tuple[K, V]]:
-        cap = self.capacity
-        i = -1
-        while (i := Dict._C(b"__iter_advance__", self, i)) < cap:
-            yield Dict._C(b"__iter_get_key__", self, i), Dict._C(b"__iter_get_value__", self, i)
+        flat = self._items_flat()
+        return zip(flat[0::2], flat[1::2])
+
+    def _items_flat(self) -> list[Any]:
+        # Keys and values interleaved, fetched in one call into C++
+        return container_to_py_bulk(Dict._C(b"_items", self), 1)
 
     def keys(self) -> KeysView[K]:
         return _DictKeysView(self)
@@ -81,12 +80,11 @@ class Dict(Object, Mapping[K, V], metaclass=DictMeta):
         return _DictItemsView(self)
 
     def freeze(self) -> None:
-        if self._frozen == 0:
-            self._frozen = 1
+        Dict._C(b"_freeze", self)
 
     @property
     def frozen(self) -> bool:
-        return self._frozen == 1
+        return self._frozen != 0
 
     def __getitem__(self, key: K) -> V:
         return Dict._C(b"__getitem__", self, key)
@@ -159,6 +157,14 @@ class Dict(Object, Mapping[K, V], metaclass=DictMeta):
     def py(self) -> dict[K, V]:
         return container_to_py(self)
 
+    def to_py(self, depth: int = -1) -> dict[Any, Any]:
+        """Converts to a Python dict with a single call into C++ per nested `Dict`.
+
+        `depth` is the number of nested levels of `List`, `TypedList` and `Dict` converted into
+        Python containers, where -1 converts all of them and 1 converts only this dict.
+        """
+        return container_to_py_bulk(self, depth)
+
     def __hash__(self) -> int:
         # TODO: hash by elements
         return hash((type(self), self._mlc_address))
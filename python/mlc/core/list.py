@@ -4,7 +4,15 @@ from abc import ABCMeta
 from collections.abc import Iterable, Iterator, Sequence
 from typing import Any, TypeVar, overload
 
-from mlc._cython import MetaNoSlots, Ptr, c_class_core, container_to_py
+from mlc._cython import (
+    MetaNoSlots,
+    Ptr,
+    c_class_core,
+    container_to_py,
+    container_to_py_bulk,
+    list_extend_many,
+    list_from_many,
+)
 
 from .object import Object
 
@@ -44,7 +52,7 @@ class List(Object, Sequence[T], metaclass=ListMeta):
     def __getitem__(self, i: int | slice) -> T | Sequence[T]:
         if isinstance(i, int):
             i = _normalize_index(i, len(self))
-            return List._C(b"__iter_at__", self, i)
+            return type(self)._C(b"__iter_at__", self, i)
         elif isinstance(i, slice):
             # Implement slicing
             start, stop, step = i.indices(len(self))
@@ -60,10 +68,10 @@ class List(Object, Sequence[T], metaclass=ListMeta):
             raise IndexError(f"list assignment index out of range: {index}")
         if index < 0:
             index += length
-        List._C(b"__setitem__", self, index, value)
+        type(self)._C(b"__setitem__", self, index, value)
 
     def __iter__(self) -> Iterator[T]:
-        return iter(self[i] for i in range(len(self)))
+        return iter(self.to_py(depth=1))
 
     def __add__(self, other: Sequence[T]) -> List[T]:
         if not isinstance(other, (list, tuple, List)):
@@ -83,28 +91,43 @@ class List(Object, Sequence[T], metaclass=ListMeta):
         if self._frozen:
             raise RuntimeError("Cannot modify a frozen list")
         i = _normalize_index(i, len(self) + 1)
-        return List._C(b"_insert", self, i, x)
+        return type(self)._C(b"_insert", self, i, x)
 
     def append(self, x: T) -> None:
         if self._frozen:
             raise RuntimeError("Cannot modify a frozen list")
-        return List._C(b"_append", self, x)
+        return type(self)._C(b"_append", self, x)
 
     def pop(self, i: int = -1) -> T:
         if self._frozen:
             raise RuntimeError("Cannot modify a frozen list")
         i = _normalize_index(i, len(self))
-        return List._C(b"_pop", self, i)
+        return type(self)._C(b"_pop", self, i)
 
     def clear(self) -> None:
         if self._frozen:
             raise RuntimeError("Cannot modify a frozen list")
-        return List._C(b"_clear", self)
+        return type(self)._C(b"_clear", self)
 
     def extend(self, iterable: Iterable[T]) -> None:
         if self._frozen:
             raise RuntimeError("Cannot modify a frozen list")
-        return List._C(b"_extend", self, *iterable)
+        return type(self)._C(b"_extend", self, *iterable)
+
+    def extend_many(self, source: Iterable[T]) -> None:
+        """Appends all elements of `source` in a single call into C++.
+
+        A `source` exposing the buffer protocol, e.g. a numpy array or `array.array` of
+        bools, integers or floats, is read directly without creating Python objects.
+        """
+        if self._frozen:
+            raise RuntimeError("Cannot modify a frozen list")
+        list_extend_many(self, source)
+
+    @staticmethod
+    def from_buffer(source: Iterable[T]) -> List[T]:
+        """Creates a list from `source` in a single call into C++, see `extend_many`."""
+        return list_from_many(source)
 
     def __eq__(self, other: Any) -> bool:
         if isinstance(other, List) and self._mlc_address == other._mlc_address:
@@ -126,6 +149,14 @@ class List(Object, Sequence[T], metaclass=ListMeta):
     def py(self) -> list[T]:
         return container_to_py(self)
 
+    def to_py(self, depth: int = -1) -> list[Any]:
+        """Converts to a Python list without a round trip into C++ per element.
+
+        `depth` is the number of nested levels of `List`, `TypedList` and `Dict` converted into
+        Python containers, where -1 converts all of them and 1 converts only this list.
+        """
+        return container_to_py_bulk(self, depth)
+
     def __hash__(self) -> int:
         # TODO: hash by elements
         return hash((type(self), self._mlc_address))
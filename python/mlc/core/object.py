@@ -1,5 +1,9 @@
 from __future__ import annotations
 
+import codecs
+import ctypes
+import io
+import os
 import typing
 from collections.abc import Callable
 
@@ -142,6 +146,15 @@ def json_dumps(
     return object._mlc_json(fn_opaque_serialize)  # type: ignore[attr-defined]
 
 
+def json_dump(
+    object: typing.Any,
+    fp: str | os.PathLike | int | typing.IO,
+    fn_opaque_serialize: Callable[[list[typing.Any]], str] | None = None,
+) -> None:
+    assert isinstance(object, Object), f"Expected `mlc.Object`, got `{type(object)}`"
+    PyAny._mlc_serialize_to(object, False, _sink(fp, text=True), fn_opaque_serialize)  # type: ignore[attr-defined]
+
+
 def json_loads(
     json_str: str,
     fn_opaque_deserialize: Callable[[str], list[typing.Any]] | None = None,
@@ -149,16 +162,67 @@ def json_loads(
     return PyAny._mlc_from_json(json_str, fn_opaque_deserialize)  # type: ignore[attr-defined]
 
 
+def binary_dumps(
+    object: typing.Any,
+    fn_opaque_serialize: Callable[[list[typing.Any]], str] | None = None,
+) -> bytes:
+    assert isinstance(object, Object), f"Expected `mlc.Object`, got `{type(object)}`"
+    return object._mlc_binary(fn_opaque_serialize)  # type: ignore[attr-defined]
+
+
+def binary_dump(
+    object: typing.Any,
+    fp: str | os.PathLike | int | typing.IO,
+    fn_opaque_serialize: Callable[[list[typing.Any]], str] | None = None,
+) -> None:
+    assert isinstance(object, Object), f"Expected `mlc.Object`, got `{type(object)}`"
+    PyAny._mlc_serialize_to(object, True, _sink(fp, text=False), fn_opaque_serialize)  # type: ignore[attr-defined]
+
+
+def binary_loads(
+    data: bytes,
+    fn_opaque_deserialize: Callable[[str], list[typing.Any]] | None = None,
+) -> Object:
+    return PyAny._mlc_from_binary(bytes(data), fn_opaque_deserialize)  # type: ignore[attr-defined]
+
+
+def binary_load(
+    path: str | os.PathLike,
+    lazy: bool = False,
+    fn_opaque_deserialize: Callable[[str], list[typing.Any]] | None = None,
+) -> Object:
+    # Tensors are backed by a private memory mapping of the file instead of being copied. With `lazy`, their pages are
+    # read from disk on first access.
+    return PyAny._mlc_binary_load(os.fspath(path), lazy, fn_opaque_deserialize)  # type: ignore[attr-defined]
+
+
+def _sink(fp: str | os.PathLike | int | typing.IO, text: bool) -> typing.Any:
+    # Output is streamed in fixed-size chunks: a path or file descriptor is written to directly from C++, and a file
+    # object receives each chunk via its `write` method.
+    if isinstance(fp, (str, os.PathLike)):
+        return os.fspath(fp)
+    if isinstance(fp, int):
+        return fp
+    if isinstance(fp, io.TextIOBase):
+        if not text:
+            raise TypeError("Binary serialization requires a file opened in binary mode")
+        # A multi-byte character may be split between two chunks
+        decoder = codecs.getincrementaldecoder("utf-8")()
+        return lambda data, size: fp.write(decoder.decode(ctypes.string_at(data, size)))
+    return lambda data, size: fp.write(ctypes.string_at(data, size))
+
+
 def eq_s(
     lhs: typing.Any,
     rhs: typing.Any,
     *,
     bind_free_vars: bool = True,
     assert_mode: bool = False,
+    num_threads: int = 1,
 ) -> bool:
     assert isinstance(lhs, Object), f"Expected `mlc.Object`, got `{type(lhs)}`"
     assert isinstance(rhs, Object), f"Expected `mlc.Object`, got `{type(rhs)}`"
-    return PyAny._mlc_eq_s(lhs, rhs, bind_free_vars, assert_mode)  # type: ignore[attr-defined]
+    return PyAny._mlc_eq_s(lhs, rhs, bind_free_vars, assert_mode, num_threads)  # type: ignore[attr-defined]
 
 
 def eq_s_fail_reason(
@@ -172,9 +236,9 @@ def eq_s_fail_reason(
     return PyAny._mlc_eq_s_fail_reason(lhs, rhs, bind_free_vars)
 
 
-def hash_s(obj: typing.Any) -> int:
+def hash_s(obj: typing.Any, *, num_threads: int = 1) -> int:
     assert isinstance(obj, Object), f"Expected `mlc.Object`, got `{type(obj)}`"
-    return PyAny._mlc_hash_s(obj)  # type: ignore[attr-defined]
+    return PyAny._mlc_hash_s(obj, num_threads)  # type: ignore[attr-defined]
 
 
 def eq_ptr(lhs: typing.Any, rhs: typing.Any) -> bool:
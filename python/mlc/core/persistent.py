@@ -0,0 +1,155 @@
+from __future__ import annotations
+
+import itertools
+from abc import ABCMeta
+from collections.abc import Iterable, Iterator, Mapping, Sequence
+from typing import Any, TypeVar, overload
+
+from mlc._cython import MetaNoSlots, c_class_core
+
+from .list import _normalize_index
+from .object import Object
+
+K = TypeVar("K")
+V = TypeVar("V")
+T = TypeVar("T")
+
+
+class PersistentMeta(MetaNoSlots, ABCMeta): ...
+
+
+@c_class_core("object.PersistentList")
+class PersistentList(Object, Sequence[T], metaclass=PersistentMeta):
+    """An immutable list whose updates return a new list sharing unchanged chunks with the old one.
+
+    `set`, `insert`, `erase` and `append` each take O(log n) time and leave `self` untouched.
+    """
+
+    size: int
+
+    def __init__(self, iterable: Iterable[T] = ()) -> None:
+        self._mlc_init(*iterable)
+
+    def __len__(self) -> int:
+        return self.size
+
+    @overload
+    def __getitem__(self, i: int) -> T: ...
+
+    @overload
+    def __getitem__(self, i: slice) -> Sequence[T]: ...
+
+    def __getitem__(self, i: int | slice) -> T | Sequence[T]:
+        if isinstance(i, int):
+            i = _normalize_index(i, len(self))
+            return type(self)._C(b"__iter_at__", self, i)
+        elif isinstance(i, slice):
+            start, stop, step = i.indices(len(self))
+            return PersistentList([self[i] for i in range(start, stop, step)])
+        else:
+            raise TypeError(f"list indices must be integers or slices, not {type(i).__name__}")
+
+    def __iter__(self) -> Iterator[T]:
+        return iter(self.to_list())
+
+    def set(self, i: int, x: T) -> PersistentList[T]:
+        i = _normalize_index(i, len(self))
+        return type(self)._C(b"_set", self, i, x)
+
+    def insert(self, i: int, x: T) -> PersistentList[T]:
+        i = _normalize_index(i, len(self) + 1)
+        return type(self)._C(b"_insert", self, i, x)
+
+    def erase(self, i: int) -> PersistentList[T]:
+        i = _normalize_index(i, len(self))
+        return type(self)._C(b"_erase", self, i)
+
+    def append(self, x: T) -> PersistentList[T]:
+        return type(self)._C(b"_append", self, x)
+
+    def to_list(self) -> Any:
+        return type(self)._C(b"_to_list", self)
+
+    def __eq__(self, other: Any) -> bool:
+        if isinstance(other, PersistentList) and self._mlc_address == other._mlc_address:
+            return True
+        if not isinstance(other, (list, tuple, PersistentList)):
+            return False
+        if len(self) != len(other):
+            return False
+        return all(a == b for a, b in zip(self, other))
+
+    def __ne__(self, other: Any) -> bool:
+        return not (self == other)
+
+    def py(self) -> list[T]:
+        return self.to_list().py()
+
+    def __hash__(self) -> int:
+        return hash((type(self), self._mlc_address))
+
+
+@c_class_core("object.PersistentDict")
+class PersistentDict(Object, Mapping[K, V], metaclass=PersistentMeta):
+    """An immutable dict whose updates return a new dict sharing unchanged nodes with the old one.
+
+    `set` and `erase` each take O(log n) time and leave `self` untouched. Iteration order follows
+    the hash of the keys rather than the insertion order.
+    """
+
+    size: int
+
+    def __init__(
+        self,
+        _source: Iterable[tuple[K, V]] | Mapping[K, V] | None = None,
+        **kwargs: V,
+    ) -> None:
+        if isinstance(_source, Mapping):
+            py_args = tuple(_source.items())
+        elif isinstance(_source, Iterable):
+            py_args = tuple(_source)  # type: ignore[arg-type]
+        elif _source is None:
+            py_args = ()
+        else:
+            raise TypeError(f"expected mapping or iterable, got {type(_source).__name__}")
+        if kwargs:
+            py_args += tuple(kwargs.items())
+        self._mlc_init(*itertools.chain.from_iterable(py_args))
+
+    def __len__(self) -> int:
+        return self.size
+
+    def __getitem__(self, key: K) -> V:
+        return type(self)._C(b"__getitem__", self, key)
+
+    def __contains__(self, key: object) -> bool:
+        return type(self)._C(b"__contains__", self, key)
+
+    def __iter__(self) -> Iterator[K]:
+        return (k for k, _ in self._items())
+
+    def _items(self) -> Iterator[tuple[K, V]]:
+        flat = type(self)._C(b"_items", self)
+        return ((flat[i], flat[i + 1]) for i in range(0, len(flat), 2))
+
+    def set(self, key: K, value: V) -> PersistentDict[K, V]:
+        return type(self)._C(b"_set", self, key, value)
+
+    def erase(self, key: K) -> PersistentDict[K, V]:
+        return type(self)._C(b"_erase", self, key)
+
+    def __eq__(self, other: Any) -> bool:
+        if isinstance(other, PersistentDict) and self._mlc_address == other._mlc_address:
+            return True
+        if not isinstance(other, (PersistentDict, dict)) or len(self) != len(other):
+            return False
+        return all(k in other and v == other[k] for k, v in self._items())
+
+    def __ne__(self, other: Any) -> bool:
+        return not (self == other)
+
+    def py(self) -> dict[K, V]:
+        return {k: v.py() if hasattr(v, "py") else v for k, v in self._items()}
+
+    def __hash__(self) -> int:
+        return hash((type(self), self._mlc_address))
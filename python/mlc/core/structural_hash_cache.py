@@ -0,0 +1,35 @@
+from __future__ import annotations
+
+from typing import Any
+
+from mlc.core import Object
+from mlc.dataclasses import c_class
+
+
+@c_class("mlc.core.StructuralHashCache", init=False)
+class StructuralHashCache(Object):
+    """Memoizes structural hashes of immutable, variable-free subtrees across calls.
+
+    Only frozen containers, persistent containers and objects whose fields are all frozen are
+    cached, unless `assume_immutable` is set. The caller must `invalidate` any cached object
+    that gets mutated, together with its cached ancestors.
+    """
+
+    assume_immutable: bool
+    num_hits: int
+    num_misses: int
+
+    def __init__(self, assume_immutable: bool = False) -> None:
+        self._mlc_init(assume_immutable)
+
+    def __len__(self) -> int:
+        return StructuralHashCache._C(b"__len__", self)
+
+    def hash(self, obj: Any) -> int:
+        return StructuralHashCache._C(b"hash", self, obj)
+
+    def invalidate(self, obj: Any) -> None:
+        StructuralHashCache._C(b"invalidate", self, obj)
+
+    def clear(self) -> None:
+        StructuralHashCache._C(b"clear", self)
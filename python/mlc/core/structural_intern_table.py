@@ -0,0 +1,35 @@
+from __future__ import annotations
+
+from typing import Any
+
+from mlc.core import Object
+from mlc.dataclasses import c_class
+
+
+@c_class("mlc.core.StructuralInternTable", init=False)
+class StructuralInternTable(Object):
+    """Hash-conses objects, so that structurally identical subgraphs share one representative.
+
+    Objects are merged if they are of the same type and their fields are equal, with children
+    compared by identity, so variables, and expressions over different variables, are never
+    merged. Interned objects are shared by all their users and must not be mutated afterwards.
+    """
+
+    num_lookups: int
+    num_merged: int
+    bytes_saved: int
+
+    def __init__(self) -> None:
+        self._mlc_init()
+
+    def __len__(self) -> int:
+        return StructuralInternTable._C(b"__len__", self)
+
+    def intern(self, obj: Any) -> Any:
+        return StructuralInternTable._C(b"intern", self, obj)
+
+    def intern_graph(self, root: Any) -> Any:
+        return StructuralInternTable._C(b"intern_graph", self, root)
+
+    def clear(self) -> None:
+        StructuralInternTable._C(b"clear", self)
@@ -0,0 +1,52 @@
+from __future__ import annotations
+
+from collections.abc import Iterable
+from typing import Any, TypeVar
+
+import numpy as np
+
+from mlc._cython import c_class_core, typed_list_to_dlpack
+
+from .dtype import DataType
+from .list import List
+
+T = TypeVar("T")
+
+_ELEM_TYPE_TO_INDEX: dict[type, int] = {bool: 1, int: 2, float: 3, DataType: 5}
+_INDEX_TO_ELEM_TYPE: dict[int, type] = {v: k for k, v in _ELEM_TYPE_TO_INDEX.items()}
+
+
+@c_class_core("object.TypedList")
+class TypedList(List[T]):
+    """A list of `bool`, `int`, `float` or `DataType` stored as packed raw values.
+
+    It behaves like `List`, and lists of `bool`, `int` or `float` can be exported without
+    copying via DLPack, e.g. `np.from_dlpack(typed_list)`. Growing the list reallocates
+    its buffer, which invalidates previously exported views.
+    """
+
+    elem_type_index: int
+
+    def __init__(self, elem_type: type[T], iterable: Iterable[T] = ()) -> None:
+        if (elem_type_index := _ELEM_TYPE_TO_INDEX.get(elem_type)) is None:
+            raise TypeError(f"Unsupported element type of `TypedList`: {elem_type}")
+        self._mlc_init(elem_type_index, *iterable)
+
+    @property
+    def elem_type(self) -> type[T]:
+        return _INDEX_TO_ELEM_TYPE[self.elem_type_index]
+
+    def to_list(self) -> List[T]:
+        return type(self)._C(b"_to_list", self)
+
+    def to_py(self, depth: int = -1) -> list[Any]:
+        return self.to_list().to_py(depth)
+
+    def __dlpack__(self, stream: Any = None) -> Any:
+        return typed_list_to_dlpack(self)
+
+    def __dlpack_device__(self) -> tuple[int, int]:
+        return (1, 0)  # kDLCPU
+
+    def numpy(self) -> np.ndarray:
+        return np.from_dlpack(self)
@@ -0,0 +1,296 @@
+#include "./common.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mlc/core/all.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace mlc;
+
+UDict PoolStats() { return (*Func::GetGlobal("mlc.core.PoolAllocatorStats"))().operator UDict(); }
+
+int64_t PoolStat(const UDict &stats, int64_t size_class, const char *key) {
+  return stats->at("size_classes").operator UList()[size_class].operator UDict()->at(key).operator int64_t();
+}
+
+TEST(PoolAlloc, Oversized) {
+  EXPECT_EQ(::MLCPoolAlloc(static_cast<int64_t>(::mlc::base::kPoolMaxBytes) + 1), nullptr);
+  ::MLCPoolFree(nullptr);
+}
+
+TEST(PoolAlloc, AlignedAndDistinct) {
+  std::vector<void *> ptrs;
+  for (int64_t num_bytes = 1; num_bytes <= static_cast<int64_t>(::mlc::base::kPoolMaxBytes); ++num_bytes) {
+    void *ptr = ::MLCPoolAlloc(num_bytes);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % ::mlc::base::kPoolAlignment, 0);
+    std::memset(ptr, 0xAB, num_bytes);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(std::set<void *>(ptrs.begin(), ptrs.end()).size(), ptrs.size());
+  for (void *ptr : ptrs) {
+    ::MLCPoolFree(ptr);
+  }
+}
+
+TEST(PoolAlloc, ReuseFreedBlock) {
+  void *a = ::MLCPoolAlloc(48);
+  ::MLCPoolFree(a);
+  void *b = ::MLCPoolAlloc(40);
+  EXPECT_EQ(a, b);
+  ::MLCPoolFree(b);
+}
+
+TEST(PoolAlloc, Stats) {
+  // Use the largest size class, which is unlikely to be touched by objects created in `PoolStats`
+  constexpr int64_t kSizeClass = 15; // 241..256 bytes
+  constexpr int64_t kNum = 1000;
+  UDict before = PoolStats();
+  std::vector<void *> ptrs;
+  for (int64_t i = 0; i < kNum; ++i) {
+    ptrs.push_back(::MLCPoolAlloc(256));
+  }
+  UDict during = PoolStats();
+  EXPECT_EQ(PoolStat(during, kSizeClass, "block_bytes"), 256);
+  EXPECT_EQ(PoolStat(during, kSizeClass, "num_allocs") - PoolStat(before, kSizeClass, "num_allocs"), kNum);
+  EXPECT_EQ(PoolStat(during, kSizeClass, "num_live") - PoolStat(before, kSizeClass, "num_live"), kNum);
+  EXPECT_GE(PoolStat(during, kSizeClass, "num_slabs"), 1);
+  for (void *ptr : ptrs) {
+    ::MLCPoolFree(ptr);
+  }
+  UDict after = PoolStats();
+  EXPECT_EQ(PoolStat(after, kSizeClass, "num_frees") - PoolStat(before, kSizeClass, "num_frees"), kNum);
+  EXPECT_EQ(PoolStat(after, kSizeClass, "num_live"), PoolStat(before, kSizeClass, "num_live"));
+}
+
+TEST(PoolAlloc, CrossThreadFree) {
+  constexpr int64_t kSizeClass = 13; // 209..224 bytes
+  constexpr int64_t kNum = 10000;
+  UDict before = PoolStats();
+  std::vector<void *> ptrs(kNum);
+  std::thread producer([&]() {
+    for (int64_t i = 0; i < kNum; ++i) {
+      ptrs[i] = ::MLCPoolAlloc(224);
+    }
+  });
+  producer.join();
+  std::thread consumer([&]() {
+    for (void *ptr : ptrs) {
+      ::MLCPoolFree(ptr);
+    }
+  });
+  consumer.join();
+  UDict after = PoolStats();
+  EXPECT_EQ(PoolStat(after, kSizeClass, "num_live"), PoolStat(before, kSizeClass, "num_live"));
+  EXPECT_EQ(PoolStat(after, kSizeClass, "num_allocs") - PoolStat(before, kSizeClass, "num_allocs"), kNum);
+}
+
+int64_t ArenaStat(const char *key) { return PoolStats()->at("arena").operator UDict()->at(key).operator int64_t(); }
+
+TEST(ArenaScope, NoActiveScope) { EXPECT_EQ(::MLCArenaAlloc(16), nullptr); }
+
+TEST(ArenaScope, AllocateAndRelease) {
+  int64_t num_promoted = ArenaStat("num_promoted");
+  {
+    ArenaScope arena;
+    EXPECT_EQ(arena.NumLive(), 0);
+    Str s("arena");
+    Ref<int64_t> boxed(42);
+    UList list{1, 2, 3};
+    EXPECT_EQ(s->_mlc_header.v.deleter, DefaultObjectAllocator<core::StrPad>::DeleterArenaWithPad);
+    EXPECT_EQ(arena.NumLive(), 3);
+    EXPECT_EQ(s, "arena");
+    EXPECT_EQ(*boxed, 42);
+    EXPECT_EQ(list[2].operator int64_t(), 3);
+  }
+  EXPECT_FALSE(::mlc::base::arena_active);
+  EXPECT_EQ(ArenaStat("num_promoted"), num_promoted);
+}
+
+TEST(ArenaScope, LargeObjectFallsBack) {
+  ArenaScope arena;
+  Str s(std::string(8192, 'x').c_str());
+  EXPECT_EQ(arena.NumLive(), 0);
+  EXPECT_EQ(s->length(), 8192);
+}
+
+TEST(ArenaScope, Nested) {
+  ArenaScope outer;
+  Str a("outer");
+  {
+    ArenaScope inner;
+    Str b("inner");
+    EXPECT_EQ(inner.NumLive(), 1);
+    EXPECT_EQ(outer.NumLive(), 1);
+  }
+  EXPECT_TRUE(::mlc::base::arena_active);
+  Str c("outer again");
+  EXPECT_EQ(outer.NumLive(), 2);
+}
+
+TEST(ArenaScope, EscapePromotesArena) {
+  int64_t num_promoted = ArenaStat("num_promoted");
+  int64_t num_escaped = ArenaStat("num_escaped");
+  UList escaped;
+  {
+    ArenaScope arena;
+    for (int i = 0; i < 10000; ++i) {
+      Str s("scratch");
+      if (i % 1000 == 0) {
+        escaped->push_back(Str("escaped_" + std::to_string(i)));
+      }
+    }
+    EXPECT_EQ(arena.NumLive(), 10);
+  }
+  EXPECT_EQ(ArenaStat("num_promoted") - num_promoted, 1);
+  EXPECT_EQ(ArenaStat("num_escaped") - num_escaped, 10);
+  EXPECT_EQ(escaped[0].operator Str(), "escaped_0");
+  EXPECT_EQ(escaped[9].operator Str(), "escaped_9000");
+  escaped->clear();
+}
+
+TEST(ArenaScope, EscapeFreedByAnotherThread) {
+  std::vector<Str> escaped;
+  {
+    ArenaScope arena;
+    for (int i = 0; i < 1000; ++i) {
+      escaped.push_back(Str("escaped_" + std::to_string(i)));
+    }
+  }
+  std::thread consumer([escaped = std::move(escaped)]() mutable {
+    EXPECT_EQ(escaped.back(), "escaped_999");
+    escaped.clear();
+  });
+  consumer.join();
+}
+
+TEST(ArenaScope, OtherThreadsUnaffected) {
+  ArenaScope arena;
+  std::thread other([]() {
+    Str s("not in arena");
+    EXPECT_NE(s->_mlc_header.v.deleter, DefaultObjectAllocator<core::StrPad>::DeleterArenaWithPad);
+  });
+  other.join();
+  EXPECT_EQ(arena.NumLive(), 0);
+}
+
+TEST(DeferredDelete, DeepList) {
+  // Destroying this recursively would overflow the stack
+  UList list;
+  for (int i = 0; i < 1000000; ++i) {
+    list = UList{list};
+  }
+  list.Reset();
+}
+
+struct DeleteRecorder {
+  explicit DeleteRecorder(std::atomic<int> *num_deleted, std::thread::id *deleted_by)
+      : num_deleted(num_deleted), deleted_by(deleted_by) {}
+  ~DeleteRecorder() {
+    *deleted_by = std::this_thread::get_id();
+    num_deleted->fetch_add(1);
+  }
+  std::atomic<int> *num_deleted;
+  std::thread::id *deleted_by;
+};
+
+TEST(DeferredDelete, BackgroundReclaimer) {
+  std::atomic<int> num_deleted{0};
+  std::thread::id deleted_by;
+  (*Func::GetGlobal("mlc.core.SetBackgroundReclaimer"))(true);
+  {
+    auto recorder = std::make_shared<DeleteRecorder>(&num_deleted, &deleted_by);
+    UList list{Func([recorder]() {})};
+    for (int i = 0; i < 1000; ++i) {
+      list = UList{list};
+    }
+  }
+  (*Func::GetGlobal("mlc.core.FlushBackgroundReclaimer"))();
+  EXPECT_EQ(num_deleted.load(), 1);
+  EXPECT_NE(deleted_by, std::this_thread::get_id());
+  (*Func::GetGlobal("mlc.core.SetBackgroundReclaimer"))(false);
+  {
+    auto recorder = std::make_shared<DeleteRecorder>(&num_deleted, &deleted_by);
+    Func func([recorder]() {});
+  }
+  EXPECT_EQ(num_deleted.load(), 2);
+  EXPECT_EQ(deleted_by, std::this_thread::get_id());
+}
+
+int64_t AllocStat(const char *type_key, const char *key) {
+  UDict stats = (*Func::GetGlobal("mlc.core.AllocStats"))().operator UDict();
+  if (stats->count(type_key) == 0) {
+    return 0;
+  }
+  return stats->at(type_key).operator UDict()->at(key).operator int64_t();
+}
+
+TEST(AllocStats, PerType) {
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  int64_t num_allocs = AllocStat("object.List", "num_allocs");
+  int64_t num_frees = AllocStat("object.List", "num_frees");
+  int64_t num_live = AllocStat("object.List", "num_live");
+  int64_t live_bytes = AllocStat("object.List", "live_bytes");
+  int64_t num_boxed = AllocStat("int", "num_allocs");
+  {
+    std::vector<UList> lists(100);
+    Ref<int64_t> boxed(42);
+    EXPECT_EQ(AllocStat("object.List", "num_allocs") - num_allocs, 100);
+    EXPECT_EQ(AllocStat("object.List", "num_live") - num_live, 100);
+    EXPECT_EQ(AllocStat("object.List", "live_bytes") - live_bytes, 100 * int64_t(sizeof(UListObj)));
+    EXPECT_GE(AllocStat("object.List", "peak_live"), 100);
+    EXPECT_EQ(AllocStat("int", "num_allocs") - num_boxed, 1);
+  }
+  EXPECT_EQ(AllocStat("object.List", "num_frees") - num_frees, 100);
+  EXPECT_EQ(AllocStat("object.List", "num_live"), num_live);
+  EXPECT_EQ(AllocStat("object.List", "live_bytes"), live_bytes);
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+}
+
+TEST(AllocStats, VarSized) {
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  int64_t live_bytes = AllocStat("object.Str", "live_bytes");
+  {
+    Str s(std::string(1000, 'x').c_str());
+    EXPECT_GE(AllocStat("object.Str", "live_bytes") - live_bytes, 1000);
+  }
+  EXPECT_EQ(AllocStat("object.Str", "live_bytes"), live_bytes);
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+  {
+    // Allocated while disabled, freed while enabled: ignored
+    Str s(std::string(1000, 'x').c_str());
+    (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  }
+  EXPECT_EQ(AllocStat("object.Str", "live_bytes"), live_bytes);
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+}
+
+TEST(AllocStats, Toggled) {
+  int64_t num_frees = AllocStat("object.List", "num_frees");
+  {
+    // Allocated while disabled, freed while enabled: ignored
+    UList list;
+    (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  }
+  EXPECT_EQ(AllocStat("object.List", "num_frees"), num_frees);
+  EXPECT_GE(AllocStat("object.List", "num_live"), 0);
+  {
+    // Allocated while enabled, freed while disabled: forgotten when enabled again
+    UList list;
+    (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+  }
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  int64_t num_live = AllocStat("object.List", "num_live");
+  {
+    UList list;
+    EXPECT_EQ(AllocStat("object.List", "num_live"), num_live + 1);
+  }
+  EXPECT_EQ(AllocStat("object.List", "num_live"), num_live);
+  EXPECT_GE(num_live, 0);
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+}
+
+} // namespace
@@ -794,4 +794,41 @@ static_assert(!std::is_convertible<Ref<int64_t>, Ref<double>>::value,
               "Ref<int64_t> should not be convertible to Ref<double>");
 static_assert(!std::is_convertible<Ref<double>, Ref<int64_t>>::value,
               "Ref<double> should not be convertible to Ref<int64_t>");
+
+// Tests for immortal objects
+
+TEST(Immortal, SkipsRefCounting) {
+  Ref<TestObj> ref = Ref<TestObj>::New(42);
+  MLCAny *ptr = reinterpret_cast<MLCAny *>(ref.get());
+  ::mlc::base::MakeImmortal(ptr);
+  EXPECT_TRUE(::mlc::base::IsImmortal(ptr));
+  {
+    Ref<TestObj> copy = ref;
+    Any any = ref;
+    EXPECT_EQ(GetRefCount(ref), ::mlc::base::kImmortalRefCnt);
+  }
+  ref.Reset();
+  EXPECT_EQ(ptr->ref_cnt, ::mlc::base::kImmortalRefCnt);
+  EXPECT_EQ(reinterpret_cast<TestObj *>(ptr)->data, 42);
+}
+
+TEST(Immortal, RegisteredObjects) {
+  FuncObj *func = Func::GetGlobal("mlc.core.StructuralHash");
+  EXPECT_TRUE(::mlc::base::IsImmortal(reinterpret_cast<MLCAny *>(func)));
+}
+
+TEST(Immortal, ReplacedObjectsAreReleased) {
+  MLCVTableHandle vtable = nullptr;
+  ASSERT_EQ(::MLCVTableCreate(nullptr, "mlc.testing.immortal", &vtable), 0);
+  Func first([](int64_t x) { return x; });
+  Func second([](int64_t x) { return x + 1; });
+  ASSERT_EQ(::MLCVTableSetFunc(vtable, TestObj::_type_index, first.get(), /*override_mode=*/0), 0);
+  EXPECT_FALSE(::mlc::base::IsImmortal(reinterpret_cast<MLCAny *>(first.get())));
+  EXPECT_EQ(GetRefCount(first), 2);
+  ASSERT_EQ(::MLCVTableSetFunc(vtable, TestObj::_type_index, second.get(), /*override_mode=*/1), 0);
+  EXPECT_EQ(GetRefCount(first), 1);
+  EXPECT_EQ(GetRefCount(second), 2);
+  ASSERT_EQ(::MLCVTableDelete(vtable), 0);
+}
+
 } // namespace
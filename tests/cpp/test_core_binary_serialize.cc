@@ -0,0 +1,148 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+#include <cstdio>
+#include <mlc/sym/all.h>
+#include <string>
+
+namespace {
+
+using namespace mlc;
+using mlc::base::DType;
+
+Str Dump(AnyView obj) { return (*Func::GetGlobal("mlc.core.BinarySerialize"))(obj, nullptr); }
+
+Any Load(const Str &data) { return (*Func::GetGlobal("mlc.core.BinaryDeserialize"))(data, -1, nullptr); }
+
+Str DumpJSON(AnyView obj) { return (*Func::GetGlobal("mlc.core.JSONSerialize"))(obj, nullptr); }
+
+bool Equal(AnyView lhs, AnyView rhs) {
+  return (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, true, false).operator bool();
+}
+
+std::string LoadFailure(const std::string &data) {
+  try {
+    Load(Str(std::string(data)));
+  } catch (Exception &e) {
+    return e.what();
+  }
+  return "";
+}
+
+TEST(BinarySerialize, Values) {
+  EXPECT_EQ(Load(Dump(Any())).type_index, kMLCNone);
+  EXPECT_EQ(Load(Dump(true)).operator bool(), true);
+  EXPECT_EQ(Load(Dump(-123456789012)).operator int64_t(), -123456789012);
+  EXPECT_EQ(Load(Dump(0.1)).operator double(), 0.1);
+  EXPECT_TRUE(DType::Equal(Load(Dump(DType::Int(32))).operator DLDataType(), DType::Int(32)));
+  EXPECT_EQ(Load(Dump(DLDevice{kDLCUDA, 3})).operator DLDevice().device_id, 3);
+  EXPECT_EQ(Load(Dump(Str(std::string("a\0b", 3)))).operator Str()->size(), 3);
+}
+
+TEST(BinarySerialize, Containers) {
+  UList list{1, 2.5, "three", UList{4, nullptr, false}, UDict{{"k", 5}, {6, "v"}}};
+  UList loaded = Load(Dump(list));
+  EXPECT_TRUE(Equal(loaded, list));
+  PersistentDict dict{{"x", PersistentList{1, 2}}, {"y", 3}};
+  PersistentDict loaded_dict = Load(Dump(dict));
+  EXPECT_EQ(loaded_dict["y"].operator int64_t(), 3);
+  EXPECT_EQ(loaded_dict["x"].operator PersistentList().size(), 2);
+  TypedList<double> typed{0.5, -1.25};
+  TypedList<double> loaded_typed(Load(Dump(typed)).operator UTypedList());
+  ASSERT_EQ(loaded_typed.size(), 2);
+  EXPECT_EQ(loaded_typed[1], -1.25);
+}
+
+TEST(BinarySerialize, SharedObjects) {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  Expr e = (x + 1) * y;
+  UList module{e, e, x, UList{e, Str("name")}};
+  UList loaded = Load(Dump(module));
+  EXPECT_TRUE(Equal(loaded, module));
+  EXPECT_TRUE(loaded[0].operator ObjectRef().same_as(loaded[1].operator ObjectRef()));
+  EXPECT_TRUE(loaded[2].operator ObjectRef().same_as(loaded[0].operator Mul()->a->as<AddObj>()->a));
+  EXPECT_LT(Dump(module)->size(), DumpJSON(module)->size());
+}
+
+TEST(BinarySerialize, Tensor) {
+  TypedList<double> data;
+  for (int i = 0; i < 1000; ++i) {
+    data.push_back(static_cast<double>(i) * 0.5);
+  }
+  Tensor tensor(data->DLPack());
+  UList list{1, tensor, tensor};
+  Str binary = Dump(list);
+  UList loaded = Load(binary);
+  ASSERT_TRUE(loaded[1].operator ObjectRef().same_as(loaded[2].operator ObjectRef()));
+  Tensor loaded_tensor = loaded[1];
+  ASSERT_EQ(loaded_tensor->tensor.ndim, 1);
+  EXPECT_EQ(loaded_tensor->tensor.shape[0], 1000);
+  EXPECT_EQ(static_cast<double *>(loaded_tensor->tensor.data)[999], 999 * 0.5);
+  // Raw data takes 8000 bytes, while base64 in JSON takes a third more
+  EXPECT_LT(binary->size(), 8200);
+  EXPECT_GT(DumpJSON(list)->size(), 10600);
+}
+
+TEST(BinarySerialize, MalformedInput) {
+  std::string binary(Dump(UList{1, "a", UList{2}})->data(), Dump(UList{1, "a", UList{2}})->size());
+  EXPECT_NE(LoadFailure("not a binary").find("Magic number mismatch"), std::string::npos);
+  EXPECT_NE(LoadFailure(binary.substr(0, binary.size() - 3)).find("BinaryDeserialize"), std::string::npos);
+  std::string corrupted = binary;
+  corrupted[16] = 9; // type ref not yet defined
+  EXPECT_NE(LoadFailure(corrupted).find("not yet defined"), std::string::npos);
+  EXPECT_TRUE(Equal(Load(Str(std::string(binary))), UList{1, "a", UList{2}}));
+}
+
+TEST(BinarySerialize, MalformedTensorShape) {
+  TypedList<double> data{0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+  Str dumped = Dump(Tensor(data->DLPack()));
+  std::string binary(dumped->data(), dumped->size());
+  // ndim = 1, dtype = float64, shape = [6]
+  std::string header("\x01\x02\x40\x01\x00\x0c", 6);
+  size_t pos = binary.find(header);
+  ASSERT_NE(pos, std::string::npos);
+  size_t shape_pos = pos + header.size() - 1;
+  std::string negative = binary;
+  negative[shape_pos] = '\x0b'; // shape = [-6]
+  EXPECT_NE(LoadFailure(negative).find("Negative tensor dimension"), std::string::npos);
+  // shape = [2^61], whose byte size wraps around to 0
+  std::string overflow = binary.substr(0, shape_pos) + std::string(8, '\x80') + '\x40' + binary.substr(shape_pos + 1);
+  EXPECT_NE(LoadFailure(overflow).find("Tensor size exceeds input"), std::string::npos);
+}
+
+TEST(BinarySerialize, LoadMapped) {
+  TypedList<double> data;
+  for (int i = 0; i < 100000; ++i) {
+    data.push_back(static_cast<double>(i));
+  }
+  Tensor tensor(data->DLPack());
+  std::string path = ::testing::TempDir() + "mlc_binary_load_test.bin";
+  (*Func::GetGlobal("mlc.core.BinarySerializeTo"))(UList{tensor, "name", tensor}, path, nullptr);
+  for (bool lazy : {false, true}) {
+    Tensor loaded_tensor = [&]() -> Tensor {
+      UList loaded = (*Func::GetGlobal("mlc.core.BinaryLoad"))(path, lazy, nullptr);
+      EXPECT_EQ(loaded[1].operator Str()->data(), std::string("name"));
+      EXPECT_TRUE(loaded[0].operator ObjectRef().same_as(loaded[2].operator ObjectRef()));
+      return loaded[0];
+    }();
+    // The payload is used in place, and the mapping outlives the rest of the graph
+    EXPECT_NE(loaded_tensor->manager_ctx, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded_tensor->tensor.data) % 64, 0);
+    ASSERT_EQ(loaded_tensor->tensor.shape[0], 100000);
+    if (lazy) {
+      EXPECT_EQ(static_cast<DLManagedTensor *>(loaded_tensor->manager_ctx)->dl_tensor.shape[0], 100000);
+    }
+    double *values = static_cast<double *>(loaded_tensor->tensor.data);
+    EXPECT_EQ(values[0], 0.0);
+    EXPECT_EQ(values[99999], 99999.0);
+    // Writes are private to the process, and do not reach the file
+    values[0] = -1.0;
+  }
+  Tensor reloaded = (*Func::GetGlobal("mlc.core.BinaryLoad"))(path, true, nullptr).operator UList()[0];
+  EXPECT_EQ(static_cast<double *>(reloaded->tensor.data)[0], 0.0);
+  std::remove(path.c_str());
+  EXPECT_THROW((*Func::GetGlobal("mlc.core.BinaryLoad"))(path, true, nullptr), Exception);
+}
+
+} // namespace
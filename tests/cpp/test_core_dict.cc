@@ -79,6 +79,19 @@ TEST(DictKV, AtMethod) {
   EXPECT_THROW(dict.at(3), mlc::Exception);
 }
 
+TEST(DictKV, Freeze) {
+  Dict<Str, int64_t> dict{{"x", 1}, {"y", 2}};
+  dict.freeze();
+  EXPECT_EQ(dict.at("x"), 1);
+  EXPECT_EQ(dict.count("y"), 1);
+  EXPECT_EQ(dict.count("z"), 0);
+  int64_t sum = 0;
+  for (const auto &kv : dict) {
+    sum += kv.second;
+  }
+  EXPECT_EQ(sum, 3);
+}
+
 TEST(DictKV, CountMethod) {
   Dict<Str, int> dict{{"key1", 1}, {"key2", 2}};
   EXPECT_EQ(dict.count("key1"), 1);
@@ -0,0 +1,163 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+#include <string>
+
+namespace {
+
+using namespace mlc;
+
+Any Parse(const std::string &json) { return (*Func::GetGlobal("mlc.core.JSONParse"))(Str(json)); }
+
+std::string ToString(AnyView str) {
+  Str s = str;
+  return std::string(s->data(), s->size());
+}
+
+std::string ParseFailure(const std::string &json) {
+  try {
+    Parse(json);
+  } catch (Exception &e) {
+    return e.what();
+  }
+  return "";
+}
+
+TEST(JSONParse, Values) {
+  UList list = Parse(" [null, true,false , 0, -12, 123456789012345678, 1234567890123456789, 2.5, -1e3, 007] ");
+  ASSERT_EQ(list.size(), 10);
+  EXPECT_EQ(list[0].type_index, kMLCNone);
+  EXPECT_EQ(list[1].operator bool(), true);
+  EXPECT_EQ(list[2].operator bool(), false);
+  EXPECT_EQ(list[3].operator int64_t(), 0);
+  EXPECT_EQ(list[4].operator int64_t(), -12);
+  EXPECT_EQ(list[5].operator int64_t(), 123456789012345678);
+  EXPECT_EQ(list[6].operator int64_t(), 1234567890123456789);
+  EXPECT_EQ(list[7].operator double(), 2.5);
+  EXPECT_EQ(list[8].operator double(), -1000.0);
+  EXPECT_EQ(list[9].operator int64_t(), 7);
+  // Beyond the range of int64
+  EXPECT_EQ(Parse("99999999999999999999").type_index, kMLCFloat);
+  EXPECT_EQ(Parse("\t\n\v\f\r42\r\n").operator int64_t(), 42);
+}
+
+TEST(JSONParse, Containers) {
+  UDict dict = Parse(R"({"a": [1, {"b": []}], "c": {}, "d" :"e"})");
+  ASSERT_EQ(dict.size(), 3);
+  UList a = dict["a"];
+  EXPECT_EQ(a[0].operator int64_t(), 1);
+  EXPECT_EQ(a[1].operator UDict()["b"].operator UList().size(), 0);
+  EXPECT_EQ(dict["c"].operator UDict().size(), 0);
+  EXPECT_EQ(ToString(dict["d"]), "e");
+}
+
+TEST(JSONParse, Strings) {
+  UList list = Parse(R"(["", "plain", "a\"b", "\\", "\n\t\r", "\x41é中", "\q", "[1, {\"k\": 2}]"])");
+  ASSERT_EQ(list.size(), 8);
+  EXPECT_EQ(ToString(list[0]), "");
+  EXPECT_EQ(ToString(list[1]), "plain");
+  EXPECT_EQ(ToString(list[2]), "a\"b");
+  EXPECT_EQ(ToString(list[3]), "\\");
+  EXPECT_EQ(ToString(list[4]), "\n\t\r");
+  EXPECT_EQ(ToString(list[5]), "A\xC3\xA9\xE4\xB8\xAD");
+  EXPECT_EQ(ToString(list[6]), "q");
+  EXPECT_EQ(ToString(list[7]), "[1, {\"k\": 2}]");
+}
+
+TEST(JSONParse, BlockBoundaries) {
+  // Input is classified in blocks of 64 bytes, so move runs of backslashes, escaped quotes and tokens across them
+  for (std::string escaped : {"\\\\", "\\\"", "\\\\\\\"", "\\\\\\\\"}) {
+    std::string expected = escaped.size() == 2 ? escaped.substr(1) : escaped == "\\\\\\\"" ? "\\\"" : "\\\\";
+    for (int pad = 0; pad < 140; ++pad) {
+      std::string str(pad, 'x');
+      std::string json = "[" + std::string(pad % 7, ' ') + "\"" + str + escaped + "\", 12345, true, \"" + str + "\"]";
+      UList list = Parse(json);
+      ASSERT_EQ(list.size(), 4) << json;
+      EXPECT_EQ(ToString(list[0]), str + expected) << json;
+      EXPECT_EQ(list[1].operator int64_t(), 12345) << json;
+      EXPECT_EQ(list[2].operator bool(), true) << json;
+      EXPECT_EQ(ToString(list[3]), str) << json;
+    }
+  }
+}
+
+TEST(JSONParse, ErrorMessages) {
+  EXPECT_EQ(ParseFailure("[1, 2,]"),
+            "JSON parsing failure at position 6: Unexpected character: ]. JSON string: [1, 2,]");
+  EXPECT_EQ(ParseFailure(R"({"a" 1})"),
+            R"(JSON parsing failure at position 5: Expected ':' but got '1'. JSON string: {"a" 1})");
+  EXPECT_EQ(ParseFailure(R"(["abc)"), R"(JSON parsing failure at position 5: Unterminated string. JSON string: ["abc)");
+  EXPECT_EQ(ParseFailure("[1] x"),
+            "JSON parsing failure at position 4: Extra data after valid JSON. JSON string: [1] x");
+  EXPECT_EQ(ParseFailure("[tru]"), "JSON parsing failure at position 1: Expected 'true. JSON string: [tru]");
+  EXPECT_EQ(ParseFailure("[nullx]"),
+            "JSON parsing failure at position 5: Expected ',' but got 'x'. JSON string: [nullx]");
+  EXPECT_EQ(ParseFailure("[1.2.3]"), "JSON parsing failure at position 6: Invalid number format. JSON string: [1.2.3]");
+  EXPECT_EQ(ParseFailure(R"(["\x4"])"), R"(Invalid hexadecimal escape sequence at position 2 in string: ["\x4"])");
+  EXPECT_EQ(ParseFailure("").rfind("JSON parsing failure at position 0: Unexpected character: ", 0), 0u);
+}
+
+Any Deserialize(const std::string &json) {
+  return (*Func::GetGlobal("mlc.core.JSONDeserialize"))(Str(json), nullptr);
+}
+
+std::string DeserializeFailure(const std::string &json) {
+  try {
+    Deserialize(json);
+  } catch (Exception &e) {
+    return e.what();
+  }
+  return "";
+}
+
+bool Equal(AnyView lhs, AnyView rhs) {
+  return (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, true, false).operator bool();
+}
+
+TEST(JSONDeserialize, RoundTrip) {
+  using namespace mlc::sym;
+  Var x("x", mlc::base::DType::Int(64));
+  TypedList<double> data{0.5, 1.5, 2.5};
+  UList obj{(x + 1) * x, UDict{{"key", "value"}, {"list", UList{1, 2.5, nullptr, true}}}, Tensor(data->DLPack()), x};
+  Str json = (*Func::GetGlobal("mlc.core.JSONSerialize"))(obj, nullptr);
+  UList ret = Deserialize(std::string(json->data(), json->size()));
+  EXPECT_TRUE(Equal(obj[0], ret[0]));
+  EXPECT_TRUE(Equal(obj[1], ret[1]));
+  EXPECT_EQ(ret[0].operator Expr()->as<MulObj>()->b.get(), ret[3].operator Expr().get());
+  Tensor tensor = ret[2];
+  ASSERT_EQ(tensor->tensor.shape[0], 3);
+  EXPECT_EQ(static_cast<const double *>(tensor->tensor.data)[2], 2.5);
+}
+
+TEST(JSONDeserialize, MemberOrder) {
+  // `type_keys` may come before `values`, and unknown members are ignored
+  UList ret = Deserialize(R"( { "type_keys" : ["object.List", "int"], "extra": {"a": [1]},
+                                "values": ["a", [0, 0, [1, 5], 2.5], [0, 1, 0]] } )");
+  ASSERT_EQ(ret.size(), 2);
+  UList inner = ret[0];
+  EXPECT_EQ(ToString(inner[0]), "a");
+  EXPECT_EQ(inner[1].operator int64_t(), 5);
+  EXPECT_EQ(inner[2].operator double(), 2.5);
+  // References resolve to the same objects
+  EXPECT_EQ(ret[1].operator Object *(), inner[0].operator Object *());
+}
+
+TEST(JSONDeserialize, Errors) {
+  EXPECT_EQ(DeserializeFailure(R"({"values": ["a", [0, 3]], "type_keys": ["object.List"]})"),
+            "Invalid reference when parsing type `object.List`: referring #3 at #1");
+  EXPECT_EQ(DeserializeFailure(R"({"values": ["a"]})"), "type_keys");
+  EXPECT_EQ(DeserializeFailure(R"({"values": [[0, 0]], "type_keys": ["mlc.core.Tensor"]})"),
+            "Invalid reference when parsing type `mlc.core.Tensor`: referring #0 of 0 at #0");
+  EXPECT_EQ(DeserializeFailure(R"({"values": [[0, -1]], "type_keys": ["mlc.core.Tensor"]})"),
+            "Invalid reference when parsing type `mlc.core.Tensor`: referring #-1 of 0 at #0");
+  EXPECT_EQ(DeserializeFailure(R"({"values": [[0, 0]], "type_keys": ["mlc.core.Opaque"]})"),
+            "Invalid reference when parsing type `mlc.core.Opaque`: referring #0 of 0 at #0");
+  EXPECT_EQ(DeserializeFailure(R"({"values": ["a", [0, 0 1]], "type_keys": ["object.List"]})"),
+            R"(JSON parsing failure at position 23: Expected ',' but got '1'. JSON string: )"
+            R"({"values": ["a", [0, 0 1]], "type_keys": ["object.List"]})");
+  EXPECT_NE(DeserializeFailure(R"({"values": ["a], "type_keys": []})").find("Unterminated string"), std::string::npos);
+  EXPECT_NE(DeserializeFailure(R"({"values": ["a"], "type_keys": [] x)").find("Expected ','"), std::string::npos);
+}
+
+} // namespace
@@ -0,0 +1,164 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+
+namespace {
+
+using namespace mlc;
+
+Any CallGlobal(const char *name, AnyView arg) { return (*Func::GetGlobal(name))(arg); }
+
+std::vector<int64_t> ToVector(const PersistentList &list) {
+  std::vector<int64_t> ret;
+  list.ForEach([&ret](const Any &elem) { ret.push_back(elem.operator int64_t()); });
+  return ret;
+}
+
+TEST(PersistentList, DefaultConstructor) {
+  PersistentList list;
+  EXPECT_EQ(list.size(), 0);
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list->__str__(), "[]");
+}
+
+TEST(PersistentList, UpdatesLeaveOriginalIntact) {
+  PersistentList a{1, 2, 3};
+  PersistentList b = a.set(1, 20);
+  PersistentList c = a.insert(0, 0);
+  PersistentList d = a.erase(2);
+  PersistentList e = a.push_back(4);
+  EXPECT_EQ(ToVector(a), (std::vector<int64_t>{1, 2, 3}));
+  EXPECT_EQ(ToVector(b), (std::vector<int64_t>{1, 20, 3}));
+  EXPECT_EQ(ToVector(c), (std::vector<int64_t>{0, 1, 2, 3}));
+  EXPECT_EQ(ToVector(d), (std::vector<int64_t>{1, 2}));
+  EXPECT_EQ(ToVector(e), (std::vector<int64_t>{1, 2, 3, 4}));
+  EXPECT_EQ(e->__str__(), "[1, 2, 3, 4]");
+  EXPECT_TRUE(a.erase(0).erase(0).pop_back().empty());
+}
+
+TEST(PersistentList, ManyElements) {
+  constexpr int64_t n = 5000;
+  std::vector<int64_t> expected;
+  PersistentList list;
+  for (int64_t i = 0; i < n; ++i) {
+    // Alternate between appending and inserting in the middle to exercise node splits everywhere
+    int64_t pos = (i % 2 == 0) ? static_cast<int64_t>(expected.size()) : static_cast<int64_t>(expected.size()) / 2;
+    list = list.insert(pos, i);
+    expected.insert(expected.begin() + pos, i);
+  }
+  ASSERT_EQ(list.size(), n);
+  EXPECT_EQ(ToVector(list), expected);
+  for (int64_t i = 0; i < n; i += 97) {
+    EXPECT_EQ(list[i].operator int64_t(), expected[i]);
+  }
+  PersistentList snapshot = list;
+  for (int64_t i = 0; i < n / 2; ++i) {
+    int64_t pos = (i * 7919) % list.size();
+    list = list.erase(pos);
+    expected.erase(expected.begin() + pos);
+  }
+  EXPECT_EQ(ToVector(list), expected);
+  EXPECT_EQ(snapshot.size(), n);
+  EXPECT_EQ(snapshot[0].operator int64_t(), ToVector(snapshot)[0]);
+}
+
+TEST(PersistentList, OutOfRange) {
+  PersistentList list{1, 2};
+  EXPECT_THROW(list.at(2), Exception);
+  EXPECT_THROW(list.set(-3, 0), Exception);
+  EXPECT_THROW(list.insert(3, 0), Exception);
+  EXPECT_THROW(PersistentList().pop_back(), Exception);
+}
+
+TEST(PersistentDict, SetFindErase) {
+  PersistentDict a{{"a", 1}, {"b", 2}};
+  PersistentDict b = a.set("c", 3);
+  PersistentDict c = b.set("a", 10);
+  PersistentDict d = c.erase("b");
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_EQ(b.size(), 3);
+  EXPECT_EQ(c.size(), 3);
+  EXPECT_EQ(d.size(), 2);
+  EXPECT_EQ(a["a"].operator int64_t(), 1);
+  EXPECT_EQ(c["a"].operator int64_t(), 10);
+  EXPECT_EQ(a.count("c"), 0);
+  EXPECT_EQ(b.count("c"), 1);
+  EXPECT_EQ(d.find("b"), nullptr);
+  EXPECT_THROW(d.at("b"), Exception);
+  EXPECT_EQ(d.erase("missing").size(), 2);
+}
+
+TEST(PersistentDict, ManyKeys) {
+  constexpr int64_t n = 10000;
+  PersistentDict dict;
+  for (int64_t i = 0; i < n; ++i) {
+    dict = dict.set(i, i * 2);
+  }
+  ASSERT_EQ(dict.size(), n);
+  PersistentDict snapshot = dict;
+  for (int64_t i = 0; i < n; i += 2) {
+    dict = dict.erase(i);
+  }
+  ASSERT_EQ(dict.size(), n / 2);
+  for (int64_t i = 0; i < n; ++i) {
+    EXPECT_EQ(dict.count(i), i % 2);
+    EXPECT_EQ(snapshot.at(i).operator int64_t(), i * 2);
+  }
+  int64_t num_items = 0;
+  dict.ForEach([&num_items](const Any &key, const Any &value) {
+    EXPECT_EQ(value.operator int64_t(), key.operator int64_t() * 2);
+    ++num_items;
+  });
+  EXPECT_EQ(num_items, n / 2);
+  for (int64_t i = 1; i < n; i += 2) {
+    dict = dict.erase(i);
+  }
+  EXPECT_TRUE(dict.empty());
+}
+
+TEST(PersistentDict, ObjectKeys) {
+  std::vector<Str> keys;
+  PersistentDict dict;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(Str(std::to_string(i)));
+    dict = dict.set(keys.back(), i);
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(dict[Str(std::to_string(i))].operator int(), i);
+  }
+}
+
+TEST(Persistent, Structural) {
+  FuncObj *eq = Func::GetGlobal("mlc.core.StructuralEqual");
+  PersistentList l1{1, 2, 3};
+  PersistentList l2 = PersistentList{1, 2}.push_back(3);
+  PersistentList l3{1, 2, 4};
+  EXPECT_TRUE((*eq)(l1, l2, true, false).operator bool());
+  EXPECT_FALSE((*eq)(l1, l3, true, false).operator bool());
+  EXPECT_EQ(CallGlobal("mlc.core.StructuralHash", l1).operator int64_t(),
+            CallGlobal("mlc.core.StructuralHash", l2).operator int64_t());
+  PersistentDict d1{{"a", 1}, {"b", 2}};
+  PersistentDict d2 = PersistentDict{{"b", 2}}.set("a", 1);
+  PersistentDict d3{{"a", 1}, {"b", 3}};
+  EXPECT_TRUE((*eq)(d1, d2, true, false).operator bool());
+  EXPECT_FALSE((*eq)(d1, d3, true, false).operator bool());
+  EXPECT_EQ(CallGlobal("mlc.core.StructuralHash", d1).operator int64_t(),
+            CallGlobal("mlc.core.StructuralHash", d2).operator int64_t());
+  EXPECT_NE(CallGlobal("mlc.core.StructuralHash", d1).operator int64_t(),
+            CallGlobal("mlc.core.StructuralHash", d3).operator int64_t());
+}
+
+TEST(Persistent, CopyAndSerialize) {
+  PersistentDict dict{{"x", PersistentList{1, 2}}, {"y", 3}};
+  PersistentDict copied = CallGlobal("mlc.core.CopyDeep", dict).operator PersistentDict();
+  EXPECT_FALSE(copied.same_as(dict));
+  EXPECT_FALSE(copied["x"].operator PersistentList().same_as(dict["x"].operator PersistentList()));
+  EXPECT_EQ(ToVector(copied["x"].operator PersistentList()), (std::vector<int64_t>{1, 2}));
+  Str json = (*Func::GetGlobal("mlc.core.JSONSerialize"))(dict, nullptr);
+  PersistentDict loaded = (*Func::GetGlobal("mlc.core.JSONDeserialize"))(json, nullptr).operator PersistentDict();
+  ASSERT_EQ(loaded.size(), 2);
+  EXPECT_EQ(loaded["y"].operator int64_t(), 3);
+  EXPECT_EQ(ToVector(loaded["x"].operator PersistentList()), (std::vector<int64_t>{1, 2}));
+}
+
+} // namespace
@@ -0,0 +1,113 @@
+#include "./common.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <mlc/core/all.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace mlc;
+using mlc::core::Sink;
+
+// Records every chunk it receives
+struct RecordingSink : public Sink {
+  void Write(const char *data, int64_t size) override {
+    chunk_sizes.push_back(size);
+    content.append(data, static_cast<size_t>(size));
+  }
+  void Flush() override { ++num_flushes; }
+  std::vector<int64_t> chunk_sizes;
+  std::string content;
+  int num_flushes = 0;
+};
+
+struct FailingSink : public Sink {
+  void Write(const char *, int64_t) override { MLC_THROW(ValueError) << "Disk full"; }
+};
+
+UList MakeLargeObject() {
+  TypedList<double> data;
+  for (int i = 0; i < 20000; ++i) {
+    data.push_back(static_cast<double>(i));
+  }
+  UList ret{Tensor(data->DLPack())};
+  for (int i = 0; i < 5000; ++i) {
+    ret.push_back(UList{i, "item_" + std::to_string(i), 0.5 * i});
+  }
+  return ret;
+}
+
+std::string ToString(const Str &str) { return std::string(str->data(), str->size()); }
+
+std::string ReadFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void ExpectFixedSizeChunks(const RecordingSink &sink) {
+  ASSERT_GT(sink.chunk_sizes.size(), 1);
+  for (size_t i = 0; i + 1 < sink.chunk_sizes.size(); ++i) {
+    EXPECT_EQ(sink.chunk_sizes[i], Sink::kChunkSize);
+  }
+  EXPECT_LE(sink.chunk_sizes.back(), Sink::kChunkSize);
+  EXPECT_EQ(sink.num_flushes, 1);
+}
+
+TEST(Sink, JSONInChunks) {
+  UList obj = MakeLargeObject();
+  RecordingSink sink;
+  core::JSONSerializeTo(obj, &sink);
+  ExpectFixedSizeChunks(sink);
+  EXPECT_EQ(sink.content, ToString((*Func::GetGlobal("mlc.core.JSONSerialize"))(obj, nullptr)));
+}
+
+TEST(Sink, BinaryInChunks) {
+  UList obj = MakeLargeObject();
+  RecordingSink sink;
+  core::BinarySerializeTo(obj, &sink);
+  ExpectFixedSizeChunks(sink);
+  EXPECT_EQ(sink.content, ToString((*Func::GetGlobal("mlc.core.BinarySerialize"))(obj, nullptr)));
+}
+
+TEST(Sink, FileDescriptorAndPath) {
+  UList obj{1, "a", UList{2.5, nullptr}};
+  std::string expected = ToString((*Func::GetGlobal("mlc.core.BinarySerialize"))(obj, nullptr));
+  std::FILE *file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  (*Func::GetGlobal("mlc.core.BinarySerializeTo"))(obj, static_cast<int64_t>(fileno(file)), nullptr);
+  std::rewind(file);
+  std::string from_fd(expected.size() + 1, '\0');
+  from_fd.resize(std::fread(&from_fd[0], 1, from_fd.size(), file));
+  std::fclose(file);
+  EXPECT_EQ(from_fd, expected);
+  std::string path = ::testing::TempDir() + "mlc_sink_test.json";
+  (*Func::GetGlobal("mlc.core.JSONSerializeTo"))(obj, path, nullptr);
+  EXPECT_EQ(ReadFile(path), ToString((*Func::GetGlobal("mlc.core.JSONSerialize"))(obj, nullptr)));
+  std::remove(path.c_str());
+}
+
+TEST(Sink, Callback) {
+  UList obj = MakeLargeObject();
+  std::string content;
+  Func callback([&content](void *data, int64_t size) { content.append(static_cast<const char *>(data), size); });
+  (*Func::GetGlobal("mlc.core.BinarySerializeTo"))(obj, callback, nullptr);
+  EXPECT_EQ(content, ToString((*Func::GetGlobal("mlc.core.BinarySerialize"))(obj, nullptr)));
+}
+
+TEST(Sink, ErrorsPropagate) {
+  FailingSink sink;
+  for (const char *name : {"mlc.core.JSONSerializeTo", "mlc.core.BinarySerializeTo"}) {
+    try {
+      (*Func::GetGlobal(name))(UList{1, 2}, static_cast<void *>(&sink), nullptr);
+      FAIL() << "No exception thrown";
+    } catch (Exception &e) {
+      EXPECT_NE(std::string(e.what()).find("Disk full"), std::string::npos) << e.what();
+    }
+  }
+  EXPECT_THROW((*Func::GetGlobal("mlc.core.JSONSerializeTo"))(UList{1}, 2.5, nullptr), Exception);
+}
+
+} // namespace
@@ -1,6 +1,7 @@
 #include "./common.h"
 #include <gtest/gtest.h>
 #include <mlc/core/all.h>
+#include <set>
 
 namespace {
 using namespace mlc;
@@ -163,4 +164,67 @@ TEST(Str, StreamOperator) {
   EXPECT_EQ(oss.str(), "Hello, World!");
 }
 
+TEST(StrHash, StableValues) {
+  // Hash values must not depend on the platform, e.g. when persisted as structural hashes
+  EXPECT_EQ(::mlc::base::StrHash(""), 0x0409638ee2bde459ULL);
+  EXPECT_EQ(::mlc::base::StrHash("a"), 0x28d2053309d28531ULL);
+  EXPECT_EQ(::mlc::base::StrHash("abc"), 0x02a4f1d7cb516c72ULL);
+  EXPECT_EQ(::mlc::base::StrHash("hello world"), 0x668d5e431c3b2573ULL);
+  EXPECT_EQ(::mlc::base::StrHash("The quick brown fox jumps over the lazy dog, again and again and again."),
+            0x67a8e9d37da55ed2ULL);
+  ::mlc::base::Hash128Value h = ::mlc::base::Hash128("abc", 3);
+  EXPECT_EQ(h.low, 0x3a2f1e4046b0a802ULL);
+  EXPECT_EQ(h.high, 0x2f1e5f4eba8eea1fULL);
+}
+
+TEST(StrHash, AllLengths) {
+  std::set<uint64_t> hashes;
+  std::string str;
+  for (int i = 0; i <= 300; ++i) {
+    EXPECT_EQ(Str(str)->Hash(), ::mlc::base::StrHash(str.data(), static_cast<int64_t>(str.size())));
+    hashes.insert(::mlc::base::StrHash(str.data(), static_cast<int64_t>(str.size())));
+    str.push_back(static_cast<char>('a' + i % 26));
+  }
+  EXPECT_EQ(hashes.size(), 301);
+}
+
+TEST(Str, Intern) {
+  Str a = Str::Intern("interned_name");
+  Str b = Str::Intern(std::string("interned_name_and_more").substr(0, 13));
+  Str c("interned_name");
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_NE(a.get(), c.get());
+  EXPECT_TRUE(a->IsInterned());
+  EXPECT_FALSE(c->IsInterned());
+  EXPECT_EQ(a->Hash(), c->Hash());
+  EXPECT_EQ(a, c);
+  EXPECT_NE(a, Str::Intern("interned_other"));
+  EXPECT_LT(a->_mlc_header.ref_cnt, 0);
+}
+
+TEST(Str, InternIsImmutable) {
+  Str a = Str::Intern("interned_immutable");
+  try {
+    a->pop_back();
+    FAIL() << "No exception thrown";
+  } catch (Exception &ex) {
+    EXPECT_STREQ(ex.what(), "Cannot modify an interned string: interned_immutable");
+  }
+  EXPECT_ANY_THROW(a->back() = 'x');
+  EXPECT_STREQ(a->c_str(), "interned_immutable");
+  EXPECT_EQ(a.get(), Str::Intern("interned_immutable").get());
+  Str b("plain_string");
+  b->pop_back();
+  EXPECT_STREQ(b->c_str(), "plain_strin");
+  EXPECT_FALSE(b->IsInterned());
+}
+
+TEST(Str, InternAsDictKey) {
+  UDict dict{{Str::Intern("key_a"), 1}, {Str("key_b"), 2}};
+  EXPECT_EQ(dict->at(Str("key_a")).operator int(), 1);
+  EXPECT_EQ(dict->at(Str::Intern("key_a")).operator int(), 1);
+  EXPECT_EQ(dict->at(Str::Intern("key_b")).operator int(), 2);
+  EXPECT_EQ(dict->count(Str::Intern("key_c")), 0);
+}
+
 } // namespace
@@ -0,0 +1,149 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+using namespace mlc;
+using mlc::base::DType;
+
+bool Equal(AnyView lhs, AnyView rhs, bool bind_free_vars = true) {
+  return (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, bind_free_vars, false).operator bool();
+}
+
+std::string FailReason(AnyView lhs, AnyView rhs, bool bind_free_vars = true) {
+  Optional<Str> reason = (*Func::GetGlobal("mlc.core.StructuralEqualFailReason"))(lhs, rhs, bind_free_vars);
+  return reason.has_value() ? std::string(reason.value()->data()) : "";
+}
+
+std::string AssertFailure(AnyView lhs, AnyView rhs, bool bind_free_vars = true) {
+  try {
+    (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, bind_free_vars, true);
+  } catch (Exception &e) {
+    return e.what();
+  }
+  return "";
+}
+
+TEST(StructuralEqual, MismatchesReturnFalse) {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  EXPECT_FALSE(Equal(UList{1, 2, 3}, UList{1, 2}));
+  EXPECT_FALSE(Equal(UList{1, 2, 3}, UList{1, 2, 4}));
+  EXPECT_FALSE(Equal(UDict{{"a", 1}}, UDict{{"b", 1}}));
+  EXPECT_FALSE(Equal(UDict{{"a", 1}}, UDict{{"a", 1}, {"b", 2}}));
+  EXPECT_FALSE(Equal(UList{x + 1}, UList{x + 2}));
+  // Inconsistent binding: `x` is bound to `x`, and then `y` to `x`
+  EXPECT_FALSE(Equal(UList{x, y}, UList{x, x}));
+  // Unbound variables
+  EXPECT_FALSE(Equal(x + 1, y + 1, false));
+  EXPECT_TRUE(Equal(x + 1, y + 1, true));
+}
+
+TEST(StructuralEqual, ReportsOnlyOnRequest) {
+  UList lhs{1, UList{2, "a"}};
+  UList rhs{1, UList{2, "b"}};
+  std::string reason = FailReason(lhs, rhs);
+  EXPECT_NE(reason.find("{root}[1][1]"), std::string::npos) << reason;
+  EXPECT_NE(reason.find("a vs b"), std::string::npos) << reason;
+  EXPECT_NE(AssertFailure(lhs, rhs).find(reason), std::string::npos);
+  EXPECT_EQ(FailReason(lhs, lhs), "");
+  EXPECT_EQ(AssertFailure(lhs, lhs), "");
+  std::string length = FailReason(UList{1, 2, 3}, UList{1, 2});
+  EXPECT_NE(length.find("List length mismatch: 3 vs 2"), std::string::npos) << length;
+}
+
+TEST(StructuralEqual, NestedPaths) {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64));
+  UList lhs{UDict{{"k", UList{0, x + 1}}}};
+  UList rhs{UDict{{"k", UList{0, x + 2}}}};
+  std::string reason = FailReason(lhs, rhs);
+  EXPECT_NE(reason.find("{root}[0][\"k\"][1].b"), std::string::npos) << reason;
+  EXPECT_NE(reason.find("1 vs 2"), std::string::npos) << reason;
+}
+
+TEST(StructuralEqual, NoPathsAllocatedOnSuccess) {
+  auto num_paths = []() -> int64_t {
+    UDict stats = (*Func::GetGlobal("mlc.core.AllocStats"))().operator UDict();
+    if (stats->count("mlc.core.ObjectPath") == 0) {
+      return 0;
+    }
+    return stats->at("mlc.core.ObjectPath").operator UDict()->at("num_allocs").operator int64_t();
+  };
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  UList lhs{UDict{{"k", UList{x + 1, x * 2}}}, UList{1, 2.5, "s"}};
+  UList rhs{UDict{{"k", UList{y + 1, y * 2}}}, UList{1, 2.5, "s"}};
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(true);
+  int64_t before = num_paths();
+  EXPECT_EQ(AssertFailure(lhs, rhs), "");
+  EXPECT_EQ(FailReason(lhs, rhs), "");
+  EXPECT_EQ(num_paths(), before);
+  (*Func::GetGlobal("mlc.core.SetAllocStats"))(false);
+}
+
+// Each level refers to the previous one twice, so there are 2^depth paths to the bottom
+UList MakeDiamond(int64_t depth, AnyView leaf) {
+  UList level{leaf};
+  for (int64_t i = 0; i < depth; ++i) {
+    level = UList{level, i, level};
+  }
+  return level;
+}
+
+TEST(StructuralEqual, SharedDAG) {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  // Would take 2^64 comparisons without memoization
+  EXPECT_TRUE(Equal(MakeDiamond(64, x + 1), MakeDiamond(64, y + 1)));
+  EXPECT_FALSE(Equal(MakeDiamond(64, x + 1), MakeDiamond(64, y + 2)));
+  EXPECT_TRUE(Equal(MakeDiamond(64, 1), MakeDiamond(64, 1)));
+  std::string reason = FailReason(MakeDiamond(64, x + 1), MakeDiamond(64, y + 2));
+  EXPECT_NE(reason.find("1 vs 2"), std::string::npos) << reason;
+}
+
+TEST(StructuralEqual, IdenticalSubtrees) {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  UList closed = MakeDiamond(64, UList{1, "a"});
+  EXPECT_TRUE(Equal(closed, closed));
+  EXPECT_TRUE(Equal(UList{closed, x}, UList{closed, y}));
+  // Identical subtrees with variables are still compared, honoring `bind_free_vars`
+  Expr e = x + 1;
+  EXPECT_TRUE(Equal(e, e, true));
+  EXPECT_FALSE(Equal(e, e, false));
+  EXPECT_FALSE(Equal(UList{x, e}, UList{y, e}));
+  EXPECT_FALSE(Equal(UList{e, x}, UList{e, y}));
+  EXPECT_TRUE(Equal(UList{x, e}, UList{x, e}));
+  // Functions cannot be compared, even to themselves
+  Func f([](int x) { return x; });
+  EXPECT_FALSE(Equal(UList{f}, UList{f}));
+  // Neither can NaN
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  UList with_nan = MakeDiamond(8, UList{1, nan});
+  EXPECT_FALSE(Equal(with_nan, with_nan));
+  UDict dict{{"a", nan}};
+  EXPECT_FALSE(Equal(dict, dict));
+  TypedList<double> typed{0.5, nan};
+  EXPECT_FALSE(Equal(typed, typed));
+  FloatImm imm(nan, 64);
+  EXPECT_FALSE(Equal(imm, imm));
+}
+
+TEST(StructuralEqual, HashMapKeys) {
+  std::unordered_map<UList, int, StructuralHash, StructuralEqual<false>> map;
+  for (int i = 0; i < 100; ++i) {
+    map[UList{i, UList{"key", i % 7}}] = i;
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.at(UList{i, UList{"key", i % 7}}), i);
+  }
+  EXPECT_EQ(map.count(UList{100, UList{"key", 2}}), 0);
+}
+
+} // namespace
@@ -0,0 +1,134 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+
+namespace {
+
+using namespace mlc;
+
+int64_t Hash(AnyView obj) { return (*Func::GetGlobal("mlc.core.StructuralHash"))(obj).operator int64_t(); }
+
+void SetFrozen(UList list, bool frozen) { reinterpret_cast<MLCList *>(list.get())->frozen = frozen; }
+
+UList Frozen(UList list) {
+  SetFrozen(list, true);
+  return list;
+}
+
+TEST(StructuralHashCache, SameAsUncached) {
+  UList leaf = Frozen(UList{1, 2.0, "three"});
+  UList root = Frozen(UList{leaf, leaf, Frozen(UList{leaf, nullptr})});
+  StructuralHashCache cache(false);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  EXPECT_EQ(cache->Hash(leaf), Hash(leaf));
+}
+
+TEST(StructuralHashCache, HitsAndMisses) {
+  UList leaf = Frozen(UList{1, 2, 3});
+  UList a = Frozen(UList{leaf, 4});
+  UList b = Frozen(UList{leaf, 5});
+  StructuralHashCache cache(false);
+  cache->Hash(a);
+  EXPECT_EQ(cache->num_hits, 0);
+  EXPECT_EQ(cache->num_misses, 2);
+  EXPECT_EQ(cache->table.size(), 2);
+  // Only `b` itself is visited, `leaf` comes from the cache
+  EXPECT_EQ(cache->Hash(b), Hash(b));
+  EXPECT_EQ(cache->num_hits, 1);
+  EXPECT_EQ(cache->num_misses, 3);
+  EXPECT_EQ(cache->Hash(a), Hash(a));
+  EXPECT_EQ(cache->num_hits, 2);
+  EXPECT_EQ(cache->num_misses, 3);
+}
+
+TEST(StructuralHashCache, MutableNotCached) {
+  UList leaf = Frozen(UList{1, 2, 3});
+  UList root{leaf};
+  StructuralHashCache cache(false);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  EXPECT_EQ(cache->table.size(), 1);
+  EXPECT_EQ(cache->table.count(leaf), 1);
+  root.push_back(4);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  StructuralHashCache trusting(true);
+  EXPECT_EQ(trusting->Hash(root), Hash(root));
+  EXPECT_EQ(trusting->table.size(), 2);
+}
+
+TEST(StructuralHashCache, VarsNotCached) {
+  using namespace mlc::sym;
+  using mlc::base::DType;
+  Var x("x", DType::Int(64));
+  Expr a = x + 1;
+  Expr b = a * a;
+  UList root = Frozen(UList{b, Frozen(UList{1, 2})});
+  StructuralHashCache cache(true);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  // Only the literal `1` and the inner list are context-free
+  EXPECT_EQ(cache->table.count(x), 0);
+  EXPECT_EQ(cache->table.count(a), 0);
+  EXPECT_EQ(cache->table.count(b), 0);
+  EXPECT_EQ(cache->table.count(root), 0);
+  EXPECT_EQ(cache->table.size(), 2);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  EXPECT_EQ(cache->Hash(a), Hash(a));
+}
+
+TEST(StructuralHashCache, ObjectKeyedDictNotCached) {
+  UList key = Frozen(UList{1});
+  UDict dict{{key, 1}, {"name", 2}};
+  dict.freeze();
+  UList root = Frozen(UList{dict});
+  StructuralHashCache cache(false);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  EXPECT_EQ(cache->table.count(dict), 0);
+  EXPECT_EQ(cache->table.count(root), 0);
+}
+
+TEST(StructuralHashCache, KeyInsideCachedSubtree) {
+  UList key = Frozen(UList{1});
+  UList sub = Frozen(UList{key});
+  UDict dict{{key, 1}};
+  UList root{sub, dict};
+  StructuralHashCache cache(false);
+  int64_t cold = cache->Hash(root);
+  ASSERT_EQ(cache->table.count(sub), 1);
+  // `sub` comes from the cache, so `key` is not bound when the dict is visited
+  int64_t warm = cache->Hash(root);
+  EXPECT_EQ(cold, Hash(root));
+  EXPECT_EQ(warm, cold);
+  EXPECT_EQ(cache->Hash(UList{dict, sub}), Hash(UList{dict, sub}));
+}
+
+TEST(StructuralHashCache, InvalidateAndClear) {
+  UList leaf = Frozen(UList{1, 2, 3});
+  UList root = Frozen(UList{leaf});
+  StructuralHashCache cache(false);
+  int64_t before = cache->Hash(root);
+  ASSERT_EQ(cache->table.size(), 2);
+  SetFrozen(leaf, false);
+  leaf.push_back(4);
+  // Stale until both the mutated object and its ancestors are invalidated
+  EXPECT_EQ(cache->Hash(root), before);
+  cache->Invalidate(leaf);
+  cache->Invalidate(root);
+  EXPECT_EQ(cache->table.size(), 0);
+  EXPECT_EQ(cache->Hash(root), Hash(root));
+  EXPECT_NE(cache->Hash(root), before);
+  cache->Clear();
+  EXPECT_EQ(cache->table.size(), 0);
+  EXPECT_EQ(cache->num_hits, 0);
+  EXPECT_EQ(cache->num_misses, 0);
+}
+
+TEST(StructuralHashCache, AsHasher) {
+  StructuralHashCached hasher{StructuralHashCache(false)};
+  UList a = Frozen(UList{1, Frozen(UList{2})});
+  UList b = Frozen(UList{1, Frozen(UList{2})});
+  EXPECT_EQ(hasher(a), hasher(b));
+  EXPECT_EQ(static_cast<int64_t>(hasher(a)), Hash(a));
+}
+
+} // namespace
@@ -0,0 +1,96 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+
+namespace {
+
+using namespace mlc;
+using mlc::base::DType;
+
+bool Equal(AnyView lhs, AnyView rhs) {
+  return (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, true, false).operator bool();
+}
+
+bool Same(AnyView lhs, AnyView rhs) { return lhs.operator ObjectRef().same_as(rhs.operator ObjectRef()); }
+
+TEST(StructuralIntern, Lists) {
+  StructuralInternTable table;
+  UList a{1, "x", 2.5};
+  UList b{1, "x", 2.5};
+  UList c{1, "y", 2.5};
+  EXPECT_TRUE(Same(table->Intern(a), a));
+  EXPECT_TRUE(Same(table->Intern(b), a));
+  EXPECT_TRUE(Same(table->Intern(c), c));
+  EXPECT_TRUE(Same(table->Intern(a), a));
+  EXPECT_EQ(table->num_lookups, 4);
+  EXPECT_EQ(table->num_merged, 1);
+  EXPECT_GT(table->bytes_saved, 0);
+  EXPECT_EQ(table->Size(), 2);
+  EXPECT_EQ(table->Intern(1).operator int(), 1);
+  table->Clear();
+  EXPECT_EQ(table->Size(), 0);
+  EXPECT_EQ(table->num_lookups, 0);
+  EXPECT_TRUE(Same(table->Intern(b), b));
+}
+
+TEST(StructuralIntern, DictsAndTypedLists) {
+  StructuralInternTable table;
+  UDict d1{{"a", 1}, {"b", 2}};
+  UDict d2{{"b", 2}, {"a", 1}};
+  UDict d3{{"a", 1}, {"b", 3}};
+  EXPECT_TRUE(Same(table->Intern(d1), d1));
+  EXPECT_TRUE(Same(table->Intern(d2), d1));
+  EXPECT_TRUE(Same(table->Intern(d3), d3));
+  TypedList<int64_t> t1{1, 2, 3};
+  TypedList<int64_t> t2{1, 2, 3};
+  TypedList<double> t3{1.0, 2.0, 3.0};
+  EXPECT_TRUE(Same(table->Intern(t1), t1));
+  EXPECT_TRUE(Same(table->Intern(t2), t1));
+  EXPECT_TRUE(Same(table->Intern(t3), t3));
+}
+
+TEST(StructuralIntern, GraphSharesSubtrees) {
+  using namespace mlc::sym;
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  UList module{(x + 1) * y, (x + 1) * y, x + 1, UList{Str("name"), 2}, UList{Str("name"), 2}};
+  UList expected = (*Func::GetGlobal("mlc.core.CopyDeep"))(module);
+  StructuralInternTable table;
+  EXPECT_TRUE(Same(table->InternGraph(module), module));
+  EXPECT_TRUE(Same(module[0], module[1]));
+  EXPECT_TRUE(Same(module[3], module[4]));
+  EXPECT_TRUE(module[0].operator Mul()->a.same_as(module[2].operator ObjectRef()));
+  EXPECT_TRUE(Equal(module, expected));
+  // Interning a structurally equal graph returns the existing representatives
+  UList other{UList{Str("name"), 2}, (x + 1) * y};
+  EXPECT_TRUE(Same(table->InternGraph(other[1]), module[0]));
+  EXPECT_TRUE(Same(table->InternGraph(other), other));
+  EXPECT_TRUE(Same(other[0], module[3]));
+}
+
+TEST(StructuralIntern, VariablesNotMerged) {
+  using namespace mlc::sym;
+  Var x1("x", DType::Int(64)), x2("x", DType::Int(64));
+  UList exprs{x1 + 1, x2 + 1};
+  StructuralInternTable table;
+  table->InternGraph(exprs);
+  EXPECT_FALSE(Same(exprs[0], exprs[1]));
+  EXPECT_TRUE(Same(exprs[0].operator Add()->a, x1));
+  EXPECT_TRUE(Same(exprs[1].operator Add()->a, x2));
+  EXPECT_TRUE(exprs[0].operator Add()->b.same_as(exprs[1].operator Add()->b));
+}
+
+TEST(StructuralIntern, NonStructuralObjectsKept) {
+  StructuralInternTable table;
+  Func f1([](int x) { return x; });
+  Func f2([](int x) { return x; });
+  EXPECT_TRUE(Same(table->Intern(f1), f1));
+  EXPECT_TRUE(Same(table->Intern(f2), f2));
+  EXPECT_EQ(table->num_lookups, 0);
+  UList funcs{UList{f1}, UList{f1}, UList{f2}};
+  table->InternGraph(funcs);
+  EXPECT_TRUE(Same(funcs[0], funcs[1]));
+  EXPECT_FALSE(Same(funcs[0], funcs[2]));
+}
+
+} // namespace
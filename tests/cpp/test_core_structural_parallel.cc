@@ -0,0 +1,112 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+#include <mlc/sym/all.h>
+#include <string>
+
+namespace {
+
+using namespace mlc;
+
+int64_t Hash(AnyView obj) { return (*Func::GetGlobal("mlc.core.StructuralHash"))(obj).operator int64_t(); }
+
+int64_t HashParallel(AnyView obj, int64_t num_threads) {
+  return (*Func::GetGlobal("mlc.core.StructuralHashParallel"))(obj, num_threads).operator int64_t();
+}
+
+bool Equal(AnyView lhs, AnyView rhs) {
+  return (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, true, false).operator bool();
+}
+
+bool EqualParallel(AnyView lhs, AnyView rhs, int64_t num_threads) {
+  return (*Func::GetGlobal("mlc.core.StructuralEqualParallel"))(lhs, rhs, true, false, num_threads).operator bool();
+}
+
+std::string EqualFailure(AnyView lhs, AnyView rhs, int64_t num_threads) {
+  try {
+    if (num_threads == 1) {
+      (*Func::GetGlobal("mlc.core.StructuralEqual"))(lhs, rhs, true, true);
+    } else {
+      (*Func::GetGlobal("mlc.core.StructuralEqualParallel"))(lhs, rhs, true, true, num_threads);
+    }
+  } catch (Exception &e) {
+    return e.what();
+  }
+  return "";
+}
+
+// A list of "functions", each mixing closed subtrees with expressions over variables shared across functions
+UList MakeModule(int64_t num_funcs, int64_t changed_func = -1) {
+  using namespace mlc::sym;
+  using mlc::base::DType;
+  Var x("x", DType::Int(64));
+  Var y("y", DType::Int(64));
+  UList funcs;
+  for (int64_t i = 0; i < num_funcs; ++i) {
+    Var local("v" + std::to_string(i), DType::Int(64));
+    int64_t value = i == changed_func ? -1 : i;
+    UList attrs{Str("f" + std::to_string(i)), UList{1, 2.5, "attr"}, value};
+    UList body{(x + static_cast<int>(value)) * y, local + x, local * local};
+    funcs.push_back(UList{attrs, body, UList{UList{i, i + 1}, UList{i + 2}}});
+  }
+  return funcs;
+}
+
+TEST(StructuralParallel, HashMatchesSerial) {
+  UList module = MakeModule(300);
+  int64_t expected = Hash(module);
+  for (int64_t num_threads : {1, 2, 4, 0}) {
+    EXPECT_EQ(HashParallel(module, num_threads), expected) << "num_threads = " << num_threads;
+  }
+  UList closed;
+  for (int64_t i = 0; i < 300; ++i) {
+    closed.push_back(UList{i, UList{Str("s" + std::to_string(i)), 1.5}, UList{UList{i}}});
+  }
+  EXPECT_EQ(HashParallel(closed, 4), Hash(closed));
+}
+
+TEST(StructuralParallel, HashWithObjectKeyedDict) {
+  UList module = MakeModule(100);
+  UList key{1, 2};
+  module.push_back(UDict{{key, 1}, {"name", 2}});
+  module.push_back(key);
+  EXPECT_EQ(HashParallel(module, 4), Hash(module));
+}
+
+TEST(StructuralParallel, Equal) {
+  UList lhs = MakeModule(300);
+  UList rhs = MakeModule(300);
+  EXPECT_TRUE(Equal(lhs, rhs));
+  EXPECT_TRUE(EqualParallel(lhs, rhs, 4));
+  EXPECT_TRUE(EqualParallel(lhs, lhs, 0));
+}
+
+TEST(StructuralParallel, NotEqual) {
+  UList lhs = MakeModule(300);
+  for (int64_t changed_func : {0, 150, 299}) {
+    UList rhs = MakeModule(300, changed_func);
+    EXPECT_FALSE(Equal(lhs, rhs));
+    EXPECT_FALSE(EqualParallel(lhs, rhs, 4));
+    EXPECT_EQ(EqualFailure(lhs, rhs, 4), EqualFailure(lhs, rhs, 1));
+  }
+  UList shorter = MakeModule(299);
+  EXPECT_FALSE(EqualParallel(lhs, shorter, 4));
+  EXPECT_EQ(EqualFailure(lhs, shorter, 4), EqualFailure(lhs, shorter, 1));
+}
+
+TEST(StructuralParallel, BindingsAcrossSubtrees) {
+  using namespace mlc::sym;
+  using mlc::base::DType;
+  // Each half is equal on its own, but `x` maps to `a` in the first half and to `b` in the second
+  Var x("x", DType::Int(64)), y("y", DType::Int(64));
+  Var a("a", DType::Int(64)), b("b", DType::Int(64));
+  UList lhs, rhs;
+  for (int i = 0; i < 100; ++i) {
+    lhs.push_back(UList{x + i, y + i});
+    rhs.push_back(UList{(i < 50 ? a : b) + i, (i < 50 ? b : a) + i});
+  }
+  EXPECT_FALSE(Equal(lhs, rhs));
+  EXPECT_FALSE(EqualParallel(lhs, rhs, 4));
+}
+
+} // namespace
@@ -0,0 +1,141 @@
+#include "./common.h"
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+
+namespace {
+
+using namespace mlc;
+
+Any CallGlobal(const char *name, AnyView arg) { return (*Func::GetGlobal(name))(arg); }
+
+TEST(TypedList, DefaultConstructor) {
+  TypedList<int64_t> list;
+  EXPECT_EQ(list.size(), 0);
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.elem_type_index(), static_cast<int32_t>(MLCTypeIndex::kMLCInt));
+}
+
+TEST(TypedList, StoresRawValues) {
+  TypedList<int64_t> list{1, 2, 3};
+  list.push_back(4);
+  ASSERT_EQ(list.size(), 4);
+  const int64_t *data = list.data();
+  for (int64_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(data[i], i + 1);
+  }
+  int64_t sum = 0;
+  for (int64_t v : list) {
+    sum += v;
+  }
+  EXPECT_EQ(sum, 10);
+  list.Set(0, 10);
+  EXPECT_EQ(list[0], 10);
+  EXPECT_EQ(list->at(0).operator int64_t(), 10);
+  EXPECT_THROW(list[4], Exception);
+  EXPECT_THROW(list.Set(-1, 0), Exception);
+}
+
+TEST(TypedList, InsertAndErase) {
+  TypedList<double> list{1.5, 3.5};
+  std::vector<double> middle{2.0, 2.5};
+  list.insert(1, middle.begin(), middle.end());
+  ASSERT_EQ(list.size(), 4);
+  EXPECT_EQ(list[0], 1.5);
+  EXPECT_EQ(list[1], 2.0);
+  EXPECT_EQ(list[2], 2.5);
+  EXPECT_EQ(list[3], 3.5);
+  list.erase(1);
+  list.pop_back();
+  ASSERT_EQ(list.size(), 2);
+  EXPECT_EQ(list[0], 1.5);
+  EXPECT_EQ(list[1], 2.5);
+  list.clear();
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(TypedList, BoxedAccess) {
+  UTypedList list(static_cast<int32_t>(MLCTypeIndex::kMLCBool));
+  list.push_back(true);
+  list.insert(0, AnyView(false));
+  ASSERT_EQ(list.size(), 2);
+  EXPECT_EQ(list[0].type_index, static_cast<int32_t>(MLCTypeIndex::kMLCBool));
+  EXPECT_FALSE(list[0].operator bool());
+  EXPECT_TRUE(list[1].operator bool());
+  EXPECT_EQ(list->__str__(), "[False, True]");
+}
+
+TEST(TypedList, RejectsMismatchedElements) {
+  TypedList<int64_t> list{1, 2};
+  try {
+    list->push_back(AnyView("three"));
+    FAIL() << "No exception thrown";
+  } catch (Exception &ex) {
+    EXPECT_STREQ(ex.what(), "Cannot convert from type `char *` to `int`");
+  }
+  EXPECT_EQ(list.size(), 2);
+  EXPECT_THROW(list->at(2), Exception);
+  EXPECT_THROW(UTypedList(static_cast<int32_t>(MLCTypeIndex::kMLCStr)), Exception);
+  EXPECT_THROW(TypedList<double>(UTypedList(list)), Exception);
+}
+
+TEST(TypedList, DataTypeElements) {
+  TypedList<DLDataType> list{DLDataType{kDLFloat, 32, 1}, DLDataType{kDLInt, 8, 4}};
+  ASSERT_EQ(list.size(), 2);
+  EXPECT_EQ(list[1].code, kDLInt);
+  EXPECT_EQ(list[1].bits, 8);
+  EXPECT_EQ(list[1].lanes, 4);
+  EXPECT_EQ(list->__str__(), "[float32, int8x4]");
+  EXPECT_THROW(list->DLPack(), Exception);
+}
+
+TEST(TypedList, ToList) {
+  TypedList<int64_t> list{5, 6};
+  UList boxed = list.ToList();
+  ASSERT_EQ(boxed.size(), 2);
+  EXPECT_EQ(boxed[0].operator int64_t(), 5);
+  EXPECT_EQ(boxed[1].operator int64_t(), 6);
+}
+
+TEST(TypedList, DLPackIsZeroCopy) {
+  TypedList<double> list{1.0, 2.0, 3.0};
+  DLManagedTensor *tensor = list->DLPack();
+  EXPECT_EQ(tensor->dl_tensor.data, static_cast<void *>(list.data()));
+  EXPECT_EQ(tensor->dl_tensor.ndim, 1);
+  EXPECT_EQ(tensor->dl_tensor.shape[0], 3);
+  EXPECT_EQ(tensor->dl_tensor.dtype.code, kDLFloat);
+  EXPECT_EQ(tensor->dl_tensor.dtype.bits, 64);
+  EXPECT_EQ(tensor->dl_tensor.device.device_type, kDLCPU);
+  EXPECT_EQ(list->_mlc_header.ref_cnt, 2);
+  tensor->deleter(tensor);
+  EXPECT_EQ(list->_mlc_header.ref_cnt, 1);
+}
+
+TEST(TypedList, Structural) {
+  TypedList<int64_t> a{1, 2, 3};
+  TypedList<int64_t> b{1, 2, 3};
+  TypedList<int64_t> c{1, 2, 4};
+  FuncObj *eq = Func::GetGlobal("mlc.core.StructuralEqual");
+  EXPECT_TRUE((*eq)(a, b, true, false).operator bool());
+  EXPECT_FALSE((*eq)(a, c, true, false).operator bool());
+  EXPECT_EQ(CallGlobal("mlc.core.StructuralHash", a).operator int64_t(),
+            CallGlobal("mlc.core.StructuralHash", b).operator int64_t());
+  EXPECT_NE(CallGlobal("mlc.core.StructuralHash", a).operator int64_t(),
+            CallGlobal("mlc.core.StructuralHash", c).operator int64_t());
+}
+
+TEST(TypedList, CopyAndSerialize) {
+  TypedList<double> list{0.5, -1.25};
+  TypedList<double> copied(CallGlobal("mlc.core.CopyDeep", list).operator UTypedList());
+  EXPECT_FALSE(copied.same_as(list));
+  ASSERT_EQ(copied.size(), 2);
+  EXPECT_EQ(copied[1], -1.25);
+  TypedList<double> empty;
+  EXPECT_EQ(CallGlobal("mlc.core.CopyShallow", empty).operator UTypedList().size(), 0);
+  Str json = (*Func::GetGlobal("mlc.core.JSONSerialize"))(list, nullptr);
+  TypedList<double> loaded((*Func::GetGlobal("mlc.core.JSONDeserialize"))(json, nullptr).operator UTypedList());
+  ASSERT_EQ(loaded.size(), 2);
+  EXPECT_EQ(loaded[0], 0.5);
+  EXPECT_EQ(loaded[1], -1.25);
+}
+
+} // namespace
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <mlc/core/all.h>
+#include <unordered_map>
 
 namespace {
 
@@ -282,4 +283,240 @@ TEST(UDict, ReverseIteratorModification) {
   EXPECT_EQ(dict["key3"].operator int(), 6);
 }
 
+TEST(UDict, IterationFollowsInsertionOrder) {
+  UDict dict;
+  for (int64_t i = 0; i < 100; ++i) {
+    dict[99 - i] = i;
+  }
+  for (int64_t i = 0; i < 100; i += 3) {
+    dict->erase(99 - i);
+  }
+  dict[1000] = -1;
+  dict[99] = -2;
+  std::vector<int64_t> keys;
+  for (const auto &kv : *dict.get()) {
+    keys.push_back(kv.first.operator int64_t());
+  }
+  std::vector<int64_t> expected;
+  for (int64_t i = 0; i < 100; ++i) {
+    if (i % 3 != 0) {
+      expected.push_back(99 - i);
+    }
+  }
+  expected.push_back(1000);
+  expected.push_back(99);
+  EXPECT_EQ(keys, expected);
+  std::vector<int64_t> reversed_keys;
+  for (auto it = dict->rbegin(); it != dict->rend(); ++it) {
+    reversed_keys.push_back(it->first.operator int64_t());
+  }
+  std::reverse(expected.begin(), expected.end());
+  EXPECT_EQ(reversed_keys, expected);
+}
+
+TEST(UDict, FreezeBuildsPerfectHash) {
+  UDict dict;
+  for (int64_t i = 0; i < 5000; ++i) {
+    dict[i * 7] = i;
+  }
+  for (int64_t i = 0; i < 5000; i += 3) {
+    dict->erase(i * 7);
+  }
+  dict["name"] = -1;
+  std::vector<int64_t> values;
+  for (const auto &kv : *dict.get()) {
+    values.push_back(kv.second.operator int64_t());
+  }
+  dict->freeze();
+  const MLCDict *raw = reinterpret_cast<const MLCDict *>(dict.get());
+  EXPECT_EQ(raw->perfect_hash, 1);
+  EXPECT_EQ(raw->capacity, dict->size());
+  std::vector<int64_t> frozen_values;
+  for (const auto &kv : *dict.get()) {
+    frozen_values.push_back(kv.second.operator int64_t());
+  }
+  EXPECT_EQ(frozen_values, values);
+  for (int64_t i = 0; i < 5000; ++i) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(dict->count(i * 7), 0);
+    } else {
+      EXPECT_EQ(dict->at(i * 7).operator int64_t(), i);
+    }
+  }
+  EXPECT_EQ(dict->at("name").operator int64_t(), -1);
+  EXPECT_EQ(dict->count("other"), 0);
+  EXPECT_THROW(dict->at(-7), Exception);
+}
+
+TEST(UDict, FreezeSurvivesClearedFlag) {
+  UDict dict;
+  for (int64_t i = 0; i < 100; ++i) {
+    dict[i] = i * i;
+  }
+  dict->freeze();
+  // Python's type conversion writes `frozen` directly
+  MLCDict *raw = reinterpret_cast<MLCDict *>(dict.get());
+  raw->frozen = 0;
+  EXPECT_EQ(raw->perfect_hash, 1);
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(dict->at(i).operator int64_t(), i * i);
+  }
+  EXPECT_EQ(dict->count(100), 0);
+  dict[100] = -1;
+  EXPECT_EQ(raw->perfect_hash, 0);
+  EXPECT_EQ(dict->at(100).operator int64_t(), -1);
+  EXPECT_EQ(dict->at(99).operator int64_t(), 99 * 99);
+  dict->freeze();
+  EXPECT_EQ(raw->frozen, 1);
+  EXPECT_EQ(raw->perfect_hash, 1);
+}
+
+TEST(UDict, FreezeWithEqualHashesKeepsHashedLayout) {
+  // `0` and `None` have the same hash, so no perfect hash separates them
+  UDict dict{{0, 1}, {Any(), 2}};
+  dict->freeze();
+  const MLCDict *raw = reinterpret_cast<const MLCDict *>(dict.get());
+  EXPECT_EQ(raw->perfect_hash, 0);
+  EXPECT_EQ(dict->at(0).operator int(), 1);
+  EXPECT_EQ(dict->at(Any()).operator int(), 2);
+}
+
+TEST(UDict, ModifyAfterFreeze) {
+  // More entries than the small layout holds, which does not build a perfect hash
+  UDict dict{{"a", 1}, {"b", 2}, {"c", 3}, {"f", 6}, {"g", 7}, {"h", 8}, {"i", 9}, {"j", 10}, {"k", 11}};
+  dict->freeze();
+  dict["b"] = 20;
+  const MLCDict *raw = reinterpret_cast<const MLCDict *>(dict.get());
+  EXPECT_EQ(raw->perfect_hash, 1);
+  dict["d"] = 4;
+  dict->erase("a");
+  EXPECT_EQ(raw->perfect_hash, 0);
+  std::vector<std::string> keys;
+  for (const auto &kv : *dict.get()) {
+    keys.push_back(kv.first.operator std::string());
+  }
+  EXPECT_EQ(keys, (std::vector<std::string>{"b", "c", "f", "g", "h", "i", "j", "k", "d"}));
+  EXPECT_EQ(dict->at("b").operator int(), 20);
+  dict->freeze();
+  dict->clear();
+  EXPECT_EQ(dict->size(), 0);
+  EXPECT_EQ(dict->count("b"), 0);
+  dict["e"] = 5;
+  EXPECT_EQ(dict->at("e").operator int(), 5);
+}
+
+TEST(UDict, SmallLayoutIsInline) {
+  UDict dict{{"a", 1}, {"b", 2}, {3, "c"}};
+  const MLCDict *raw = reinterpret_cast<const MLCDict *>(dict.get());
+  EXPECT_EQ(raw->capacity, core::DictBase::kSmallCapacity);
+  EXPECT_EQ(raw->data, static_cast<const void *>(raw + 1));
+  EXPECT_EQ(dict->at("b").operator int64_t(), 2);
+  EXPECT_EQ(dict->at(3).operator std::string(), "c");
+  EXPECT_EQ(dict->count("d"), 0);
+  dict->erase("a");
+  dict["d"] = 4;
+  std::vector<std::string> keys;
+  for (const auto &kv : *dict.get()) {
+    keys.push_back(kv.first.GetTypeIndex() == static_cast<int32_t>(MLCTypeIndex::kMLCInt)
+                       ? std::to_string(kv.first.operator int64_t())
+                       : kv.first.operator std::string());
+  }
+  EXPECT_EQ(keys, (std::vector<std::string>{"b", "3", "d"}));
+  dict->freeze();
+  EXPECT_EQ(raw->perfect_hash, 0);
+  EXPECT_EQ(raw->data, static_cast<const void *>(raw + 1));
+  EXPECT_EQ(dict->at("d").operator int64_t(), 4);
+}
+
+TEST(UDict, SmallLayoutGrowsIntoHashed) {
+  UDict dict;
+  const MLCDict *raw = reinterpret_cast<const MLCDict *>(dict.get());
+  for (int64_t i = 0; i < core::DictBase::kSmallCapacity; ++i) {
+    dict[i] = i * 10;
+  }
+  EXPECT_EQ(raw->data, static_cast<const void *>(raw + 1));
+  for (int64_t i = core::DictBase::kSmallCapacity; i < 100; ++i) {
+    dict[i] = i * 10;
+  }
+  EXPECT_GE(raw->capacity, core::DictBase::kBlockCapacity);
+  EXPECT_NE(raw->data, static_cast<const void *>(raw + 1));
+  int64_t expected = 0;
+  for (const auto &kv : *dict.get()) {
+    EXPECT_EQ(kv.first.operator int64_t(), expected);
+    EXPECT_EQ(kv.second.operator int64_t(), expected * 10);
+    ++expected;
+  }
+  EXPECT_EQ(expected, 100);
+  Dict<Str, int64_t> typed{{"x", 1}, {"y", 2}};
+  typed->Set("z", 3);
+  EXPECT_EQ(typed->at("z"), 3);
+  EXPECT_EQ(reinterpret_cast<const MLCDict *>(typed.get())->capacity, core::DictBase::kSmallCapacity);
+}
+
+TEST(UDict, EraseAndReinsertMatchesStdMap) {
+  UDict dict;
+  std::unordered_map<int64_t, int64_t> expected;
+  uint64_t state = 1;
+  for (int64_t i = 0; i < 20000; ++i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    int64_t key = static_cast<int64_t>((state >> 33) % 1000);
+    if ((state >> 32) % 3 == 0) {
+      if (expected.erase(key)) {
+        dict->erase(key);
+      }
+    } else {
+      dict[key] = i;
+      expected[key] = i;
+    }
+    ASSERT_EQ(dict->size(), static_cast<int64_t>(expected.size()));
+  }
+  for (const auto &kv : expected) {
+    EXPECT_EQ(dict->at(kv.first).operator int64_t(), kv.second);
+  }
+  int64_t num_forward = 0, num_backward = 0;
+  for (auto it = dict->begin(); it != dict->end(); ++it) {
+    ++num_forward;
+  }
+  for (auto it = dict->rbegin(); it != dict->rend(); ++it) {
+    ++num_backward;
+  }
+  EXPECT_EQ(num_forward, dict->size());
+  EXPECT_EQ(num_backward, dict->size());
+}
+
+TEST(UDict, DeletedSlotsAreReused) {
+  auto key_at = [](int64_t i) { return static_cast<int64_t>(i * 0x2545F4914F6CDD1Dull & 0xFFFFFFFFFFFFull); };
+  UDict dict;
+  for (int64_t i = 0; i < 1792; ++i) {
+    dict[key_at(i)] = i;
+  }
+  const MLCDict *raw = reinterpret_cast<const MLCDict *>(dict.get());
+  int64_t capacity = raw->capacity;
+  for (int64_t i = 0; i < 1792; i += 2) {
+    dict->erase(key_at(i));
+  }
+  EXPECT_GT(raw->num_deleted, 0);
+  for (int64_t i = 0; i < 100000; ++i) {
+    dict[key_at(i + 10000)] = i;
+    dict->erase(key_at(i + 10000));
+  }
+  EXPECT_EQ(raw->capacity, capacity);
+  EXPECT_EQ(dict->size(), 896);
+  for (int64_t i = 1; i < 1792; i += 2) {
+    EXPECT_EQ(dict->at(key_at(i)).operator int64_t(), i);
+  }
+  dict->clear();
+  EXPECT_EQ(raw->num_deleted, 0);
+  EXPECT_EQ(dict->count(key_at(1)), 0);
+}
+
+TEST(UDict, StructuralHash) {
+  FuncObj *hash = Func::GetGlobal("mlc.core.StructuralHash");
+  UDict a{{"a", 1}, {"b", UList{2, 3}}, {"c", "d"}};
+  UDict b{{"c", "d"}, {"b", UList{2, 3}}, {"a", 1}};
+  UDict c{{"a", 1}, {"b", UList{2, 4}}, {"c", "d"}};
+  EXPECT_EQ((*hash)(a).operator int64_t(), (*hash)(b).operator int64_t());
+  EXPECT_NE((*hash)(a).operator int64_t(), (*hash)(c).operator int64_t());
+}
+
 } // namespace
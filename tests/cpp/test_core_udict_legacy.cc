@@ -17,7 +17,7 @@ TEST(Legacy_UDict_Construtor, Default) {
   EXPECT_EQ(dict_ptr->_mlc_header.ref_cnt, 1);
   EXPECT_NE(dict_ptr->_mlc_header.v.deleter, nullptr);
   EXPECT_EQ(dict_ptr->size, 0);
-  EXPECT_EQ(dict_ptr->capacity, 0);
+  EXPECT_EQ(dict_ptr->capacity, core::DictBase::kSmallCapacity);
 }
 
 TEST(Legacy_UDict_Construtor, InitializerList) {
@@ -119,6 +119,21 @@ def test_dict_to_py_0() -> None:
     assert isinstance(a[4], int) and a[4] == 16
 
 
+def test_dict_to_py_depth() -> None:
+    inner = Dict({"b": 1})
+    a = Dict({"a": inner})
+    b = a.to_py(depth=1)
+    assert type(b) is dict and b["a"].is_(inner)
+    assert a.to_py() == {"a": {"b": 1}} == a.py()
+
+
+def test_dict_iter_bulk() -> None:
+    a = Dict({i: str(i) for i in range(1000)})
+    assert sorted(a.keys()) == list(range(1000))
+    assert sorted(a.values(), key=int) == [str(i) for i in range(1000)]
+    assert dict(a.items()) == {i: str(i) for i in range(1000)}
+
+
 def test_dict_to_py_1() -> None:
     a = Dict(
         {
@@ -156,3 +171,20 @@ def test_dict_freeze(callable: Callable[[Dict], None]) -> None:
     with pytest.raises(RuntimeError) as e:
         callable(a)
     assert str(e.value) == "Cannot modify a frozen dict"
+
+
+def test_dict_freeze_convert_through_field() -> None:
+    @mlc.dataclasses.py_class("mlc.testing.test_dict_freeze_convert_through_field")
+    class Holder:
+        table: dict[int, int]
+
+    a = Dict({i: i * i for i in range(100)})
+    a.freeze()
+    # The field is not frozen, so the conversion clears the flag, but the layout must stay readable
+    holder = Holder(table=a)
+    assert holder.table.frozen == False
+    assert all(holder.table[i] == i * i for i in range(100))
+    assert 100 not in holder.table
+    holder.table[100] = -1
+    assert holder.table[100] == -1
+    assert holder.table[99] == 99 * 99
@@ -3,7 +3,7 @@ from typing import Any
 
 import mlc
 import pytest
-from mlc import DataType, Device, List
+from mlc import DataType, Device, List, TypedList
 
 
 @pytest.mark.parametrize("index", [-5, 4])
@@ -257,6 +257,57 @@ def test_list_to_py_1() -> None:
     assert a[4] == "anything" and type(a[4]) is str
 
 
+def test_list_to_py_depth() -> None:
+    inner = List([1, 2])
+    a = List([inner, "x"])
+    b = a.to_py(depth=1)
+    assert type(b) is list and b[0].is_(inner)
+    c = a.to_py(depth=2)
+    assert c == [[1, 2], "x"] and type(c[0]) is list
+    assert a.to_py() == a.py()
+
+
+def test_list_to_py_typed_list() -> None:
+    a = List([TypedList(int, [1, 2]), [TypedList(float, [0.5])]])
+    b = a.py()
+    assert b == [[1, 2], [[0.5]]]
+    assert type(b[0]) is list and type(b[1][0]) is list
+    c = a.to_py(depth=1)
+    assert isinstance(c[0], TypedList)
+
+
+def test_list_from_buffer() -> None:
+    import array
+
+    import numpy as np
+
+    assert List.from_buffer(array.array("i", [1, -2, 3])).py() == [1, -2, 3]
+    assert List.from_buffer(np.array([0.5, 1.5])).py() == [0.5, 1.5]
+    assert List.from_buffer(np.array([True, False])).py() == [True, False]
+    assert List.from_buffer(np.arange(6, dtype=np.uint8).reshape(2, 3)).py() == list(range(6))
+    assert List.from_buffer([1, "a", None]).py() == [1, "a", None]
+    # Strided views and unsupported formats fall back to iterating over the elements
+    assert List.from_buffer(np.arange(10)[::2]).py() == [0, 2, 4, 6, 8]
+    assert List.from_buffer(np.array([0.5, 1.5], dtype=np.float16)).py() == [0.5, 1.5]
+    assert List.from_buffer(np.array([1, "a"], dtype=object)).py() == [1, "a"]
+    assert List.from_buffer(np.array([2**63 - 1], dtype=np.uint64)).py() == [2**63 - 1]
+    with pytest.raises(OverflowError):
+        List.from_buffer(np.array([2**63], dtype=np.uint64))
+    with pytest.raises(TypeError):
+        List.from_buffer(np.array([1 + 2j]))
+
+
+def test_list_extend_many() -> None:
+    import numpy as np
+
+    a = List([0])
+    a.extend_many(np.arange(1, 100_000, dtype=np.int64))
+    a.extend_many(x for x in ["a", "b"])
+    assert len(a) == 100_001
+    assert a[99_999] == 99_999
+    assert list(a)[-2:] == ["a", "b"]
+
+
 @pytest.mark.parametrize(
     "callable",
     [
@@ -265,6 +316,7 @@ def test_list_to_py_1() -> None:
         lambda a: a.pop(0),
         lambda a: a.clear(),
         lambda a: a.extend([4, 5, 6]),
+        lambda a: a.extend_many([4, 5, 6]),
         lambda a: a.__setitem__(0, 0),
         lambda a: a.__delitem__(0),
     ],
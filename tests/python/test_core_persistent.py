@@ -0,0 +1,53 @@
+import mlc
+import pytest
+from mlc import PersistentDict, PersistentList
+
+
+def test_persistent_list_updates_return_new_lists() -> None:
+    a = PersistentList([1, 2, 3])
+    b = a.set(1, 20)
+    c = a.insert(0, 0)
+    d = a.erase(-1)
+    e = a.append(4)
+    assert list(a) == [1, 2, 3]
+    assert list(b) == [1, 20, 3]
+    assert list(c) == [0, 1, 2, 3]
+    assert list(d) == [1, 2]
+    assert list(e) == [1, 2, 3, 4]
+    assert str(e) == "[1, 2, 3, 4]"
+    with pytest.raises(IndexError):
+        a.set(3, 0)
+
+
+def test_persistent_list_many_elements() -> None:
+    a = PersistentList(range(1000))
+    b = a
+    for i in range(0, 1000, 10):
+        b = b.set(i, -i)
+    assert list(a) == list(range(1000))
+    assert list(b) == [-i if i % 10 == 0 else i for i in range(1000)]
+
+
+def test_persistent_dict_updates_return_new_dicts() -> None:
+    a = PersistentDict({"a": 1, "b": 2})
+    b = a.set("c", 3)
+    c = b.erase("a")
+    assert a == {"a": 1, "b": 2}
+    assert b == {"a": 1, "b": 2, "c": 3}
+    assert c == {"b": 2, "c": 3}
+    assert "a" in a and "a" not in c
+    with pytest.raises(KeyError):
+        c["a"]
+    assert sorted(b.keys()) == ["a", "b", "c"]
+    assert sorted(b.values()) == [1, 2, 3]
+
+
+def test_persistent_structural_and_json() -> None:
+    a = PersistentDict({"x": PersistentList([1, 2]), "y": 3})
+    b = PersistentDict({"y": 3}).set("x", PersistentList([1, 2]))
+    assert mlc.eq_s(a, b)
+    assert mlc.hash_s(a) == mlc.hash_s(b)
+    c = mlc.json_loads(mlc.json_dumps(a))
+    assert isinstance(c, PersistentDict)
+    assert list(c["x"]) == [1, 2]
+    assert c["y"] == 3
@@ -0,0 +1,53 @@
+import mlc
+from mlc import StructuralHashCache
+
+
+def _frozen(*elems: object) -> mlc.List:
+    ret = mlc.List(elems)
+    ret.freeze()
+    return ret
+
+
+def test_cached_hash_matches_uncached() -> None:
+    leaf = _frozen(1, 2.0, "three")
+    root = _frozen(leaf, leaf, _frozen(leaf, None))
+    cache = StructuralHashCache()
+    assert cache.hash(root) == mlc.hash_s(root)
+    assert cache.hash(root) == mlc.hash_s(root)
+    assert cache.num_hits == 1
+    assert len(cache) == 3
+
+
+def test_shared_subtrees_are_reused() -> None:
+    leaf = _frozen(1, 2, 3)
+    a = _frozen(leaf, 4)
+    b = _frozen(leaf, 5)
+    cache = StructuralHashCache()
+    cache.hash(a)
+    assert (cache.num_hits, cache.num_misses) == (0, 2)
+    assert cache.hash(b) == mlc.hash_s(b)
+    assert (cache.num_hits, cache.num_misses) == (1, 3)
+
+
+def test_mutable_objects_are_not_cached() -> None:
+    leaf = _frozen(1, 2, 3)
+    root = mlc.List([leaf])
+    cache = StructuralHashCache()
+    assert cache.hash(root) == mlc.hash_s(root)
+    assert len(cache) == 1
+    trusting = StructuralHashCache(assume_immutable=True)
+    assert trusting.hash(root) == mlc.hash_s(root)
+    assert len(trusting) == 2
+
+
+def test_invalidate_and_clear() -> None:
+    leaf = _frozen(1, 2, 3)
+    root = _frozen(leaf)
+    cache = StructuralHashCache()
+    cache.hash(root)
+    assert len(cache) == 2
+    cache.invalidate(root)
+    assert len(cache) == 1
+    cache.clear()
+    assert len(cache) == 0
+    assert cache.num_hits == 0
@@ -0,0 +1,42 @@
+import mlc
+from mlc import StructuralInternTable
+from mlc import sym as S
+
+
+def test_intern_lists() -> None:
+    table = StructuralInternTable()
+    a = mlc.List([1, "x", 2.5])
+    b = mlc.List([1, "x", 2.5])
+    c = mlc.List([1, "y", 2.5])
+    assert table.intern(a).is_(a)
+    assert table.intern(b).is_(a)
+    assert table.intern(c).is_(c)
+    assert (table.num_lookups, table.num_merged) == (3, 1)
+    assert table.bytes_saved > 0
+    assert len(table) == 2
+    table.clear()
+    assert len(table) == 0
+
+
+def test_intern_graph() -> None:
+    x = S.Var("x", "int64")
+    y = S.Var("y", "int64")
+    module = mlc.List([(x + 1) * y, (x + 1) * y, x + 1, mlc.List(["name", 2]), mlc.List(["name", 2])])
+    expected = mlc.List([(x + 1) * y, (x + 1) * y, x + 1, mlc.List(["name", 2]), mlc.List(["name", 2])])
+    table = StructuralInternTable()
+    assert table.intern_graph(module).is_(module)
+    assert module[0].is_(module[1])
+    assert module[3].is_(module[4])
+    assert module[0].a.is_(module[2])
+    assert mlc.eq_s(module, expected)
+
+
+def test_variables_not_merged() -> None:
+    x1 = S.Var("x", "int64")
+    x2 = S.Var("x", "int64")
+    exprs = mlc.List([x1 + 1, x2 + 1])
+    StructuralInternTable().intern_graph(exprs)
+    assert not exprs[0].is_(exprs[1])
+    assert exprs[0].a.is_(x1)
+    assert exprs[1].a.is_(x2)
+    assert exprs[0].b.is_(exprs[1].b)
@@ -1,3 +1,5 @@
+from pathlib import Path
+
 import mlc
 import numpy as np
 import pytest
@@ -128,3 +130,13 @@ def test_tensor_serialize() -> None:
     assert isinstance(b[1], mlc.Tensor)
     assert mlc.eq_ptr(b[0], b[1])
     assert np.array_equal(a.numpy(), b[0].numpy())
+
+
+@pytest.mark.parametrize("lazy", [False, True])
+def test_tensor_binary_load(tmp_path: Path, lazy: bool) -> None:
+    a = np.arange(100000, dtype=np.float32).reshape(100, 1000)
+    mlc.binary_dump(mlc.List([mlc.Tensor(a), "name"]), tmp_path / "tensor.bin")
+    b = mlc.binary_load(tmp_path / "tensor.bin", lazy=lazy)[0]
+    assert b.shape == (100, 1000)
+    assert b.dtype == mlc.DataType("float32")
+    assert np.array_equal(a, b.numpy())
@@ -0,0 +1,73 @@
+import mlc
+import numpy as np
+import pytest
+from mlc import DataType, List, TypedList
+
+
+def test_typed_list_init() -> None:
+    a = TypedList(int, [1, 2, 3])
+    assert isinstance(a, List)
+    assert a.elem_type is int
+    assert len(a) == 3
+    assert list(a) == [1, 2, 3]
+    assert str(a) == "[1, 2, 3]"
+
+
+def test_typed_list_mutation() -> None:
+    a = TypedList(float, [1.0, 3.0])
+    a.insert(1, 2.0)
+    a.append(4.0)
+    a.extend([5.0, 6.0])
+    assert a.pop() == 6.0
+    a[0] = 0.5
+    assert list(a) == [0.5, 2.0, 3.0, 4.0, 5.0]
+    a.clear()
+    assert len(a) == 0
+
+
+def test_typed_list_rejects_mismatched_elements() -> None:
+    a = TypedList(int, [1, 2])
+    with pytest.raises(TypeError):
+        a.append("three")
+    assert list(a) == [1, 2]
+    with pytest.raises(TypeError):
+        TypedList(str)
+
+
+def test_typed_list_dtype() -> None:
+    a = TypedList(DataType, [DataType("float32"), DataType("int8")])
+    assert a.py() == [DataType("float32"), DataType("int8")]
+    assert str(a) == "[float32, int8]"
+
+
+def test_typed_list_to_list() -> None:
+    a = TypedList(bool, [True, False])
+    b = a.to_list()
+    assert type(b) is List
+    assert list(b) == [True, False]
+
+
+@pytest.mark.parametrize(
+    "elem_type, values, np_dtype",
+    [
+        (bool, [True, False, True], np.bool_),
+        (int, [1, -2, 3], np.int64),
+        (float, [0.5, 1.5, -2.5], np.float64),
+    ],
+)
+def test_typed_list_numpy_zero_copy(elem_type: type, values: list, np_dtype: type) -> None:
+    a = TypedList(elem_type, values)
+    b = a.numpy()
+    assert b.dtype == np_dtype
+    assert b.tolist() == values
+    assert b.ctypes.data == a.data.value
+
+
+def test_typed_list_structural_and_json() -> None:
+    a = TypedList(int, [1, 2, 3])
+    b = TypedList(int, [1, 2, 3])
+    assert mlc.eq_s(a, b)
+    assert mlc.hash_s(a) == mlc.hash_s(b)
+    c = mlc.json_loads(mlc.json_dumps(a))
+    assert isinstance(c, TypedList)
+    assert list(c) == [1, 2, 3]
@@ -1,5 +1,7 @@
+import io
 import json
 import pickle
+from pathlib import Path
 from typing import Any, Optional
 
 import mlc
@@ -113,3 +115,65 @@ def test_json_dag() -> None:
     assert big_lst[1] == dct
     lst, dct = big_lst[:2]  # type: ignore[assignment]
     assert dct["v"].is_(lst)  # type: ignore[attr-defined]
+
+
+def test_json_nested_dtype_device() -> None:
+    obj_1 = AnyContainer([mlc.DataType("float32"), mlc.Device("cuda:1")])
+    obj_json = mlc.json_dumps(obj_1)
+    json.loads(obj_json)
+    obj_2: AnyContainer = mlc.json_loads(obj_json)
+    assert obj_2.field[0] == mlc.DataType("float32")
+    assert obj_2.field[1] == mlc.Device("cuda:1")
+
+
+def test_binary() -> None:
+    obj = ObjTest(a=1, b=2.0, c="3", d=True)
+    obj_binary = mlc.binary_dumps(obj)
+    assert isinstance(obj_binary, bytes)
+    obj_from_binary: ObjTest = mlc.binary_loads(obj_binary)
+    assert obj.a == obj_from_binary.a
+    assert obj.b == obj_from_binary.b
+    assert obj.c == obj_from_binary.c
+    assert obj.d == obj_from_binary.d
+    obj_opt: ObjTestOpt = mlc.binary_loads(mlc.binary_dumps(ObjTestOpt(None, 2.0, None, False)))
+    assert obj_opt.a is None and obj_opt.b == 2.0 and obj_opt.c is None and obj_opt.d is False
+
+
+def test_binary_dag() -> None:
+    lst = mlc.List([1, 2.0, "3\x00", True])
+    dct = mlc.Dict({"a": 1, "b": 2.0, "c": "3", "d": True, "v": lst})
+    big_lst = mlc.List([lst, dct, lst, dct])
+    obj_1 = AnyContainer([big_lst, big_lst])
+    obj_binary = mlc.binary_dumps(obj_1)
+    assert len(obj_binary) < len(mlc.json_dumps(obj_1))
+    obj_2: AnyContainer = mlc.binary_loads(obj_binary)
+    assert obj_2.field[0].is_(obj_2.field[1])
+    assert obj_2.field[0] == big_lst
+    big_lst = obj_2.field[0]
+    assert big_lst[0].is_(big_lst[2])  # type: ignore[attr-defined]
+    assert big_lst[1].is_(big_lst[3])  # type: ignore[attr-defined]
+    lst, dct = big_lst[:2]  # type: ignore[assignment]
+    assert dct["v"].is_(lst)  # type: ignore[attr-defined]
+    assert lst[2] == "3\x00"
+
+
+def test_dump_streaming(tmp_path: Path) -> None:
+    lst = mlc.List([mlc.List([i, f"item_{i}", 0.5 * i]) for i in range(10000)])
+    obj = AnyContainer([lst, lst])
+    json_str = mlc.json_dumps(obj)
+    binary = mlc.binary_dumps(obj)
+    # File objects receive the output in chunks
+    text_file = io.StringIO()
+    mlc.json_dump(obj, text_file)
+    assert text_file.getvalue() == json_str
+    binary_file = io.BytesIO()
+    mlc.binary_dump(obj, binary_file)
+    assert binary_file.getvalue() == binary
+    # Paths and file descriptors are written to directly
+    mlc.json_dump(obj, tmp_path / "obj.json")
+    assert (tmp_path / "obj.json").read_text() == json_str
+    with open(tmp_path / "obj.bin", "wb") as f:
+        mlc.binary_dump(obj, f.fileno())
+    obj_2: AnyContainer = mlc.binary_loads((tmp_path / "obj.bin").read_bytes())
+    assert obj_2.field[0].is_(obj_2.field[1])
+    assert obj_2.field[0] == lst
@@ -349,3 +349,26 @@ def test_global_var() -> None:
     rhs = x + z + y
     mlc.eq_s(lhs, rhs, bind_free_vars=True, assert_mode=True)
     assert mlc.hash_s(lhs) == mlc.hash_s(rhs)
+
+
+@pytest.mark.parametrize("num_threads", [2, 0])
+def test_parallel(num_threads: int) -> None:
+    def make_module(changed: int = -1) -> list[Func]:
+        g = Var("g", is_global=True)
+        funcs = []
+        for i in range(64):
+            x = Var("x")
+            body = Let(rhs=x + Constant(-1 if i == changed else i), lhs=(y := Var("y")), body=y + g)
+            funcs.append(Func(name=f"f{i}", args=[x], body=body))
+        return funcs
+
+    lhs = mlc.List(make_module())
+    rhs = mlc.List(make_module())
+    assert mlc.hash_s(lhs, num_threads=num_threads) == mlc.hash_s(lhs)
+    assert mlc.eq_s(lhs, rhs, num_threads=num_threads)
+    for changed in [0, 63]:
+        rhs = mlc.List(make_module(changed))
+        assert not mlc.eq_s(lhs, rhs, num_threads=num_threads)
+        with pytest.raises(ValueError) as e:
+            mlc.eq_s(lhs, rhs, assert_mode=True, num_threads=num_threads)
+        assert str(e.value) == mlc.eq_s_fail_reason(lhs, rhs)